@@ -25,6 +25,7 @@
 
 #include "yb/util/cast.h"
 #include "yb/util/debug-util.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 
 // TODO: do we need word Redis in following two metrics? ReadRpc and WriteRpc objects emitting
@@ -45,6 +46,12 @@ METRIC_DEFINE_histogram(
     server, handler_latency_yb_client_time_to_send,
     "Time taken for a Write/Read rpc to be sent to the server", yb::MetricUnit::kMicroseconds,
     "Microseconds spent before sending the request to the server", 60000000LU, 2);
+METRIC_DEFINE_counter(
+    server, yb_client_hedged_reads, "Hedged reads", yb::MetricUnit::kRequests,
+    "Number of consistent prefix reads that were also sent to a second replica");
+METRIC_DEFINE_counter(
+    server, yb_client_hedged_read_wins, "Hedged read wins", yb::MetricUnit::kRequests,
+    "Number of hedged reads where the second replica replied first");
 DECLARE_bool(rpc_dump_all_traces);
 DECLARE_bool(collect_end_to_end_traces);
 
@@ -58,9 +65,28 @@ DEFINE_bool(detect_duplicates_for_retryable_requests, true,
             "Enable tracking of write requests that prevents the same write from being applied "
                 "twice.");
 
+DEFINE_double(client_hedged_read_fraction, 0.0,
+              "Max fraction of recent consistent prefix reads that could be hedged, i.e. also "
+              "sent to another replica when the first one does not reply in time. 0 disables "
+              "hedging.");
+TAG_FLAG(client_hedged_read_fraction, advanced);
+TAG_FLAG(client_hedged_read_fraction, runtime);
+
+DEFINE_double(client_hedged_read_delay_percentile, 95.0,
+              "Consistent prefix read is hedged when it did not complete in this percentile of "
+              "read latencies observed during the last few seconds.");
+TAG_FLAG(client_hedged_read_delay_percentile, advanced);
+TAG_FLAG(client_hedged_read_delay_percentile, runtime);
+
+DEFINE_int32(client_hedged_read_min_delay_ms, 2,
+             "Min delay before consistent prefix read is hedged.");
+TAG_FLAG(client_hedged_read_min_delay_ms, advanced);
+TAG_FLAG(client_hedged_read_min_delay_ms, runtime);
+
 DEFINE_CAPABILITY(PickReadTimeAtTabletServer, 0x8284d67b);
 
 using namespace std::placeholders;
+using namespace std::literals;
 
 namespace yb {
 
@@ -97,7 +123,9 @@ AsyncRpcMetrics::AsyncRpcMetrics(const scoped_refptr<yb::MetricEntity>& entity)
       remote_read_rpc_time(METRIC_handler_latency_yb_client_read_remote.Instantiate(entity)),
       local_write_rpc_time(METRIC_handler_latency_yb_client_write_local.Instantiate(entity)),
       local_read_rpc_time(METRIC_handler_latency_yb_client_read_local.Instantiate(entity)),
-      time_to_send(METRIC_handler_latency_yb_client_time_to_send.Instantiate(entity)) {
+      time_to_send(METRIC_handler_latency_yb_client_time_to_send.Instantiate(entity)),
+      hedged_reads(METRIC_yb_client_hedged_reads.Instantiate(entity)),
+      hedged_read_wins(METRIC_yb_client_hedged_read_wins.Instantiate(entity)) {
 }
 
 AsyncRpc::AsyncRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
@@ -166,6 +194,12 @@ void AsyncRpc::Finished(const Status& status) {
   }
 }
 
+void AsyncRpc::FailWithoutSending(const Status& status) {
+  ProcessResponseFromTserver(status);
+  batcher_->RemoveInFlightOpsAfterFlushing(ops_, status, MakeFlushExtraResult());
+  batcher_->CheckForFinishedFlush();
+}
+
 void AsyncRpc::Failed(const Status& status) {
   std::string error_message = status.message().ToBuffer();
   auto redis_error_code = status.IsInvalidCommand() || status.IsInvalidArgument() ?
@@ -572,8 +606,88 @@ void WriteRpc::ProcessResponseFromTserver(const Status& status) {
   SwapRequestsAndResponses(false);
 }
 
+namespace {
+
+// Hedging delay is not estimated until this number of reads was observed in the current window.
+const uint64_t kMinHedgingSamples = 100;
+
+// Latency window is rotated after this time, provided it has at least kMinHedgingSamples.
+const auto kHedgingLatencyWindow = 10s;
+
+// Max number of hedges that could be started in a row.
+const double kMaxHedgeBudget = 10;
+
+std::unique_ptr<HdrHistogram> NewHedgingLatencies() {
+  return std::make_unique<HdrHistogram>(60000000LU, 2);
+}
+
+} // namespace
+
+ReadHedging::ReadHedging()
+    : latencies_(NewHedgingLatencies()), window_start_(CoarseMonoClock::Now()) {
+}
+
+MonoDelta ReadHedging::Delay() const {
+  auto delay_us = delay_us_.load(std::memory_order_acquire);
+  if (FLAGS_client_hedged_read_fraction <= 0 || delay_us < 0) {
+    return MonoDelta();
+  }
+  return std::max(
+      MonoDelta::FromMicroseconds(delay_us),
+      MonoDelta::FromMilliseconds(FLAGS_client_hedged_read_min_delay_ms));
+}
+
+void ReadHedging::ReadStarted() {
+  std::lock_guard<simple_spinlock> lock(budget_lock_);
+  budget_ = std::min(budget_ + FLAGS_client_hedged_read_fraction, kMaxHedgeBudget);
+}
+
+bool ReadHedging::TryStartHedge() {
+  {
+    std::lock_guard<simple_spinlock> lock(budget_lock_);
+    if (budget_ < 1) {
+      return false;
+    }
+    budget_ -= 1;
+  }
+  hedges_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void ReadHedging::RecordLatency(MonoDelta latency) {
+  auto now = CoarseMonoClock::Now();
+  std::unique_ptr<HdrHistogram> finished;
+  {
+    std::lock_guard<simple_spinlock> lock(latencies_lock_);
+    latencies_->Increment(latency.ToMicroseconds());
+    if (latencies_->TotalCount() < kMinHedgingSamples ||
+        (delay_us_.load(std::memory_order_relaxed) >= 0 &&
+         now - window_start_ < kHedgingLatencyWindow)) {
+      return;
+    }
+    finished = std::move(latencies_);
+    latencies_ = NewHedgingLatencies();
+    window_start_ = now;
+  }
+  // Percentile is calculated outside of the lock, the finished window is not updated anymore.
+  delay_us_.store(
+      finished->ValueAtPercentile(FLAGS_client_hedged_read_delay_percentile),
+      std::memory_order_release);
+}
+
+// Call sent by a hedged attempt. Each call has its own response and controller, so the other call
+// of the same attempt could be still in flight when the winner is processed.
+struct ReadRpc::HedgedCall {
+  tserver::ReadResponsePB resp;
+  rpc::RpcController controller;
+  int64_t attempt;
+  bool primary;
+  MonoTime start;
+};
+
 ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
-    : AsyncRpcBase(data, yb_consistency_level) {
+    : AsyncRpcBase(data, yb_consistency_level),
+      read_hedging_(data->batcher->client_->data_->read_hedging_) {
   TRACE_TO(trace_, "ReadRpc initiated to $0", data->tablet->tablet_id());
   req_.set_consistency_level(yb_consistency_level);
   req_.set_proxy_uuid(data->batcher->proxy_uuid());
@@ -642,6 +756,12 @@ ReadRpc::~ReadRpc() {
 }
 
 void ReadRpc::CallRemoteMethod() {
+  if (ShouldHedge()) {
+    read_hedging_->ReadStarted();
+    CallRemoteMethodHedged(read_hedging_->Delay());
+    return;
+  }
+
   auto trace = trace_; // It is possible that we receive reply before returning from ReadAsync.
                        // Detailed explanation in WriteRpc::SendRpcToTserver.
   TRACE_TO(trace, "SendRpcToTserver");
@@ -652,6 +772,109 @@ void ReadRpc::CallRemoteMethod() {
   TRACE_TO(trace, "RpcDispatched Asynchronously");
 }
 
+bool ReadRpc::ShouldHedge() const {
+  // Only the first attempt is hedged, retries go to the leader.
+  // Local calls are never hedged: they are fast and keep a pointer to the request while in flight.
+  return FLAGS_client_hedged_read_fraction > 0 &&
+         req_.consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX &&
+         num_attempts() == 1 && !tablet_invoker_.local_tserver_only() && !IsLocalCall();
+}
+
+void ReadRpc::CallRemoteMethodHedged(MonoDelta hedge_delay) {
+  auto call = std::make_shared<HedgedCall>();
+  call->primary = true;
+  {
+    std::lock_guard<std::mutex> lock(hedge_mutex_);
+    call->attempt = ++hedge_attempt_;
+    hedge_attempt_done_ = false;
+    hedge_call_timeout_ = PrepareController()->timeout();
+  }
+
+  TRACE_TO(trace_, "SendRpcToTserver hedged");
+  SendHedgedCall(tablet_invoker_.proxy().get(), req_, call);
+
+  if (hedge_delay) {
+    std::weak_ptr<rpc::RpcCommand> weak_self = shared_from_this();
+    auto attempt = call->attempt;
+    retrier().messenger()->scheduler().Schedule(
+        [weak_self, attempt](const Status& status) {
+          if (!status.ok()) {
+            return;
+          }
+          auto self = weak_self.lock();
+          if (self) {
+            down_cast<ReadRpc*>(self.get())->HedgeTimerFired(attempt);
+          }
+        },
+        hedge_delay.ToSteadyDuration());
+  }
+}
+
+void ReadRpc::SendHedgedCall(
+    tserver::TabletServerServiceProxy* proxy, const tserver::ReadRequestPB& req,
+    const HedgedCallPtr& call) {
+  call->start = MonoTime::Now();
+  call->controller.set_timeout(hedge_call_timeout_);
+  // Hedged calls are never local, so request is serialized before ReadAsync returns.
+  auto self = shared_from_this();
+  proxy->ReadAsync(
+      req, &call->resp, &call->controller,
+      [self, call] { down_cast<ReadRpc*>(self.get())->HedgedCallFinished(call); });
+}
+
+void ReadRpc::HedgeTimerFired(int64_t attempt) {
+  auto* ts = tablet_invoker_.SelectHedgeTabletServer();
+  if (!ts) {
+    return;
+  }
+  auto call = std::make_shared<HedgedCall>();
+  call->attempt = attempt;
+  call->primary = false;
+  tserver::ReadRequestPB req;
+  {
+    std::lock_guard<std::mutex> lock(hedge_mutex_);
+    if (attempt != hedge_attempt_ || hedge_attempt_done_ || !read_hedging_->TryStartHedge()) {
+      return;
+    }
+    // Operations are moved back from req_ once the attempt is done, so copy them while holding
+    // the lock.
+    req = req_;
+  }
+  VLOG(3) << ToString() << ": hedging read to " << ts->ToString();
+  TRACE_TO(trace_, "Hedged read to $0", ts->permanent_uuid());
+  if (async_rpc_metrics_) {
+    async_rpc_metrics_->hedged_reads->Increment();
+  }
+  SendHedgedCall(ts->proxy().get(), req, call);
+}
+
+void ReadRpc::HedgedCallFinished(const HedgedCallPtr& call) {
+  const bool failed = !call->controller.status().ok() || call->resp.has_error();
+  if (call->primary && !failed) {
+    read_hedging_->RecordLatency(MonoTime::Now().GetDeltaSince(call->start));
+  }
+  {
+    std::lock_guard<std::mutex> lock(hedge_mutex_);
+    // Failed hedge is ignored, the primary call decides how this attempt completes.
+    if (call->attempt != hedge_attempt_ || hedge_attempt_done_ || (!call->primary && failed)) {
+      return;
+    }
+    hedge_attempt_done_ = true;
+  }
+  if (!call->primary) {
+    TRACE_TO(trace_, "Hedged read won");
+    if (async_rpc_metrics_) {
+      async_rpc_metrics_->hedged_read_wins->Increment();
+    }
+    read_hedging_->HedgeWon();
+  }
+  // There is no way to cancel an outbound call, so the losing call just completes in background
+  // and its reply is ignored.
+  resp_.Swap(&call->resp);
+  mutable_retrier()->mutable_controller()->Swap(&call->controller);
+  Finished(Status::OK());
+}
+
 void ReadRpc::Finished(const Status& status) {
   // It is possible that call succeeded, but failed to send response.
   // So in case of retry to should tell server that it could have metadata.
@@ -14,6 +14,9 @@
 #ifndef YB_CLIENT_ASYNC_RPC_H_
 #define YB_CLIENT_ASYNC_RPC_H_
 
+#include <atomic>
+#include <mutex>
+
 #include "yb/client/tablet_rpc.h"
 
 #include "yb/common/read_hybrid_time.h"
@@ -22,6 +25,9 @@
 
 #include "yb/tserver/tserver_service.proxy.h"
 
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/locks.h"
+
 namespace yb {
 namespace client {
 
@@ -44,6 +50,8 @@ struct AsyncRpcMetrics {
   scoped_refptr<Histogram> local_write_rpc_time;
   scoped_refptr<Histogram> local_read_rpc_time;
   scoped_refptr<Histogram> time_to_send;
+  scoped_refptr<Counter> hedged_reads;
+  scoped_refptr<Counter> hedged_read_wins;
 };
 
 struct AsyncRpcData {
@@ -83,6 +91,10 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
   const YBTable* table() const;
   const RemoteTablet& tablet() const { return *tablet_invoker_.tablet(); }
   const InFlightOps& ops() const { return ops_; }
+  const Batcher* batcher() const { return batcher_.get(); }
+
+  // Completes RPC that was not sent, failing all its operations with specified status.
+  void FailWithoutSending(const Status& status);
 
  protected:
   void Finished(const Status& status) override;
@@ -162,6 +174,55 @@ class WriteRpc : public AsyncRpcBase<tserver::WriteRequestPB, tserver::WriteResp
   void ProcessResponseFromTserver(const Status& status) override;
 };
 
+// Decides whether consistent prefix reads should be hedged, i.e. sent to a second replica when the
+// first one does not reply in time. Single instance is shared by all reads of the client.
+class ReadHedging {
+ public:
+  ReadHedging();
+
+  // Returns delay after which read should be hedged, or uninitialized MonoDelta when hedging is
+  // disabled or there are not enough latency samples yet.
+  MonoDelta Delay() const;
+
+  // Adds FLAGS_client_hedged_read_fraction of a hedge to the budget.
+  void ReadStarted();
+
+  // Takes one hedge from the budget, returns false when the budget is exhausted.
+  bool TryStartHedge();
+
+  void RecordLatency(MonoDelta latency);
+
+  void HedgeWon() {
+    hedge_wins_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint64_t hedges() const {
+    return hedges_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t hedge_wins() const {
+    return hedge_wins_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  simple_spinlock budget_lock_;
+  // Number of hedges that could be started now. Each read refills it by the hedged fraction, so
+  // hedges follow the recent read rate. It is capped, so budget saved up while the cluster was
+  // fast cannot be spent all at once when it slows down.
+  double budget_ GUARDED_BY(budget_lock_) = 0;
+
+  simple_spinlock latencies_lock_;
+  // Latencies of the current window. The delay is estimated when the window is rotated, so it
+  // follows recent latencies instead of the whole client lifetime.
+  std::unique_ptr<HdrHistogram> latencies_ GUARDED_BY(latencies_lock_);
+  CoarseTimePoint window_start_ GUARDED_BY(latencies_lock_);
+  // Negative while delay was not estimated yet.
+  std::atomic<int64_t> delay_us_{-1};
+
+  std::atomic<uint64_t> hedges_{0};
+  std::atomic<uint64_t> hedge_wins_{0};
+};
+
 class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadResponsePB> {
  public:
   explicit ReadRpc(
@@ -170,10 +231,31 @@ class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadRespons
   virtual ~ReadRpc();
 
  private:
+  struct HedgedCall;
+  typedef std::shared_ptr<HedgedCall> HedgedCallPtr;
+
   void Finished(const Status& status) override;
   void SwapRequestsAndResponses(bool skip_responses);
   void CallRemoteMethod() override;
   void ProcessResponseFromTserver(const Status& status) override;
+
+  bool ShouldHedge() const;
+  void CallRemoteMethodHedged(MonoDelta hedge_delay);
+  void SendHedgedCall(
+      tserver::TabletServerServiceProxy* proxy, const tserver::ReadRequestPB& req,
+      const HedgedCallPtr& call);
+  void HedgeTimerFired(int64_t attempt);
+  void HedgedCallFinished(const HedgedCallPtr& call);
+
+  const ReadHedgingPtr read_hedging_;
+
+  std::mutex hedge_mutex_;
+  // Incremented for each attempt that is sent with hedging, so replies of previous attempts
+  // could be ignored.
+  int64_t hedge_attempt_ = 0;
+  // Whether the current hedged attempt has already received its winning reply.
+  bool hedge_attempt_done_ = false;
+  MonoDelta hedge_call_timeout_;
 };
 
 }  // namespace internal
@@ -33,6 +33,7 @@
 #include "yb/client/batcher.h"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -111,6 +112,69 @@ const std::string Batcher::kErrorReachingOutToTServersMsg(
 // locks are non-reentrant).
 // ------------------------------------------------------------
 
+void WriteRpcWindow::Send(const TabletId& tablet_id, std::shared_ptr<AsyncRpc> rpc) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& data = tablets_[tablet_id];
+    if (data.in_flight.size() >= max_in_flight_per_tablet_) {
+      VLOG(3) << "Queue write to " << tablet_id << ", in flight: " << data.in_flight.size();
+      data.queue.push_back(std::move(rpc));
+      return;
+    }
+    data.in_flight.insert(rpc.get());
+  }
+  rpc->SendRpc();
+}
+
+void WriteRpcWindow::Finished(const TabletId& tablet_id, const AsyncRpc* rpc) {
+  std::shared_ptr<AsyncRpc> next;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tablets_.find(tablet_id);
+    // RPC that was aborted while queued does not hold a slot.
+    if (it == tablets_.end() || it->second.in_flight.erase(rpc) == 0) {
+      return;
+    }
+    auto& data = it->second;
+    if (!data.queue.empty()) {
+      // Slot of the finished RPC is passed to the next one.
+      next = std::move(data.queue.front());
+      data.queue.pop_front();
+      data.in_flight.insert(next.get());
+    } else if (data.in_flight.empty()) {
+      tablets_.erase(it);
+    }
+  }
+  if (next) {
+    next->SendRpc();
+  }
+}
+
+void WriteRpcWindow::Abort(const Batcher* batcher, const Status& status) {
+  std::vector<std::shared_ptr<AsyncRpc>> aborted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = tablets_.begin(); it != tablets_.end();) {
+      auto& queue = it->second.queue;
+      auto stop = std::stable_partition(
+          queue.begin(), queue.end(), [batcher](const std::shared_ptr<AsyncRpc>& rpc) {
+        return batcher && rpc->batcher() != batcher;
+      });
+      std::move(stop, queue.end(), std::back_inserter(aborted));
+      queue.erase(stop, queue.end());
+      if (it->second.in_flight.empty() && queue.empty()) {
+        it = tablets_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (const auto& rpc : aborted) {
+    VLOG(3) << "Abort queued write: " << rpc->ToString();
+    rpc->FailWithoutSending(status);
+  }
+}
+
 Batcher::Batcher(YBClient* client,
                  ErrorCollector* error_collector,
                  const YBSessionPtr& session,
@@ -151,6 +215,10 @@ void Batcher::Abort(const Status& status) {
     run_callback = flush_callback_;
   }
 
+  if (write_rpc_window_) {
+    write_rpc_window_->Abort(this, status);
+  }
+
   if (run_callback) {
     RunCallback(status);
   }
@@ -493,7 +561,8 @@ void Batcher::FlushBuffersIfReady() {
                               force_consistent_read_,
                               std::bind(&Batcher::TransactionReady, this, _1, BatcherPtr(this)),
                               &transaction_metadata_,
-                              &may_have_metadata_)) {
+                              &may_have_metadata_,
+                              this)) {
       return;
     }
 
@@ -628,6 +697,10 @@ void Batcher::FlushBuffer(
   if (!rpc) {
     FATAL_INVALID_ENUM_VALUE(OpGroup, op_group);
   }
+  if (op_group == OpGroup::kWrite && write_rpc_window_) {
+    write_rpc_window_->Send(tablet->tablet_id(), std::move(rpc));
+    return;
+  }
   rpc->SendRpc();
 }
 
@@ -703,6 +776,10 @@ void Batcher::ProcessWriteResponse(const WriteRpc &rpc, const Status &s) {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
     CombineErrorUnlocked(rpc.ops()[err_pb.row_index()], StatusFromPB(err_pb.error()));
   }
+
+  if (write_rpc_window_) {
+    write_rpc_window_->Finished(rpc.tablet().tablet_id(), &rpc);
+  }
 }
 
 }  // namespace internal
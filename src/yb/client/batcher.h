@@ -32,6 +32,8 @@
 #ifndef YB_CLIENT_BATCHER_H_
 #define YB_CLIENT_BATCHER_H_
 
+#include <deque>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -89,6 +91,36 @@ YB_DEFINE_ENUM(
     (kComplete)           // Batcher complete.
     (kAborted));          // Batcher was aborted.
 
+// Limits number of write RPCs that are concurrently in flight to the same tablet, for all batchers
+// of a session. RPCs exceeding the limit are queued and sent when an RPC to the same tablet
+// completes, so a slow tablet does not accumulate unbounded number of outstanding writes, while
+// writes to other tablets proceed independently.
+class WriteRpcWindow {
+ public:
+  explicit WriteRpcWindow(size_t max_in_flight_per_tablet)
+      : max_in_flight_per_tablet_(max_in_flight_per_tablet) {}
+
+  // Sends rpc, or queues it when there are too many RPCs in flight to its tablet.
+  void Send(const TabletId& tablet_id, std::shared_ptr<AsyncRpc> rpc);
+
+  // Should be invoked when write RPC to specified tablet completes.
+  void Finished(const TabletId& tablet_id, const AsyncRpc* rpc);
+
+  // Fails queued RPCs of specified batcher with status, without sending them.
+  // Null batcher means all queued RPCs.
+  void Abort(const Batcher* batcher, const Status& status);
+
+ private:
+  struct TabletData {
+    std::unordered_set<const AsyncRpc*> in_flight;
+    std::deque<std::shared_ptr<AsyncRpc>> queue;
+  };
+
+  const size_t max_in_flight_per_tablet_;
+  std::mutex mutex_;
+  std::unordered_map<TabletId, TabletData> tablets_;
+};
+
 // A Batcher is the class responsible for collecting row operations, routing them to the
 // correct tablet server, and possibly batching them together for better efficiency.
 //
@@ -192,6 +224,10 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
     memory_limit_score_ = score;
   }
 
+  void SetWriteRpcWindow(WriteRpcWindowPtr window) {
+    write_rpc_window_ = std::move(window);
+  }
+
   // This is a status error string used when there are multiple errors that need to be fetched
   // from the error collector.
   static const std::string kErrorReachingOutToTServersMsg;
@@ -322,6 +358,9 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
 
   double memory_limit_score_ = 0.0;
 
+  // Limits write RPCs in flight per tablet, when set.
+  WriteRpcWindowPtr write_rpc_window_;
+
   DISALLOW_COPY_AND_ASSIGN(Batcher);
 };
 
@@ -45,6 +45,7 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
 
+#include "yb/client/async_rpc.h"
 #include "yb/client/meta_cache.h"
 #include "yb/client/table.h"
 
@@ -287,7 +288,8 @@ YB_CLIENT_SPECIALIZE_SIMPLE(IsDeleteTableDone);
 YB_CLIENT_SPECIALIZE_SIMPLE(IsLoadBalanced);
 
 YBClient::Data::Data()
-    : leader_master_rpc_(rpcs_.InvalidHandle()),
+    : read_hedging_(std::make_shared<internal::ReadHedging>()),
+      leader_master_rpc_(rpcs_.InvalidHandle()),
       latest_observed_hybrid_time_(YBClient::kNoHybridTime),
       id_(ClientId::GenerateRandom()) {}
 
@@ -34,12 +34,14 @@
 #include <functional>
 #include <thread>
 #include <set>
+#include <shared_mutex>
 #include <vector>
 
 #include <gtest/gtest.h>
 #include <gflags/gflags.h>
 #include <glog/stl_logging.h>
 
+#include "yb/client/async_rpc.h"
 #include "yb/client/callbacks.h"
 #include "yb/client/client.h"
 #include "yb/client/client-internal.h"
@@ -92,7 +94,13 @@
 #include "yb/util/tostring.h"
 
 DECLARE_bool(enable_data_block_fsync);
+DECLARE_double(client_hedged_read_delay_percentile);
+DECLARE_double(client_hedged_read_fraction);
+DECLARE_int32(client_hedged_read_min_delay_ms);
+DECLARE_int32(inject_read_latency_ms);
+DECLARE_string(inject_read_latency_tserver_uuid);
 DECLARE_bool(log_inject_latency);
+DECLARE_bool(tablet_pause_apply_write_ops);
 DECLARE_double(leader_failure_max_missed_heartbeat_periods);
 DECLARE_int32(heartbeat_interval_ms);
 DECLARE_int32(log_inject_latency_ms_mean);
@@ -960,6 +968,122 @@ TEST_F(ClientTest, TestSessionClose) {
   ASSERT_OK(session->Close());
 }
 
+TEST_F(ClientTest, AutoFlush) {
+  constexpr int kNumRows = 100;
+  auto session = CreateSession();
+
+  // Operations should be flushed by timer, without explicit flush.
+  session->SetAutoFlush(50ms, 0);
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(ApplyInsertToSession(session.get(), client_table_, i, i, "row"));
+  }
+  ASSERT_OK(WaitFor([session] { return !session->HasPendingOperations(); },
+                    10s, "Flush by timer"));
+  ASSERT_EQ(kNumRows, CountRowsFromClient(client_table_));
+
+  // Operations should be flushed when batch size is reached, and Flush should wait for all of
+  // them.
+  session->SetAutoFlush(MonoDelta(), 256);
+  for (int i = kNumRows; i != 2 * kNumRows; ++i) {
+    ASSERT_OK(ApplyInsertToSession(session.get(), client_table_, i, i, "row"));
+  }
+  ASSERT_LT(session->CountBufferedOperations(), kNumRows);
+  ASSERT_OK(session->Flush());
+  ASSERT_FALSE(session->HasPendingOperations());
+  ASSERT_EQ(2 * kNumRows, CountRowsFromClient(client_table_));
+}
+
+TEST_F(ClientTest, MaxInFlightWritesPerTablet) {
+  constexpr int kNumRows = 200;
+  auto session = CreateSession();
+  session->SetAutoFlush(MonoDelta(), 128);
+  session->SetMaxInFlightWritesPerTablet(1);
+
+  // While writes are not applied, every write that reached a tablet stays pending there.
+  FLAGS_tablet_pause_apply_write_ops = true;
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(ApplyInsertToSession(session.get(), client_table_, i, i, "row"));
+  }
+  std::this_thread::sleep_for(1s);
+
+  int max_pending = 0;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    std::vector<tablet::TabletPeerPtr> peers;
+    cluster_->mini_tablet_server(i)->server()->tablet_manager()->GetTabletPeers(&peers);
+    for (const auto& peer : peers) {
+      if (peer->tablet_metadata()->table_id() == client_table_->id()) {
+        max_pending = std::max(max_pending, peer->operation_tracker()->GetNumPendingForTests());
+      }
+    }
+  }
+  FLAGS_tablet_pause_apply_write_ops = false;
+  ASSERT_EQ(max_pending, 1);
+
+  ASSERT_OK(session->Flush());
+  ASSERT_FALSE(session->HasPendingOperations());
+  ASSERT_EQ(kNumRows, CountRowsFromClient(client_table_));
+}
+
+TEST_F(ClientTest, HedgedReads) {
+  constexpr int kNumRows = 100;
+  constexpr int kNumReads = 300;
+
+  ASSERT_NO_FATALS(InsertTestRows(client_table_, kNumRows));
+  ASSERT_OK(WaitFor([this] {
+    return CountRowsFromClient(
+        client_table_, YBConsistencyLevel::CONSISTENT_PREFIX, kNoBound, kNoBound) == kNumRows;
+  }, 10s, "Replicate rows"));
+
+  // Hedge every read that is slower than the fastest one observed so far.
+  FLAGS_client_hedged_read_fraction = 1.0;
+  FLAGS_client_hedged_read_delay_percentile = 0;
+  FLAGS_client_hedged_read_min_delay_ms = 0;
+  for (int i = 0; i != kNumReads; ++i) {
+    ASSERT_EQ(kNumRows, CountRowsFromClient(
+        client_table_, YBConsistencyLevel::CONSISTENT_PREFIX, kNoBound, kNoBound));
+  }
+  LOG(INFO) << "Hedged reads: " << client_->data_->read_hedging_->hedges();
+  ASSERT_GT(client_->data_->read_hedging_->hedges(), 0U);
+}
+
+// Slow down reads on one replica at a time, so the read sent to it as the first one should be
+// completed by the hedge sent to another replica.
+TEST_F(ClientTest, HedgedReadsSlowReplica) {
+  constexpr int kNumRows = 100;
+  constexpr int kNumReadsPerServer = 200;
+
+  ASSERT_NO_FATALS(InsertTestRows(client_table_, kNumRows));
+  ASSERT_OK(WaitFor([this] {
+    return CountRowsFromClient(
+        client_table_, YBConsistencyLevel::CONSISTENT_PREFIX, kNoBound, kNoBound) == kNumRows;
+  }, 10s, "Replicate rows"));
+
+  FLAGS_client_hedged_read_fraction = 1.0;
+  FLAGS_client_hedged_read_delay_percentile = 0;
+  FLAGS_client_hedged_read_min_delay_ms = 0;
+  auto read = [this] {
+    for (int i = 0; i != kNumReadsPerServer; ++i) {
+      ASSERT_EQ(kNumRows, CountRowsFromClient(
+          client_table_, YBConsistencyLevel::CONSISTENT_PREFIX, kNoBound, kNoBound));
+    }
+  };
+  // Estimate hedging delay while all replicas are fast.
+  ASSERT_NO_FATALS(read());
+
+  FLAGS_inject_read_latency_ms = 50;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    FLAGS_inject_read_latency_tserver_uuid =
+        cluster_->mini_tablet_server(i)->server()->permanent_uuid();
+    ASSERT_NO_FATALS(read());
+  }
+  FLAGS_inject_read_latency_ms = 0;
+
+  const auto& read_hedging = *client_->data_->read_hedging_;
+  LOG(INFO) << "Hedged reads: " << read_hedging.hedges() << ", wins: "
+            << read_hedging.hedge_wins();
+  ASSERT_GT(read_hedging.hedge_wins(), 0U);
+}
+
 // Test which sends multiple batches through the same session, each of which
 // contains multiple rows spread across multiple tablets.
 TEST_F(ClientTest, TestMultipleMultiRowManualBatches) {
@@ -1664,6 +1788,86 @@ TEST_F(ClientTest, TestMasterLookupPermits) {
             client_->data_->meta_cache_->master_lookup_sem_.GetValue());
 }
 
+// Tests that locations fetched while opening a table are stored in the meta cache, so the first
+// operations on this table do not have to look up tablets.
+TEST_F(ClientTest, PrefetchTableLocations) {
+  auto client = ASSERT_RESULT(YBClientBuilder()
+      .add_master_server_addr(ToString(cluster_->mini_master()->bound_rpc_addr()))
+      .Build());
+  std::shared_ptr<YBTable> table;
+  ASSERT_OK(client->OpenTable(kTableName, &table));
+  ASSERT_EQ(kNumTablets, static_cast<int>(table->GetPartitions().size()));
+
+  auto& meta_cache = *client->data_->meta_cache_;
+  std::shared_lock<decltype(meta_cache.mutex_)> lock(meta_cache.mutex_);
+  for (const auto& partition_start : table->GetPartitions()) {
+    ASSERT_TRUE(meta_cache.LookupTabletByKeyFastPathUnlocked(table.get(), partition_start))
+        << "Partition not cached: " << Slice(partition_start).ToDebugHexString();
+  }
+}
+
+// Compares number of cached tablet lookups per second served by the lock free fast path with the
+// number served under the shared meta cache mutex, when several threads do lookups concurrently.
+TEST_F(ClientTest, LookupTabletByKeyPerf) {
+  const int kNumThreads = std::max(4U, std::thread::hardware_concurrency());
+  const auto kRunTime = AllowSlowTests() ? 10s : 2s;
+
+  const auto& table = client_table_.table();
+  const auto& partitions = table->GetPartitions();
+  auto& meta_cache = *client_->data_->meta_cache_;
+  for (const auto& partition_start : partitions) {
+    ASSERT_OK(meta_cache.LookupTabletByKeyFuture(
+        table.get(), partition_start, CoarseMonoClock::now() + 10s).get());
+  }
+
+  auto measure = [&](const std::function<bool(const std::string&)>& lookup) {
+    std::atomic<uint64_t> total_lookups{0};
+    std::atomic<uint64_t> total_failures{0};
+    TestThreadHolder thread_holder;
+    for (int i = 0; i != kNumThreads; ++i) {
+      thread_holder.AddThreadFunctor(
+          [&stop = thread_holder.stop_flag(), &partitions, &lookup, &total_lookups,
+           &total_failures] {
+        uint64_t lookups = 0;
+        uint64_t failures = 0;
+        while (!stop.load(std::memory_order_acquire)) {
+          for (const auto& partition_start : partitions) {
+            if (!lookup(partition_start)) {
+              ++failures;
+            }
+            ++lookups;
+          }
+        }
+        total_lookups += lookups;
+        total_failures += failures;
+      });
+    }
+    thread_holder.WaitAndStop(kRunTime);
+    EXPECT_EQ(0U, total_failures.load());
+    return total_lookups.load() /
+           std::chrono::duration_cast<std::chrono::duration<double>>(kRunTime).count();
+  };
+
+  auto fast_rate = measure([&meta_cache, &table](const std::string& partition_start) {
+    bool found = false;
+    meta_cache.LookupTabletByKey(
+        table.get(), partition_start, CoarseMonoClock::now() + 10s,
+        [&found](const Result<internal::RemoteTabletPtr>& tablet) {
+          found = tablet.ok();
+        });
+    return found;
+  });
+  auto locked_rate = measure([&meta_cache, &table](const std::string& partition_start) {
+    std::shared_lock<decltype(meta_cache.mutex_)> lock(meta_cache.mutex_);
+    auto tablet = meta_cache.LookupTabletByKeyFastPathUnlocked(table.get(), partition_start);
+    return tablet && tablet->HasLeader();
+  });
+
+  LOG(INFO) << "Threads: " << kNumThreads << ", lookups per second, fast path: " << fast_rate
+            << ", locked path: " << locked_rate;
+  ASSERT_GT(fast_rate, locked_rate);
+}
+
 // Define callback for deadlock simulation, as well as various helper methods.
 namespace {
 
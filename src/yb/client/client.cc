@@ -62,7 +62,9 @@
 #include "yb/yql/redis/redisserver/redis_constants.h"
 #include "yb/yql/redis/redisserver/redis_parser.h"
 #include "yb/rpc/messenger.h"
+#include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/yb_rpc.h"
+#include "yb/tserver/tserver_service.proxy.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/init.h"
 #include "yb/util/logging.h"
@@ -950,6 +952,52 @@ Status YBClient::GetTabletLocation(const TabletId& tablet_id,
   return Status::OK();
 }
 
+Status YBClient::ImportTabletData(const TabletId& tablet_id,
+                                  const std::map<std::string, std::string>& source_dirs,
+                                  std::set<std::string>* imported) {
+  TabletLocationsPB tablet_location;
+  RETURN_NOT_OK(GetTabletLocation(tablet_id, &tablet_location));
+
+  if (static_cast<size_t>(tablet_location.replicas_size()) != source_dirs.size()) {
+    return STATUS_FORMAT(
+        InvalidArgument, "Tablet $0 has $1 replicas, but data provided for $2 servers",
+        tablet_id, tablet_location.replicas_size(), source_dirs.size());
+  }
+  for (const auto& replica : tablet_location.replicas()) {
+    if (!source_dirs.count(replica.ts_info().permanent_uuid())) {
+      return STATUS_FORMAT(InvalidArgument, "No data provided for replica of $0 on $1",
+                           tablet_id, replica.ts_info().permanent_uuid());
+    }
+  }
+
+  for (const auto& replica : tablet_location.replicas()) {
+    const auto& ts_info = replica.ts_info();
+    if (imported->count(ts_info.permanent_uuid())) {
+      continue;
+    }
+    tserver::TabletServerServiceProxy proxy(
+        data_->proxy_cache_.get(),
+        HostPortFromPB(DesiredHostPort(
+            ts_info.broadcast_addresses(), ts_info.private_rpc_addresses(), ts_info.cloud_info(),
+            data_->cloud_info_pb_)));
+    tserver::ImportDataRequestPB req;
+    req.set_tablet_id(tablet_id);
+    req.set_source_dir(source_dirs.at(ts_info.permanent_uuid()));
+    tserver::ImportDataResponsePB resp;
+    rpc::RpcController controller;
+    controller.set_timeout(default_admin_operation_timeout());
+    LOG(INFO) << "Importing " << req.source_dir() << " into " << tablet_id << " on "
+              << ts_info.permanent_uuid();
+    RETURN_NOT_OK(proxy.ImportData(req, &resp, &controller));
+    if (resp.has_error()) {
+      return StatusFromPB(resp.error().status()).CloneAndPrepend(
+          Format("Import into $0 on $1 failed", tablet_id, ts_info.permanent_uuid()));
+    }
+    imported->insert(ts_info.permanent_uuid());
+  }
+  return Status::OK();
+}
+
 Status YBClient::GetTablets(const YBTableName& table_name,
                             const int32_t max_tablets,
                             vector<TabletId>* tablet_uuids,
@@ -1004,6 +1052,10 @@ const ClientId& YBClient::id() const {
   return data_->id_;
 }
 
+const CloudInfoPB& YBClient::cloud_info() const {
+  return data_->cloud_info_pb_;
+}
+
 std::pair<RetryableRequestId, RetryableRequestId> YBClient::NextRequestIdAndMinRunningRequestId(
     const TabletId& tablet_id) {
   std::lock_guard<simple_spinlock> lock(data_->tablet_requests_mutex_);
@@ -34,7 +34,9 @@
 
 #include <stdint.h>
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include <utility>
@@ -441,6 +443,19 @@ class YBClient {
   CHECKED_STATUS GetTabletLocation(const TabletId& tablet_id,
                                    master::TabletLocationsPB* tablet_location);
 
+  // Imports externally built DocDB data into every replica of the tablet. Data is not replicated
+  // through the WAL, so it should be transferred to each replica beforehand.
+  // 'source_dirs' maps permanent uuid of each replica's tablet server to the directory containing
+  // data on that server. Key ranges of imported files are validated against tablet partition.
+  //
+  // Replicas are imported one by one, so import is not atomic: on failure, replicas whose tablet
+  // server uuids were added to 'imported' already contain the data, and the others do not.
+  // Importing the same data twice fails, so the caller should retry with the same 'imported',
+  // then those replicas are skipped. Importing empty DocDB succeeds without changing the replica.
+  CHECKED_STATUS ImportTabletData(const TabletId& tablet_id,
+                                  const std::map<std::string, std::string>& source_dirs,
+                                  std::set<std::string>* imported);
+
   // Get the list of master uuids. Can be enhanced later to also return port/host info.
   CHECKED_STATUS ListMasters(
     CoarseTimePoint deadline,
@@ -541,6 +556,9 @@ class YBClient {
   // Id of this client instance.
   const ClientId& id() const;
 
+  // Placement of this client, as provided to the builder.
+  const CloudInfoPB& cloud_info() const;
+
   std::pair<RetryableRequestId, RetryableRequestId> NextRequestIdAndMinRunningRequestId(
       const TabletId& tablet_id);
   void RequestFinished(const TabletId& tablet_id, RetryableRequestId request_id);
@@ -562,9 +580,11 @@ class YBClient {
   friend class internal::RemoteTablet;
   friend class internal::RemoteTabletServer;
   friend class internal::AsyncRpc;
+  friend class internal::ReadRpc;
   friend class internal::TabletInvoker;
   friend class PlacementInfoTest;
 
+  FRIEND_TEST(ClientTest, HedgedReads);
   FRIEND_TEST(ClientTest, TestGetTabletServerBlacklist);
   FRIEND_TEST(ClientTest, TestMasterDown);
   FRIEND_TEST(ClientTest, TestMasterLookupPermits);
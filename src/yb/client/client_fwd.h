@@ -85,6 +85,7 @@ YB_STRONGLY_TYPED_BOOL(ForceConsistentRead);
 namespace internal {
 
 class AsyncRpc;
+class ReadRpc;
 class MetaCache;
 class TabletInvoker;
 
@@ -97,9 +98,15 @@ typedef scoped_refptr<RemoteTablet> RemoteTabletPtr;
 
 class RemoteTabletServer;
 
+class ReadHedging;
+typedef std::shared_ptr<ReadHedging> ReadHedgingPtr;
+
 class Batcher;
 typedef scoped_refptr<Batcher> BatcherPtr;
 
+class WriteRpcWindow;
+typedef std::shared_ptr<WriteRpcWindow> WriteRpcWindowPtr;
+
 struct AsyncRpcMetrics;
 typedef std::shared_ptr<AsyncRpcMetrics> AsyncRpcMetricsPtr;
 
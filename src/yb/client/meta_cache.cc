@@ -251,18 +251,18 @@ void RemoteTablet::Refresh(
     CHECK(it != tservers.end());
     replicas_.emplace_back(it->second.get(), r.role());
   }
-  stale_ = false;
+  UpdateHasLeaderUnlocked();
+  stale_.store(false, std::memory_order_release);
   refresh_time_.store(MonoTime::Now(), std::memory_order_release);
 }
 
 void RemoteTablet::MarkStale() {
   std::lock_guard<rw_spinlock> lock(mutex_);
-  stale_ = true;
+  stale_.store(true, std::memory_order_release);
 }
 
 bool RemoteTablet::stale() const {
-  std::shared_lock<rw_spinlock> lock(mutex_);
-  return stale_;
+  return stale_.load(std::memory_order_acquire);
 }
 
 bool RemoteTablet::MarkReplicaFailed(RemoteTabletServer *ts, const Status& status) {
@@ -273,6 +273,7 @@ bool RemoteTablet::MarkReplicaFailed(RemoteTabletServer *ts, const Status& statu
   for (RemoteReplica& rep : replicas_) {
     if (rep.ts == ts) {
       rep.MarkFailed();
+      UpdateHasLeaderUnlocked();
       return true;
     }
   }
@@ -301,7 +302,18 @@ RemoteTabletServer* RemoteTablet::LeaderTServer() const {
 }
 
 bool RemoteTablet::HasLeader() const {
-  return LeaderTServer() != nullptr;
+  return has_leader_.load(std::memory_order_acquire);
+}
+
+void RemoteTablet::UpdateHasLeaderUnlocked() {
+  bool has_leader = false;
+  for (const RemoteReplica& replica : replicas_) {
+    if (!replica.Failed() && replica.role == RaftPeerPB::LEADER) {
+      has_leader = true;
+      break;
+    }
+  }
+  has_leader_.store(has_leader, std::memory_order_release);
 }
 
 void RemoteTablet::GetRemoteTabletServers(vector<RemoteTabletServer*>* servers) {
@@ -382,6 +394,7 @@ void RemoteTablet::GetRemoteTabletServers(vector<RemoteTabletServer*>* servers)
         update.replica->ClearFailed();
       }
     }
+    UpdateHasLeaderUnlocked();
   }
 }
 
@@ -396,6 +409,7 @@ bool RemoteTablet::MarkTServerAsLeader(const RemoteTabletServer* server) {
       replica.role = RaftPeerPB::FOLLOWER;
     }
   }
+  UpdateHasLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   VLOG_IF_WITH_PREFIX(3, !found) << "Specified server not found: " << server->ToString()
                                  << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -411,6 +425,7 @@ void RemoteTablet::MarkTServerAsFollower(const RemoteTabletServer* server) {
       found = true;
     }
   }
+  UpdateHasLeaderUnlocked();
   VLOG_WITH_PREFIX(3) << "Latest replicas: " << ReplicasAsStringUnlocked();
   DCHECK(found) << "Tablet " << tablet_id_ << ": Specified server not found: "
                 << server->ToString() << ". Replicas: " << ReplicasAsStringUnlocked();
@@ -654,6 +669,7 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
   RemoteTabletPtr result;
   bool first = true;
   std::vector<std::pair<LookupTabletCallback, internal::RemoteTabletPtr>> to_notify;
+  std::unordered_set<TableId> tables_with_new_tablets;
 
   {
     std::lock_guard<decltype(mutex_)> l(mutex_);
@@ -686,6 +702,7 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
 
           CHECK(tablets_by_id_.emplace(tablet_id, remote).second);
           CHECK(tablets_by_key.emplace(partition.partition_key_start(), remote).second);
+          tables_with_new_tablets.insert(table_id);
         }
         remote->Refresh(ts_cache_, loc.replicas());
 
@@ -714,6 +731,10 @@ RemoteTabletPtr MetaCache::ProcessTabletLocations(
         }
       }
     }
+
+    if (!tables_with_new_tablets.empty()) {
+      UpdateTabletsByTableCacheUnlocked(tables_with_new_tablets);
+    }
   }
 
   for (const auto& callback_and_remote_tablet : to_notify) {
@@ -793,13 +814,11 @@ void MetaCache::LookupFailed(
 class LookupByIdRpc : public LookupRpc {
  public:
   LookupByIdRpc(const scoped_refptr<MetaCache>& meta_cache,
-                LookupTabletCallback user_cb,
                 TabletId tablet_id,
                 CoarseTimePoint deadline,
                 Messenger* messenger,
                 rpc::ProxyCache* proxy_cache)
       : LookupRpc(meta_cache, deadline, messenger, proxy_cache),
-        user_cb_(std::move(user_cb)),
         tablet_id_(std::move(tablet_id)) {}
 
   std::string ToString() const override {
@@ -821,19 +840,9 @@ class LookupByIdRpc : public LookupRpc {
   }
 
   void Notify(const Status& status, const RemoteTabletPtr& remote_tablet) override {
-    if (status.ok()) {
-      user_cb_(remote_tablet);
-    } else {
-      user_cb_(status);
-    }
+    meta_cache()->LookupByIdFinished(tablet_id_, status, remote_tablet);
   }
 
-
-  // User-specified callback to invoke when the lookup finishes.
-  //
-  // Always invoked, regardless of success or failure.
-  LookupTabletCallback user_cb_;
-
   // Tablet to lookup.
   TabletId tablet_id_;
 
@@ -907,6 +916,52 @@ class LookupByKeyRpc : public LookupRpc {
   GetTableLocationsResponsePB resp_;
 };
 
+void MetaCache::UpdateTabletsByTableCacheUnlocked(const std::unordered_set<TableId>& table_ids) {
+  TabletsByTable new_cache;
+  {
+    auto cache = tablets_by_table_cache_.get();
+    new_cache = *cache;
+  }
+  for (const auto& table_id : table_ids) {
+    new_cache[table_id] = std::make_shared<const TabletsByPartition>(
+        tables_[table_id].tablets_by_partition);
+  }
+  tablets_by_table_cache_.Set(std::move(new_cache));
+}
+
+namespace {
+
+// Returns whether tablet is not stale and contains specified partition key.
+bool IsValidTabletForPartitionKey(const RemoteTablet& tablet, const std::string& partition_key) {
+  // Stale entries must be re-fetched.
+  if (tablet.stale()) {
+    return false;
+  }
+
+  // partition_key < partition.end OR tablet doesn't end.
+  return tablet.partition().partition_key_end().compare(partition_key) > 0 ||
+         tablet.partition().partition_key_end().empty();
+}
+
+} // namespace
+
+RemoteTablet* MetaCache::LookupTabletByKeyFastPath(const TabletsByTable& cache,
+                                                   const YBTable* table,
+                                                   const std::string& partition_key) {
+  auto it = cache.find(table->id());
+  if (PREDICT_FALSE(it == cache.end())) {
+    return nullptr;
+  }
+
+  auto tablet_it = it->second->find(partition_key);
+  if (PREDICT_FALSE(tablet_it == it->second->end())) {
+    return nullptr;
+  }
+
+  auto* tablet = tablet_it->second.get();
+  return IsValidTabletForPartitionKey(*tablet, partition_key) ? tablet : nullptr;
+}
+
 RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* table,
                                                              const std::string& partition_key) {
   auto it = tables_.find(table->id());
@@ -923,19 +978,10 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(const YBTable* tabl
   }
 
   const auto& result = tablet_it->second;
-
-  // Stale entries must be re-fetched.
-  if (result->stale()) {
+  if (!IsValidTabletForPartitionKey(*result, partition_key)) {
     return nullptr;
   }
-
-  if (result->partition().partition_key_end().compare(partition_key) > 0 ||
-      result->partition().partition_key_end().empty()) {
-    // partition_key < partition.end OR tablet doesn't end.
-    return result;
-  }
-
-  return nullptr;
+  return result;
 }
 
 template <class Lock>
@@ -962,10 +1008,20 @@ void MetaCache::LookupTabletByKey(const YBTable* table,
                                   LookupTabletCallback callback) {
   const auto& partition_start = table->FindPartitionStart(partition_key);
 
-  rpc::Rpcs::Handle rpc;
   {
-    std::shared_lock<boost::shared_mutex> lock(mutex_);
-    if (FastLookupTabletByKeyUnlocked(table, partition_start, callback, &lock)) {
+    // Fast path: lookup in the cache, without acquiring mutex_. Reference to the tablet is
+    // acquired only when it is found, and moved to the callback.
+    RemoteTabletPtr result;
+    {
+      auto cache = tablets_by_table_cache_.get();
+      auto* tablet = LookupTabletByKeyFastPath(*cache, table, partition_start);
+      if (tablet && tablet->HasLeader()) {
+        result = tablet;
+      }
+    }
+    if (result) {
+      VLOG(3) << "Fast lookup: found tablet " << result->tablet_id();
+      callback(Result<RemoteTabletPtr>(std::move(result)));
       return;
     }
   }
@@ -1015,9 +1071,72 @@ void MetaCache::LookupTabletById(const TabletId& tablet_id,
     }
   }
 
+  {
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto& lookups = tablet_lookups_by_id_[tablet_id];
+    lookups.push_back(LookupData{std::move(callback), deadline});
+    if (lookups.size() > 1) {
+      // Lookup of this tablet is already in flight, callback will be invoked when it completes.
+      VLOG(3) << "Joined lookup of tablet " << tablet_id;
+      return;
+    }
+  }
+
   rpc::StartRpc<LookupByIdRpc>(
-      this, std::move(callback), tablet_id, deadline, client_->data_->messenger_,
-      client_->data_->proxy_cache_.get());
+      this, tablet_id, deadline, client_->data_->messenger_, client_->data_->proxy_cache_.get());
+}
+
+void MetaCache::LookupByIdFinished(
+    const TabletId& tablet_id, const Status& status, const RemoteTabletPtr& remote_tablet) {
+  std::vector<LookupTabletCallback> to_notify;
+  CoarseTimePoint max_deadline;
+  {
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    auto it = tablet_lookups_by_id_.find(tablet_id);
+    if (it == tablet_lookups_by_id_.end()) {
+      return;
+    }
+    auto& lookups = it->second;
+    if (!status.IsTimedOut()) {
+      for (auto& data : lookups) {
+        to_notify.push_back(std::move(data.callback));
+      }
+      tablet_lookups_by_id_.erase(it);
+    } else {
+      // Notify only lookups whose deadline has passed, and retry for others.
+      auto now = CoarseMonoClock::Now();
+      auto w = lookups.begin();
+      for (auto i = lookups.begin(); i != lookups.end(); ++i) {
+        if (i->deadline <= now) {
+          to_notify.push_back(std::move(i->callback));
+        } else {
+          max_deadline = std::max(max_deadline, i->deadline);
+          if (i != w) {
+            *w = std::move(*i);
+          }
+          ++w;
+        }
+      }
+      lookups.erase(w, lookups.end());
+      if (lookups.empty()) {
+        tablet_lookups_by_id_.erase(it);
+      }
+    }
+  }
+
+  for (const auto& callback : to_notify) {
+    if (status.ok()) {
+      callback(remote_tablet);
+    } else {
+      callback(status);
+    }
+  }
+
+  if (max_deadline != CoarseTimePoint()) {
+    rpc::StartRpc<LookupByIdRpc>(
+        this, tablet_id, max_deadline, client_->data_->messenger_,
+        client_->data_->proxy_cache_.get());
+  }
 }
 
 void MetaCache::MarkTSFailed(RemoteTabletServer* ts,
@@ -33,10 +33,12 @@
 #ifndef YB_CLIENT_META_CACHE_H
 #define YB_CLIENT_META_CACHE_H
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
@@ -57,6 +59,7 @@
 
 #include "yb/util/async_util.h"
 #include "yb/util/capabilities.h"
+#include "yb/util/concurrent_value.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
 #include "yb/util/semaphore.h"
@@ -97,6 +100,8 @@ class TSInfoPB;
 namespace client {
 
 class ClientTest_TestMasterLookupPermits_Test;
+class ClientTest_PrefetchTableLocations_Test;
+class ClientTest_LookupTabletByKeyPerf_Test;
 class YBClient;
 class YBTable;
 
@@ -287,14 +292,21 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // Same as ReplicasAsString(), except that the caller must hold lock_.
   std::string ReplicasAsStringUnlocked() const;
 
+  // Updates has_leader_ after change of replicas_, the caller must hold exclusive lock_.
+  void UpdateHasLeaderUnlocked();
+
   const std::string tablet_id_;
   const std::string log_prefix_;
   const Partition partition_;
 
   // All non-const members are protected by 'lock_'.
   mutable rw_spinlock mutex_;
-  bool stale_;
+  // Read without mutex_ by the lookup fast path.
+  std::atomic<bool> stale_;
   std::vector<RemoteReplica> replicas_;
+  // Whether replicas_ contain leader that has not failed. Read without mutex_ by the lookup
+  // fast path.
+  std::atomic<bool> has_leader_{false};
 
   // Last time this object was refreshed. Initialized to MonoTime::Min() so we don't have to be
   // checking whether it has been initialized everytime we use this value.
@@ -377,12 +389,24 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   friend class LookupByIdRpc;
 
   FRIEND_TEST(client::ClientTest, TestMasterLookupPermits);
+  FRIEND_TEST(client::ClientTest, PrefetchTableLocations);
+  FRIEND_TEST(client::ClientTest, LookupTabletByKeyPerf);
+
+  typedef std::string PartitionKey;
+  typedef std::unordered_map<PartitionKey, RemoteTabletPtr> TabletsByPartition;
+  typedef std::unordered_map<TableId, std::shared_ptr<const TabletsByPartition>> TabletsByTable;
 
   // Lookup the given tablet by key, only consulting local information.
   // Returns true and sets *remote_tablet if successful.
   RemoteTabletPtr LookupTabletByKeyFastPathUnlocked(const YBTable* table,
                                                     const std::string& partition_key);
 
+  // Same as above, but looks up in the snapshot of tablets_by_table_cache_, so does not require
+  // mutex_. Returned tablet is valid while the snapshot is referenced.
+  RemoteTablet* LookupTabletByKeyFastPath(const TabletsByTable& cache,
+                                          const YBTable* table,
+                                          const std::string& partition_key);
+
   RemoteTabletPtr LookupTabletByIdFastPath(const TabletId& tablet_id);
 
   // Update our information about the given tablet server.
@@ -393,11 +417,20 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   // NOTE: Must be called with lock_ held.
   void UpdateTabletServerUnlocked(const master::TSInfoPB& pb);
 
+  // Replaces tablets of specified tables in tablets_by_table_cache_ with their current state.
+  //
+  // NOTE: Must be called with mutex_ held.
+  void UpdateTabletsByTableCacheUnlocked(const std::unordered_set<TableId>& table_ids);
+
   // Notify appropriate callbacks that lookup of specified partition group of specified table
   // was failed because of specified status.
   void LookupFailed(
       const YBTable* table, const std::string& partition_group_start, const Status& status);
 
+  // Notify all callbacks waiting for lookup of specified tablet by id.
+  void LookupByIdFinished(
+      const TabletId& tablet_id, const Status& status, const RemoteTabletPtr& remote_tablet);
+
   template <class Lock>
   bool FastLookupTabletByKeyUnlocked(
       const YBTable* table,
@@ -434,21 +467,31 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   };
 
   typedef std::unordered_map<std::string, std::vector<LookupData>> PartitionToLookupData;
-  typedef std::string PartitionKey;
   typedef std::string PartitionGroupKey;
 
   struct TableData {
-    std::unordered_map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
+    TabletsByPartition tablets_by_partition;
     std::unordered_map<PartitionGroupKey, PartitionToLookupData> tablet_lookups_by_group;
   };
 
   std::unordered_map<TableId, TableData> tables_;
 
+  // Immutable copy of tablets_by_partition of all tables, used by the lookup fast path without
+  // acquiring mutex_. Replaced under mutex_ when new tablets are added to tables_, maps of
+  // unchanged tables are shared between old and new copies.
+  ConcurrentValue<TabletsByTable> tablets_by_table_cache_;
+
   // Cache of tablets, keyed by tablet ID.
   //
   // Protected by lock_
   std::unordered_map<std::string, RemoteTabletPtr> tablets_by_id_;
 
+  // Lookups of tablets by ID. Only one RPC per tablet is in flight, other lookups of the same
+  // tablet wait for it.
+  //
+  // Protected by mutex_.
+  std::unordered_map<TabletId, std::vector<LookupData>> tablet_lookups_by_id_;
+
   // Prevents master lookup "storms" by delaying master lookups when all
   // permits have been acquired.
   Semaphore master_lookup_sem_;
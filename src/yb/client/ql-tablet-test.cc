@@ -13,6 +13,7 @@
 //
 //
 
+#include <map>
 #include <shared_mutex>
 #include <thread>
 
@@ -41,6 +42,7 @@
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tserver_service.proxy.h"
 
+#include "yb/util/path_util.h"
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
 
@@ -307,15 +309,25 @@ class QLTabletTest : public QLDmlTestBase {
         auto source_dir = source_peer->tablet()->metadata()->rocksdb_dir();
         tablet_manager->LookupTablet(dest_infos[j]->id(), &dest_peer);
         EXPECT_NE(nullptr, dest_peer);
-        auto status = dest_peer->tablet()->ImportData(source_dir);
-        if (!status.ok() && !status.IsNotFound()) {
-          return status;
-        }
+        RETURN_NOT_OK(dest_peer->tablet()->ImportData(source_dir));
       }
     }
     return Status::OK();
   }
 
+  // Returns rocksdb dirs of the tablet replicas, keyed by tablet server uuid.
+  std::map<std::string, std::string> ReplicaDirs(const TabletId& tablet_id) {
+    std::map<std::string, std::string> result;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto* server = cluster_->mini_tablet_server(i)->server();
+      tablet::TabletPeerPtr peer;
+      if (server->tablet_manager()->LookupTablet(tablet_id, &peer)) {
+        result.emplace(server->permanent_uuid(), peer->tablet()->metadata()->rocksdb_dir());
+      }
+    }
+    return result;
+  }
+
   scoped_refptr<master::TableInfo> GetTableInfo(const YBTableName& table_name) {
     auto* catalog_manager = cluster_->leader_mini_master()->master()->catalog_manager();
     std::vector<scoped_refptr<master::TableInfo>> all_tables;
@@ -402,6 +414,58 @@ TEST_F(QLTabletTest, OverlappedImport) {
   ASSERT_NOK(Import());
 }
 
+TEST_F(QLTabletTest, ImportThroughClient) {
+  CreateTables(0, kBigSeqNo);
+
+  FillTable(0, kTotalKeys, &table1_);
+  std::this_thread::sleep_for(1s); // Wait until all tablets a synced and flushed.
+  ASSERT_OK(cluster_->FlushTablets());
+
+  auto source_infos = GetTabletInfos(kTable1Name);
+  auto dest_infos = GetTabletInfos(kTable2Name);
+  ASSERT_EQ(source_infos.size(), dest_infos.size());
+  ASSERT_GT(source_infos.size(), 1U);
+
+  // Data of other tablet does not match partition of destination tablet.
+  {
+    std::set<std::string> imported;
+    ASSERT_NOK(client_->ImportTabletData(
+        dest_infos[1]->id(), ReplicaDirs(source_infos[0]->id()), &imported));
+    ASSERT_TRUE(imported.empty());
+  }
+
+  // Data should be provided for every replica.
+  {
+    auto dirs = ReplicaDirs(source_infos[0]->id());
+    dirs.erase(dirs.begin());
+    std::set<std::string> imported;
+    ASSERT_NOK(client_->ImportTabletData(dest_infos[0]->id(), dirs, &imported));
+    ASSERT_TRUE(imported.empty());
+  }
+
+  // Missing source directory is an error, not an empty import.
+  {
+    auto dirs = ReplicaDirs(source_infos[0]->id());
+    for (auto& dir : dirs) {
+      dir.second = JoinPathSegments(dir.second, "missing");
+    }
+    std::set<std::string> imported;
+    auto status = client_->ImportTabletData(dest_infos[0]->id(), dirs, &imported);
+    ASSERT_TRUE(status.IsNotFound()) << status;
+    ASSERT_TRUE(imported.empty());
+  }
+
+  for (size_t i = 0; i != source_infos.size(); ++i) {
+    auto dirs = ReplicaDirs(source_infos[i]->id());
+    std::set<std::string> imported;
+    ASSERT_OK(client_->ImportTabletData(dest_infos[i]->id(), dirs, &imported));
+    ASSERT_EQ(dirs.size(), imported.size());
+    // Retry with imported replicas does not import the same data again.
+    ASSERT_OK(client_->ImportTabletData(dest_infos[i]->id(), dirs, &imported));
+  }
+  VerifyTable(0, kTotalKeys, &table2_);
+}
+
 void DoStepDowns(MiniCluster* cluster) {
   for (int j = 0; j != 5; ++j) {
     StepDownAllTablets(cluster);
@@ -24,16 +24,21 @@
 
 #include "yb/consensus/consensus.h"
 
+#include "yb/master/master_defaults.h"
+
 #include "yb/rpc/rpc.h"
 
+#include "yb/tablet/conflict_history.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/transaction_coordinator.h"
+#include "yb/tablet/transaction_status_resolver.h"
 
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver_service.pb.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
 
@@ -45,6 +50,9 @@ using namespace std::literals;
 using yb::tablet::GetTransactionTimeout;
 using yb::tablet::TabletPeer;
 
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_HeartbeatTransactions);
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_UpdateTransaction);
+
 DECLARE_uint64(transaction_heartbeat_usec);
 DECLARE_uint64(log_segment_size_bytes);
 DECLARE_int32(log_min_seconds_to_retain);
@@ -59,6 +67,16 @@ DECLARE_int32(master_inject_latency_on_transactional_tablet_lookups_ms);
 DECLARE_int64(transaction_rpc_timeout_ms);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(delay_init_tablet_peer_ms);
+DECLARE_bool(enable_transaction_wait_queues);
+DECLARE_int32(transaction_conflict_history_size);
+DECLARE_bool(auto_create_local_transaction_tables);
+DECLARE_string(placement_cloud);
+DECLARE_string(placement_region);
+DECLARE_uint64(txn_max_apply_batch_records);
+DECLARE_bool(transaction_omit_unknown_status_time_in_tests);
+DECLARE_bool(reject_heartbeat_transactions_as_unknown_method);
+DECLARE_bool(use_local_transaction_tables);
+DECLARE_int32(transaction_tables_refresh_interval_ms);
 
 namespace yb {
 namespace client {
@@ -89,6 +107,54 @@ TEST_F(QLTransactionTest, Simple) {
   CheckNoRunningTransactions();
 }
 
+// Transactions that write single row are committed in one phase, so do not create
+// transaction status records. Multi tablet transaction falls back to regular commit.
+TEST_F(QLTransactionTest, OnePhaseCommit) {
+  for (size_t r = 0; r != kNumRows; ++r) {
+    auto txn = CreateTransaction();
+    auto session = CreateSession(txn);
+    auto op = ASSERT_RESULT(WriteRow(
+        session, KeyForTransactionAndIndex(0, r),
+        ValueForTransactionAndIndex(0, r, WriteOpType::INSERT), WriteOpType::INSERT,
+        Flush::kFalse));
+    ASSERT_OK(txn->FlushAndCommitFuture(session.get()).get());
+    ASSERT_TRUE(op->succeeded());
+    ASSERT_FALSE(HasTransactions());
+  }
+  ASSERT_NO_FATALS(VerifyRows(CreateSession(), 0 /* transaction */));
+
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  for (size_t r = 0; r != kNumRows; ++r) {
+    ASSERT_OK(WriteRow(
+        session, KeyForTransactionAndIndex(1, r),
+        ValueForTransactionAndIndex(1, r, WriteOpType::INSERT), WriteOpType::INSERT,
+        Flush::kFalse));
+  }
+  ASSERT_OK(txn->FlushAndCommitFuture(session.get()).get());
+  ASSERT_NO_FATALS(VerifyRows(CreateSession(), 1 /* transaction */));
+
+  // Batch flushed earlier and still in flight makes last batch ineligible for one phase commit,
+  // so writes of both batches are committed.
+  for (size_t r = 0; r != kNumRows; ++r) {
+    txn = CreateTransaction();
+    session = CreateSession(txn);
+    ASSERT_OK(WriteRow(
+        session, KeyForTransactionAndIndex(2, r),
+        ValueForTransactionAndIndex(2, r, WriteOpType::INSERT), WriteOpType::INSERT,
+        Flush::kFalse));
+    auto first_flush = session->FlushFuture();
+    ASSERT_OK(WriteRow(
+        session, KeyForTransactionAndIndex(3, r),
+        ValueForTransactionAndIndex(3, r, WriteOpType::INSERT), WriteOpType::INSERT,
+        Flush::kFalse));
+    ASSERT_OK(txn->FlushAndCommitFuture(session.get()).get());
+    ASSERT_OK(first_flush.get());
+  }
+  ASSERT_NO_FATALS(VerifyRows(CreateSession(), 2 /* transaction */));
+  ASSERT_NO_FATALS(VerifyRows(CreateSession(), 3 /* transaction */));
+}
+
 TEST_F(QLTransactionTest, LookupTabletFailure) {
   FLAGS_master_inject_latency_on_transactional_tablet_lookups_ms =
       TransactionRpcTimeout().ToMilliseconds() + 500;
@@ -99,6 +165,24 @@ TEST_F(QLTransactionTest, LookupTabletFailure) {
   ASSERT_TRUE(!result.ok() && result.status().IsTimedOut()) << "Result: " << result;
 }
 
+// Read only snapshot transaction does not use status tablet, so it is not affected by slow
+// lookup of status tablet.
+TEST_F(QLTransactionTest, ReadOnly) {
+  FLAGS_master_inject_latency_on_transactional_tablet_lookups_ms =
+      TransactionRpcTimeout().ToMilliseconds() + 500;
+
+  auto txn = CreateTransaction();
+  auto session = CreateSession(txn);
+  for (int32_t key = 0; key != 10; ++key) {
+    auto result = SelectRow(session, key);
+    ASSERT_TRUE(!result.ok() && result.status().IsNotFound()) << "Result: " << result;
+  }
+  auto start = MonoTime::Now();
+  ASSERT_OK(txn->CommitFuture().get());
+  ASSERT_LT(MonoTime::Now() - start, TransactionRpcTimeout());
+  ASSERT_FALSE(HasTransactions());
+}
+
 TEST_F(QLTransactionTest, ReadWithTimeInFuture) {
   WriteData();
   server::SkewedClockDeltaChanger delta_changer(100ms, skewed_clock_);
@@ -410,6 +494,75 @@ TEST_F(QLTransactionTest, Heartbeat) {
   CheckNoRunningTransactions();
 }
 
+// Heartbeats of several transactions with the same status tablet are sent in a single RPC.
+TEST_F(QLTransactionTest, HeartbeatBatching) {
+  constexpr size_t kTransactions = 10;
+  std::vector<YBTransactionPtr> transactions;
+  std::unordered_set<TabletId> status_tablets;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    auto txn = CreateTransaction();
+    WriteRows(CreateSession(txn), i);
+    status_tablets.insert(txn->TEST_GetMetadata().get().status_tablet);
+    transactions.push_back(std::move(txn));
+  }
+
+  auto count_calls = [this](const HistogramPrototype& prototype) {
+    int64_t result = 0;
+    for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      result += prototype.Instantiate(
+          cluster_->mini_tablet_server(i)->server()->metric_entity())->TotalCount();
+    }
+    return result;
+  };
+  auto heartbeats_before = count_calls(
+      METRIC_handler_latency_yb_tserver_TabletServerService_HeartbeatTransactions);
+  auto updates_before = count_calls(
+      METRIC_handler_latency_yb_tserver_TabletServerService_UpdateTransaction);
+  const auto kWaitTime = GetTransactionTimeout() * 2;
+  std::this_thread::sleep_for(kWaitTime);
+  auto heartbeats = count_calls(
+      METRIC_handler_latency_yb_tserver_TabletServerService_HeartbeatTransactions) -
+      heartbeats_before;
+  auto updates = count_calls(
+      METRIC_handler_latency_yb_tserver_TabletServerService_UpdateTransaction) - updates_before;
+
+  // Transactions should be kept alive by batched heartbeats only, at most one RPC per status
+  // tablet per heartbeat interval.
+  const int64_t max_rounds =
+      kWaitTime / std::chrono::microseconds(FLAGS_transaction_heartbeat_usec) + 2;
+  LOG(INFO) << "Heartbeat RPCs: " << heartbeats << ", update RPCs: " << updates
+            << ", status tablets: " << status_tablets.size();
+  ASSERT_EQ(updates, 0);
+  ASSERT_GT(heartbeats, 0);
+  ASSERT_LE(heartbeats, max_rounds * static_cast<int64_t>(status_tablets.size()));
+
+  for (auto& txn : transactions) {
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+  VerifyData(kTransactions);
+  CheckNoRunningTransactions();
+}
+
+// Client should fall back to per transaction heartbeats when tablet server does not support
+// batches, otherwise transactions would expire.
+TEST_F(QLTransactionTest, HeartbeatBatchingNotSupported) {
+  FLAGS_reject_heartbeat_transactions_as_unknown_method = true;
+  constexpr size_t kTransactions = 5;
+  std::vector<YBTransactionPtr> transactions;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    auto txn = CreateTransaction();
+    WriteRows(CreateSession(txn), i);
+    transactions.push_back(std::move(txn));
+  }
+  std::this_thread::sleep_for(GetTransactionTimeout() * 2);
+  for (auto& txn : transactions) {
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+  VerifyData(kTransactions);
+  ASSERT_FALSE(transaction_manager_->HeartbeatBatchingSupported());
+  CheckNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, Expire) {
   SetDisableHeartbeatInTests(true);
   auto txn = CreateTransaction();
@@ -468,6 +621,20 @@ TEST_F(QLTransactionTest, ResendApplying) {
   CheckNoRunningTransactions();
 }
 
+// Intents of transaction are applied in several batches, the rest of batches in background.
+TEST_F(QLTransactionTest, BatchedApply) {
+  FLAGS_txn_max_apply_batch_records = 1;
+  for (size_t i = 0; i != 3; ++i) {
+    WriteData(WriteOpType::INSERT, i);
+    VerifyData(i + 1);
+  }
+  ASSERT_OK(WaitTransactionsCleaned());
+  VerifyData(3);
+  ASSERT_OK(cluster_->RestartSync());
+  CheckNoRunningTransactions();
+  VerifyData(3);
+}
+
 TEST_F(QLTransactionTest, ConflictResolution) {
   constexpr size_t kTotalTransactions = 5;
   constexpr size_t kNumRows = 10;
@@ -533,6 +700,36 @@ TEST_F(QLTransactionTest, ConflictResolution) {
   }
 }
 
+// Second transaction either aborts the first one or waits for its commit, so in both cases
+// its write should succeed.
+TEST_F(QLTransactionTest, WaitQueue) {
+  constexpr int32_t kKey = 1;
+
+  FLAGS_enable_transaction_wait_queues = true;
+
+  auto txn1 = CreateTransaction();
+  ASSERT_OK(WriteRow(CreateSession(txn1), kKey, 1 /* value */));
+
+  auto txn2 = CreateTransaction();
+  auto session2 = CreateSession(txn2);
+  auto op = ASSERT_RESULT(WriteRow(
+      session2, kKey, 2 /* value */, WriteOpType::INSERT, Flush::kFalse));
+  std::promise<Status> flush_promise;
+  session2->FlushAsync([&flush_promise](const Status& status) {
+    flush_promise.set_value(status);
+  });
+
+  std::this_thread::sleep_for(200ms);
+  auto commit1_status = txn1->CommitFuture().get();
+  LOG(INFO) << "First transaction commit: " << commit1_status;
+
+  ASSERT_OK(flush_promise.get_future().get());
+  ASSERT_TRUE(op->succeeded());
+  ASSERT_OK(txn2->CommitFuture().get());
+
+  ASSERT_EQ(2, ASSERT_RESULT(SelectRow(CreateSession(), kKey)));
+}
+
 TEST_F(QLTransactionTest, SimpleWriteConflict) {
   auto transaction = CreateTransaction();
   WriteRows(CreateSession(transaction));
@@ -541,6 +738,65 @@ TEST_F(QLTransactionTest, SimpleWriteConflict) {
   ASSERT_NOK(transaction->CommitFuture().get());
 }
 
+TEST_F(QLTransactionTest, ConflictHistory) {
+  auto txn1 = CreateTransaction();
+  ASSERT_RESULT(WriteRow(CreateSession(txn1), 1, 1));
+  auto txn2 = CreateTransaction();
+  auto result = WriteRow(CreateSession(txn2), 1, 2);
+  LOG(INFO) << "Conflicting write succeeded: " << result.ok();
+
+  // Either the first transaction was aborted or the second one failed, both cases are recorded.
+  size_t found = 0;
+  for (int i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    std::vector<tablet::TabletPeerPtr> peers;
+    cluster_->mini_tablet_server(i)->server()->tablet_manager()->GetTabletPeers(&peers);
+    for (const auto& peer : peers) {
+      for (const auto& entry : peer->tablet()->conflict_history().Entries()) {
+        LOG(INFO) << "Conflict: " << entry.info.ToString();
+        ASSERT_EQ(txn2->id(), entry.info.transaction_id);
+        ASSERT_EQ(txn1->id(), entry.info.conflicting_id);
+        ASSERT_FALSE(entry.info.key.empty());
+        ++found;
+      }
+    }
+  }
+  ASSERT_GE(found, 1U);
+}
+
+// Conflict history should keep entries ordered after its size is changed at runtime.
+TEST(ConflictHistoryTest, Resize) {
+  FLAGS_transaction_conflict_history_size = 3;
+  tablet::ConflictHistory history(nullptr /* metrics */);
+  auto add = [&history](int i) {
+    history.ConflictDetected(docdb::ConflictInfo{
+        boost::uuids::nil_uuid(), boost::uuids::nil_uuid(), std::to_string(i),
+        docdb::ConflictOutcome::kHigherPriority});
+  };
+  auto keys = [&history] {
+    std::vector<std::string> result;
+    for (const auto& entry : history.Entries()) {
+      result.push_back(entry.info.key);
+    }
+    return result;
+  };
+
+  for (int i = 1; i <= 4; ++i) {
+    add(i);
+  }
+  ASSERT_EQ((std::vector<std::string>{"2", "3", "4"}), keys());
+
+  FLAGS_transaction_conflict_history_size = 5;
+  add(5);
+  add(6);
+  ASSERT_EQ((std::vector<std::string>{"2", "3", "4", "5", "6"}), keys());
+  add(7);
+  ASSERT_EQ((std::vector<std::string>{"3", "4", "5", "6", "7"}), keys());
+
+  FLAGS_transaction_conflict_history_size = 2;
+  add(8);
+  ASSERT_EQ((std::vector<std::string>{"7", "8"}), keys());
+}
+
 void QLTransactionTest::TestWriteConflicts(bool do_restarts) {
   struct ActiveTransaction {
     YBTransactionPtr transaction;
@@ -1028,28 +1284,31 @@ struct TransactionState {
     auto resp = status_future.get();
     ASSERT_OK(resp);
 
-    if (resp->status() == TransactionStatus::ABORTED) {
+    ASSERT_EQ(1, resp->status().size());
+    ASSERT_EQ(1, resp->status_hybrid_time().size());
+
+    if (resp->status(0) == TransactionStatus::ABORTED) {
       ASSERT_TRUE(commit_future.valid());
       transaction = nullptr;
       return;
     }
 
-    auto new_time = HybridTime(resp->status_hybrid_time());
+    auto new_time = HybridTime(resp->status_hybrid_time(0));
     if (last_status == TransactionStatus::PENDING) {
-      if (resp->status() == TransactionStatus::PENDING) {
+      if (resp->status(0) == TransactionStatus::PENDING) {
         ASSERT_GE(new_time, status_time);
       } else {
-        ASSERT_EQ(TransactionStatus::COMMITTED, resp->status());
+        ASSERT_EQ(TransactionStatus::COMMITTED, resp->status(0));
         ASSERT_GT(new_time, status_time);
       }
     } else {
       ASSERT_EQ(last_status, TransactionStatus::COMMITTED);
-      ASSERT_EQ(resp->status(), TransactionStatus::COMMITTED)
-          << "Bad transaction status: " << TransactionStatus_Name(resp->status());
+      ASSERT_EQ(resp->status(0), TransactionStatus::COMMITTED)
+          << "Bad transaction status: " << TransactionStatus_Name(resp->status(0));
       ASSERT_EQ(status_time, new_time);
     }
     status_time = new_time;
-    last_status = resp->status();
+    last_status = resp->status(0);
   }
 };
 
@@ -1111,7 +1370,7 @@ TEST_F(QLTransactionTest, StatusEvolution) {
       }
       tserver::GetTransactionStatusRequestPB req;
       req.set_tablet_id(state.metadata.status_tablet);
-      req.set_transaction_id(state.metadata.transaction_id.data,
+      req.add_transaction_id(state.metadata.transaction_id.data,
                              state.metadata.transaction_id.size());
       state.status_future = rpc::WrapRpcFuture<tserver::GetTransactionStatusResponsePB>(
           GetTransactionStatus, &rpcs)(
@@ -1133,6 +1392,91 @@ TEST_F(QLTransactionTest, StatusEvolution) {
   }
 }
 
+// Checks that status resolver reports final statuses of transactions and caches commit times.
+TEST_F(QLTransactionTest, StatusResolver) {
+  constexpr size_t kTransactions = 10;
+
+  std::promise<YBClient*> client_promise;
+  client_promise.set_value(client_.get());
+  tablet::TransactionStatusResolver resolver(client_promise.get_future().share(), clock_);
+  BOOST_SCOPE_EXIT(&resolver) {
+    resolver.Shutdown();
+  } BOOST_SCOPE_EXIT_END;
+
+  std::vector<TransactionMetadata> metadatas;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    auto txn = CreateTransaction();
+    ASSERT_RESULT(WriteRow(CreateSession(txn), i, i));
+    metadatas.push_back(txn->TEST_GetMetadata().get());
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+
+  for (int pass = 0; pass != 2; ++pass) {
+    std::vector<std::future<Result<TransactionStatusResult>>> futures;
+    for (const auto& metadata : metadatas) {
+      auto promise = std::make_shared<std::promise<Result<TransactionStatusResult>>>();
+      futures.push_back(promise->get_future());
+      resolver.Resolve(
+          metadata.status_tablet, metadata.transaction_id,
+          [promise](Result<TransactionStatusResult> result) {
+            promise->set_value(std::move(result));
+          });
+    }
+    size_t committed = 0;
+    for (auto& future : futures) {
+      auto result = ASSERT_RESULT(future.get());
+      // Committed transaction could be already cleaned up by coordinator, so it is reported
+      // as aborted.
+      if (result.status == TransactionStatus::COMMITTED) {
+        ASSERT_TRUE(result.status_time.is_valid());
+        ++committed;
+      } else {
+        ASSERT_EQ(TransactionStatus::ABORTED, result.status);
+        ASSERT_EQ(HybridTime::kMax, result.status_time);
+      }
+    }
+    // Only committed transactions are cached, and they are reported as committed while cached.
+    ASSERT_EQ(committed, resolver.TEST_CacheSize());
+  }
+}
+
+// Coordinator of older version does not set status time when reporting unknown transaction as
+// aborted, status resolver should report such transaction as aborted at HybridTime::kMax.
+TEST_F(QLTransactionTest, StatusResolverWithoutStatusTime) {
+  constexpr size_t kTransactions = 5;
+
+  FLAGS_transaction_omit_unknown_status_time_in_tests = true;
+
+  std::promise<YBClient*> client_promise;
+  client_promise.set_value(client_.get());
+  tablet::TransactionStatusResolver resolver(client_promise.get_future().share(), clock_);
+  BOOST_SCOPE_EXIT(&resolver) {
+    resolver.Shutdown();
+  } BOOST_SCOPE_EXIT_END;
+
+  auto txn = CreateTransaction();
+  ASSERT_RESULT(WriteRow(CreateSession(txn), 0, 0));
+  auto status_tablet = txn->TEST_GetMetadata().get().status_tablet;
+  ASSERT_OK(txn->CommitFuture().get());
+
+  std::vector<std::future<Result<TransactionStatusResult>>> futures;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    auto promise = std::make_shared<std::promise<Result<TransactionStatusResult>>>();
+    futures.push_back(promise->get_future());
+    resolver.Resolve(
+        status_tablet, GenerateTransactionId(),
+        [promise](Result<TransactionStatusResult> result) {
+          promise->set_value(std::move(result));
+        });
+  }
+  for (auto& future : futures) {
+    auto result = ASSERT_RESULT(future.get());
+    ASSERT_EQ(TransactionStatus::ABORTED, result.status);
+    ASSERT_EQ(HybridTime::kMax, result.status_time);
+  }
+  ASSERT_EQ(0, resolver.TEST_CacheSize());
+}
+
 // Writing multiple keys concurrently, each key is increasing by 1 at each step.
 // At the same time concurrently execute several transactions that read all those keys.
 // Suppose two transactions have read values t1_i and t2_i respectively.
@@ -1509,6 +1853,56 @@ TEST_F(QLTransactionTest, DelayedInit) {
   }
 }
 
+class LocalTransactionTablesTest : public QLTransactionTest {
+ protected:
+  void SetUp() override {
+    FLAGS_auto_create_local_transaction_tables = true;
+    QLTransactionTest::SetUp();
+  }
+};
+
+// Checks that transaction status table is created for the region of tablet servers, and
+// transactions of clients from this region use its tablets.
+TEST_F_EX(QLTransactionTest, LocalTransactionTables, LocalTransactionTablesTest) {
+  CloudInfoPB cloud_info;
+  cloud_info.set_placement_cloud(FLAGS_placement_cloud);
+  cloud_info.set_placement_region(FLAGS_placement_region);
+
+  std::vector<TabletId> local_tablets;
+  ASSERT_OK(client_->GetTablets(
+      YBTableName(master::kSystemNamespaceName, LocalTransactionsTableName(cloud_info)),
+      0 /* max_tablets */, &local_tablets, /* ranges */ nullptr));
+  ASSERT_FALSE(local_tablets.empty());
+
+  YBClientBuilder builder;
+  builder.set_cloud_info_pb(cloud_info);
+  auto local_client = ASSERT_RESULT(cluster_->CreateClient(&builder));
+  TransactionManager local_manager(local_client.get(), clock_, LocalTabletFilter());
+  auto txn = std::make_shared<YBTransaction>(&local_manager);
+  ASSERT_OK(txn->Init(GetIsolationLevel()));
+  auto metadata = txn->TEST_GetMetadata().get();
+  ASSERT_NE(std::find(local_tablets.begin(), local_tablets.end(), metadata.status_tablet),
+            local_tablets.end());
+
+  // Cached status tablets are resolved again after refresh interval, so manager that picked
+  // global tablets switches to the local table.
+  FLAGS_use_local_transaction_tables = false;
+  FLAGS_transaction_tables_refresh_interval_ms = 0;
+  TransactionManager refreshed_manager(local_client.get(), clock_, LocalTabletFilter());
+  auto global_txn = std::make_shared<YBTransaction>(&refreshed_manager);
+  ASSERT_OK(global_txn->Init(GetIsolationLevel()));
+  metadata = global_txn->TEST_GetMetadata().get();
+  ASSERT_EQ(std::find(local_tablets.begin(), local_tablets.end(), metadata.status_tablet),
+            local_tablets.end());
+
+  FLAGS_use_local_transaction_tables = true;
+  auto local_txn = std::make_shared<YBTransaction>(&refreshed_manager);
+  ASSERT_OK(local_txn->Init(GetIsolationLevel()));
+  metadata = local_txn->TEST_GetMetadata().get();
+  ASSERT_NE(std::find(local_tablets.begin(), local_tablets.end(), metadata.status_tablet),
+            local_tablets.end());
+}
+
 class QLTransactionTestSingleTablet : public QLTransactionTest {
  public:
   int NumTablets() override {
@@ -1548,5 +1942,34 @@ TEST_F_EX(QLTransactionTest, DeleteFlushedIntents, QLTransactionTestSingleTablet
   }
 }
 
+// Intents are removed with single deletes, so intents of a row overwritten by the same
+// transaction should not resurface after compaction.
+TEST_F_EX(QLTransactionTest, CompactOverwrittenIntents, QLTransactionTestSingleTablet) {
+  SetAtomicFlag(0ULL, &FLAGS_max_clock_skew_usec); // To avoid read restart in this test.
+
+  {
+    auto txn = CreateTransaction();
+    auto session = CreateSession(txn);
+    ASSERT_OK(WriteRow(session, 1, 1));
+    ASSERT_OK(cluster_->FlushTablets(tablet::FlushMode::kSync, tablet::FlushFlags::kIntents));
+    ASSERT_OK(UpdateRow(session, 1, 11));
+    ASSERT_OK(cluster_->FlushTablets(tablet::FlushMode::kSync, tablet::FlushFlags::kIntents));
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+
+  ASSERT_OK(WaitFor([this] { return CountIntents() == 0; }, 15s * kTimeMultiplier,
+                    "Intents are applied"));
+
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+    if (peer->tablet()) {
+      peer->tablet()->ForceRocksDBCompactInTest();
+    }
+  }
+
+  ASSERT_EQ(CountIntents(), 0);
+  auto session = CreateSession();
+  VERIFY_ROW(session, 1, 11);
+}
+
 } // namespace client
 } // namespace yb
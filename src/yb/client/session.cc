@@ -21,6 +21,9 @@
 
 #include "yb/common/consistent_read_point.h"
 
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/scheduler.h"
+
 DEFINE_int32(client_read_write_timeout_ms, 60000, "Timeout for client read and write operations.");
 
 namespace yb {
@@ -60,9 +63,12 @@ bool YBSession::IsRestartRequired() {
 }
 
 void YBSession::SetTransaction(YBTransactionPtr transaction) {
-  transaction_ = std::move(transaction);
   internal::BatcherPtr old_batcher;
-  old_batcher.swap(batcher_);
+  {
+    std::lock_guard<std::mutex> lock(batcher_mutex_);
+    transaction_ = std::move(transaction);
+    old_batcher = TakeBatcherUnlocked();
+  }
   if (old_batcher) {
     LOG_IF(DFATAL, old_batcher->HasPendingOperations()) << "SetTransaction with non empty batcher";
     old_batcher->Abort(STATUS(Aborted, "Transaction changed"));
@@ -70,6 +76,7 @@ void YBSession::SetTransaction(YBTransactionPtr transaction) {
 }
 
 void YBSession::SetMemoryLimitScore(double score) {
+  std::lock_guard<std::mutex> lock(batcher_mutex_);
   memory_limit_score_ = score;
   if (batcher_) {
     batcher_->SetMemoryLimitScore(score);
@@ -81,25 +88,46 @@ YBSession::~YBSession() {
 }
 
 void YBSession::Abort() {
-  if (batcher_ && batcher_->HasPendingOperations()) {
-    batcher_->Abort(STATUS(Aborted, "Batch aborted"));
-    batcher_.reset();
+  internal::BatcherPtr old_batcher;
+  {
+    std::lock_guard<std::mutex> lock(batcher_mutex_);
+    if (batcher_ && batcher_->HasPendingOperations()) {
+      old_batcher = TakeBatcherUnlocked();
+    }
+  }
+  if (old_batcher) {
+    old_batcher->Abort(STATUS(Aborted, "Batch aborted"));
   }
 }
 
 Status YBSession::Close(bool force) {
-  if (batcher_) {
-    if (batcher_->HasPendingOperations() && !force) {
-      return STATUS(IllegalState, "Could not close. There are pending operations.");
+  internal::BatcherPtr old_batcher;
+  internal::WriteRpcWindowPtr write_rpc_window;
+  {
+    std::lock_guard<std::mutex> lock(batcher_mutex_);
+    if (batcher_) {
+      if (batcher_->HasPendingOperations() && !force) {
+        return STATUS(IllegalState, "Could not close. There are pending operations.");
+      }
+      old_batcher = TakeBatcherUnlocked();
     }
-    batcher_->Abort(STATUS(Aborted, "Batch aborted"));
-    batcher_.reset();
+    if (force) {
+      write_rpc_window = write_rpc_window_;
+    }
+  }
+  if (old_batcher) {
+    old_batcher->Abort(STATUS(Aborted, "Batch aborted"));
+  }
+  // Writes of already flushed batches that wait for their turn are not sent after close.
+  if (write_rpc_window) {
+    write_rpc_window->Abort(nullptr, STATUS(Aborted, "Session closed"));
   }
   return Status::OK();
 }
 
 void YBSession::SetTimeout(MonoDelta timeout) {
   CHECK_GE(timeout, MonoDelta::kZero);
+  std::lock_guard<std::mutex> lock(batcher_mutex_);
   timeout_ = timeout;
   if (batcher_) {
     batcher_->SetTimeout(timeout);
@@ -112,6 +140,20 @@ Status YBSession::Flush() {
   return s.Wait();
 }
 
+void YBSession::SetAutoFlush(MonoDelta max_latency, size_t max_batch_bytes) {
+  std::lock_guard<std::mutex> lock(batcher_mutex_);
+  auto_flush_max_latency_ = max_latency;
+  auto_flush_max_batch_bytes_ = max_batch_bytes;
+}
+
+void YBSession::SetMaxInFlightWritesPerTablet(size_t value) {
+  std::lock_guard<std::mutex> lock(batcher_mutex_);
+  write_rpc_window_ = value ? std::make_shared<internal::WriteRpcWindow>(value) : nullptr;
+  if (batcher_) {
+    batcher_->SetWriteRpcWindow(write_rpc_window_);
+  }
+}
+
 void YBSession::FlushAsync(StatusFunctor callback) {
   // Swap in a new batcher to start building the next batch.
   // Save off the old batcher.
@@ -121,19 +163,155 @@ void YBSession::FlushAsync(StatusFunctor callback) {
   // the batch fails "inline" on the same thread.
 
   internal::BatcherPtr old_batcher;
-  old_batcher.swap(batcher_);
-  if (old_batcher) {
-    {
-      std::lock_guard<simple_spinlock> l(lock_);
-      flushed_batchers_.insert(old_batcher);
+  Status auto_flush_status;
+  bool wait_auto_flushes = false;
+  {
+    std::lock_guard<std::mutex> lock(batcher_mutex_);
+    old_batcher = TakeBatcherUnlocked();
+    wait_auto_flushes = auto_flushes_in_flight_ != 0;
+    if (wait_auto_flushes) {
+      // Complete this flush together with automatically flushed batchers.
+      auto_flush_waiters_.push_back(std::move(callback));
+      if (old_batcher) {
+        ++auto_flushes_in_flight_;
+      }
+    } else {
+      auto_flush_status = std::move(auto_flush_status_);
+      auto_flush_status_ = Status::OK();
     }
-    old_batcher->set_allow_local_calls_in_curr_thread(allow_local_calls_in_curr_thread_);
-    old_batcher->FlushAsync(std::move(callback));
+  }
+
+  if (wait_auto_flushes) {
+    AutoFlush(old_batcher);
+    return;
+  }
+
+  if (!auto_flush_status.ok()) {
+    callback = [callback = std::move(callback), auto_flush_status](const Status& status) {
+      callback(status.ok() ? auto_flush_status : status);
+    };
+  }
+
+  if (old_batcher) {
+    FlushBatcher(old_batcher, std::move(callback));
   } else {
     callback(Status::OK());
   }
 }
 
+void YBSession::FlushBatcher(const internal::BatcherPtr& batcher, StatusFunctor callback) {
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    flushed_batchers_.insert(batcher);
+  }
+  batcher->set_allow_local_calls_in_curr_thread(allow_local_calls_in_curr_thread_);
+  batcher->FlushAsync(std::move(callback));
+}
+
+internal::BatcherPtr YBSession::TakeBatcherIfNoFlushesInFlight() {
+  std::lock_guard<std::mutex> lock(batcher_mutex_);
+  if (!batcher_ || auto_flushes_in_flight_ != 0 || !auto_flush_status_.ok()) {
+    return nullptr;
+  }
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    if (!flushed_batchers_.empty()) {
+      return nullptr;
+    }
+  }
+  return TakeBatcherUnlocked();
+}
+
+void YBSession::FlushDetachedBatcher(const internal::BatcherPtr& batcher,
+                                     StatusFunctor callback) {
+  FlushBatcher(batcher, std::move(callback));
+}
+
+internal::BatcherPtr YBSession::TakeBatcherUnlocked() {
+  internal::BatcherPtr result;
+  result.swap(batcher_);
+  buffered_bytes_ = 0;
+  ++batch_id_;
+  return result;
+}
+
+internal::BatcherPtr YBSession::OperationAddedUnlocked(const YBOperation& op) {
+  if (auto_flush_max_batch_bytes_ == 0 && !auto_flush_max_latency_.Initialized()) {
+    return nullptr;
+  }
+
+  const bool first_operation = buffered_bytes_ == 0;
+  buffered_bytes_ += std::max<size_t>(op.space_used_by_request(), 1);
+  if (auto_flush_max_batch_bytes_ != 0 && buffered_bytes_ >= auto_flush_max_batch_bytes_) {
+    ++auto_flushes_in_flight_;
+    return TakeBatcherUnlocked();
+  }
+
+  if (first_operation && auto_flush_max_latency_.Initialized()) {
+    std::weak_ptr<YBSession> weak_session = shared_from_this();
+    auto batch_id = batch_id_;
+    client_->messenger()->scheduler().Schedule(
+        [weak_session, batch_id](const Status& status) {
+          if (!status.ok()) {
+            return;
+          }
+          auto session = weak_session.lock();
+          if (session) {
+            session->AutoFlushTimerFired(batch_id);
+          }
+        },
+        auto_flush_max_latency_.ToSteadyDuration());
+  }
+
+  return nullptr;
+}
+
+void YBSession::AutoFlushTimerFired(uint64_t batch_id) {
+  internal::BatcherPtr batcher;
+  {
+    std::lock_guard<std::mutex> lock(batcher_mutex_);
+    if (batch_id != batch_id_ || !batcher_) {
+      // This batch was already flushed.
+      return;
+    }
+    ++auto_flushes_in_flight_;
+    batcher = TakeBatcherUnlocked();
+  }
+  AutoFlush(batcher);
+}
+
+void YBSession::AutoFlush(const internal::BatcherPtr& batcher) {
+  if (!batcher) {
+    return;
+  }
+  std::weak_ptr<YBSession> weak_session = shared_from_this();
+  FlushBatcher(batcher, [weak_session](const Status& status) {
+    auto session = weak_session.lock();
+    if (session) {
+      session->AutoFlushFinished(status);
+    }
+  });
+}
+
+void YBSession::AutoFlushFinished(const Status& status) {
+  std::vector<StatusFunctor> waiters;
+  Status result;
+  {
+    std::lock_guard<std::mutex> lock(batcher_mutex_);
+    if (!status.ok() && auto_flush_status_.ok()) {
+      auto_flush_status_ = status;
+    }
+    if (--auto_flushes_in_flight_ == 0 && !auto_flush_waiters_.empty()) {
+      waiters.swap(auto_flush_waiters_);
+      result = std::move(auto_flush_status_);
+      auto_flush_status_ = Status::OK();
+    }
+  }
+  for (const auto& waiter : waiters) {
+    waiter(result);
+  }
+}
+
 std::future<Status> YBSession::FlushFuture() {
   return MakeFuture<Status>([this](auto callback) { this->FlushAsync(std::move(callback)); });
 }
@@ -187,16 +365,23 @@ internal::Batcher& YBSession::Batcher() {
       batcher_->SetTimeout(timeout_);
     }
     batcher_->SetMemoryLimitScore(memory_limit_score_);
+    batcher_->SetWriteRpcWindow(write_rpc_window_);
   }
   return *batcher_;
 }
 
 Status YBSession::Apply(YBOperationPtr yb_op) {
-  Status s = Batcher().Add(yb_op);
-  if (!PREDICT_FALSE(s.ok())) {
-    error_collector_->AddError(yb_op, s);
-    return s;
+  internal::BatcherPtr full_batcher;
+  {
+    std::lock_guard<std::mutex> lock(batcher_mutex_);
+    Status s = Batcher().Add(yb_op);
+    if (!PREDICT_FALSE(s.ok())) {
+      error_collector_->AddError(yb_op, s);
+      return s;
+    }
+    full_batcher = OperationAddedUnlocked(*yb_op);
   }
+  AutoFlush(full_batcher);
 
   return Status::OK();
 }
@@ -208,13 +393,8 @@ Status YBSession::ApplyAndFlush(YBOperationPtr yb_op) {
 }
 
 Status YBSession::Apply(const std::vector<YBOperationPtr>& ops) {
-  auto& batcher = Batcher();
   for (const auto& op : ops) {
-    Status s = batcher.Add(op);
-    if (!PREDICT_FALSE(s.ok())) {
-      error_collector_->AddError(op, s);
-      return s;
-    }
+    RETURN_NOT_OK(Apply(op));
   }
   return Status::OK();
 }
@@ -236,12 +416,16 @@ Status YBSession::ApplyAndFlush(
 }
 
 int YBSession::CountBufferedOperations() const {
+  std::lock_guard<std::mutex> lock(batcher_mutex_);
   return batcher_ ? batcher_->CountBufferedOperations() : 0;
 }
 
 bool YBSession::HasPendingOperations() const {
-  if (batcher_ && batcher_->HasPendingOperations()) {
-    return true;
+  {
+    std::lock_guard<std::mutex> lock(batcher_mutex_);
+    if (batcher_ && batcher_->HasPendingOperations()) {
+      return true;
+    }
   }
   std::lock_guard<simple_spinlock> l(lock_);
   for (const auto& b : flushed_batchers_) {
@@ -261,6 +445,7 @@ CollectedErrors YBSession::GetPendingErrors() {
 }
 
 void YBSession::SetForceConsistentRead(ForceConsistentRead value) {
+  std::lock_guard<std::mutex> lock(batcher_mutex_);
   force_consistent_read_ = value;
   if (batcher_) {
     batcher_->SetForceConsistentRead(value);
@@ -14,7 +14,9 @@
 #ifndef YB_CLIENT_SESSION_H
 #define YB_CLIENT_SESSION_H
 
+#include <mutex>
 #include <unordered_set>
+#include <vector>
 
 #include "yb/client/client_fwd.h"
 
@@ -109,6 +111,20 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
   // Set the timeout for writes made in this session.
   void SetTimeout(MonoDelta timeout);
 
+  // Enables auto flush mode. In this mode buffered operations are flushed in background when
+  // max_latency passed since the first of them was applied, or when their total size reaches
+  // max_batch_bytes. Operations flushed this way are sent concurrently with operations flushed
+  // earlier, so order of operations from different batches is not guaranteed.
+  // Errors are reported to the error collector, and Flush waits for all operations applied
+  // before it, returning first error of automatically flushed batches.
+  // Uninitialized max_latency and zero max_batch_bytes disable corresponding trigger.
+  void SetAutoFlush(MonoDelta max_latency, size_t max_batch_bytes);
+
+  // Limits number of write RPCs of this session that are concurrently in flight to the same
+  // tablet, other writes to this tablet are queued until one of them completes. Writes to other
+  // tablets are not affected by a slow tablet. Zero means no limit.
+  void SetMaxInFlightWritesPerTablet(size_t value);
+
   CHECKED_STATUS ReadSync(std::shared_ptr<YBOperation> yb_op);
 
   void ReadAsync(std::shared_ptr<YBOperation> yb_op, StatusFunctor callback);
@@ -233,6 +249,14 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
   // Called by Batcher when a flush has finished.
   void FlushFinished(internal::BatcherPtr b);
 
+  // Detaches buffered operations as a separate batch, when no other batch of this session was
+  // flushed and is still in flight. Returns nullptr otherwise, or when nothing is buffered.
+  // Used by YBTransaction::FlushAndCommit to identify the last batch of a transaction.
+  internal::BatcherPtr TakeBatcherIfNoFlushesInFlight();
+
+  // Flushes batcher detached by TakeBatcherIfNoFlushesInFlight.
+  void FlushDetachedBatcher(const internal::BatcherPtr& batcher, StatusFunctor callback);
+
   ConsistentReadPoint* read_point();
 
   void SetMemoryLimitScore(double score);
@@ -241,8 +265,23 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
   friend class YBClient;
   friend class internal::Batcher;
 
+  // Returns current batcher, creating it if necessary. Requires batcher_mutex_.
   internal::Batcher& Batcher();
 
+  // Detaches current batcher, so next operation will be added to new one.
+  internal::BatcherPtr TakeBatcherUnlocked();
+
+  void FlushBatcher(const internal::BatcherPtr& batcher, StatusFunctor callback);
+
+  // Updates auto flush state after operation was added to current batcher.
+  // Returns batcher that should be flushed, if batch size limit was reached.
+  internal::BatcherPtr OperationAddedUnlocked(const YBOperation& op);
+
+  // Flushes batcher, that was taken because of auto flush.
+  void AutoFlush(const internal::BatcherPtr& batcher);
+  void AutoFlushFinished(const Status& status);
+  void AutoFlushTimerFired(uint64_t batch_id);
+
   // The client that this session is associated with.
   client::YBClient* const client_;
 
@@ -254,6 +293,10 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
   // Lock protecting flushed_batchers_.
   mutable simple_spinlock lock_;
 
+  // Protects batcher_ and auto flush state, since batcher could be flushed in background in
+  // auto flush mode. Acquired before lock_.
+  mutable std::mutex batcher_mutex_;
+
   // Buffer for errors.
   scoped_refptr<internal::ErrorCollector> error_collector_;
 
@@ -277,6 +320,27 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   double memory_limit_score_ = 0.0;
 
+  internal::WriteRpcWindowPtr write_rpc_window_;
+
+  // Auto flush mode parameters, see SetAutoFlush.
+  MonoDelta auto_flush_max_latency_;
+  size_t auto_flush_max_batch_bytes_ = 0;
+
+  // Size of operations in batcher_, tracked in auto flush mode.
+  size_t buffered_bytes_ = 0;
+
+  // Incremented each time batcher_ is detached, used to ignore outdated flush timers.
+  uint64_t batch_id_ = 0;
+
+  // Number of automatically flushed batchers that did not complete yet.
+  size_t auto_flushes_in_flight_ = 0;
+
+  // First error of completed auto flushes, reported by the next Flush.
+  Status auto_flush_status_;
+
+  // Callbacks of flushes waiting for completion of automatically flushed batchers.
+  std::vector<StatusFunctor> auto_flush_waiters_;
+
   DISALLOW_COPY_AND_ASSIGN(YBSession);
 };
 
@@ -21,6 +21,12 @@
 #include "yb/master/master.proxy.h"
 
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(client_prefetch_table_locations, true,
+            "Whether locations of all tablets fetched while opening a table should be stored in "
+            "the meta cache.");
+TAG_FLAG(client_prefetch_table_locations, advanced);
 
 namespace yb {
 namespace client {
@@ -233,6 +239,12 @@ Status YBTable::Open() {
         partitions_.push_back(tablet_location.partition().partition_key_start());
       }
       std::sort(partitions_.begin(), partitions_.end());
+      if (FLAGS_client_prefetch_table_locations) {
+        // We already have locations of all tablets, so populate meta cache with them, instead of
+        // looking up each tablet separately when the first operation for it is sent.
+        client_->data_->meta_cache_->ProcessTabletLocations(
+            resp.tablet_locations(), nullptr /* partition_group_start */);
+      }
       break;
     }
 
@@ -22,6 +22,7 @@
 
 #include "yb/tserver/tserver_service.proxy.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/random_util.h"
 
 DEFINE_test_flag(bool, assert_local_op, false,
                  "When set, we crash if we received an operation that cannot be served locally.");
@@ -63,6 +64,23 @@ void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
+RemoteTabletServer* TabletInvoker::SelectHedgeTabletServer() {
+  std::vector<RemoteTabletServer*> candidates;
+  for (auto* ts : tablet_->GetRemoteTabletServers()) {
+    if (ts != current_ts_ && !ts->IsLocal()) {
+      candidates.push_back(ts);
+    }
+  }
+  if (candidates.empty()) {
+    return nullptr;
+  }
+  auto* result = RandomElement(candidates);
+  if (!result->InitProxy(client_).ok()) {
+    return nullptr;
+  }
+  return result;
+}
+
 void TabletInvoker::SelectLocalTabletServer() {
   current_ts_ = client_->data_->meta_cache_->local_tserver();
   VLOG(1) << "Using local tserver: " << current_ts_->ToString();
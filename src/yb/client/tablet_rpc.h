@@ -75,6 +75,10 @@ class TabletInvoker {
   const RemoteTabletServer& current_ts() { return *current_ts_; }
   bool local_tserver_only() const { return local_tserver_only_; }
 
+  // Selects a remote replica other than the current one, to send a hedged consistent prefix read
+  // to. Returns nullptr if there is no such replica.
+  RemoteTabletServer* SelectHedgeTabletServer();
+
  private:
   friend class TabletRpcTest;
   FRIEND_TEST(TabletRpcTest, TabletInvokerSelectTabletServerRace);
@@ -21,6 +21,8 @@
 #include "yb/client/client.h"
 #include "yb/client/in_flight_op.h"
 #include "yb/client/meta_cache.h"
+#include "yb/client/session.h"
+#include "yb/client/table.h"
 #include "yb/client/tablet_rpc.h"
 #include "yb/client/transaction_manager.h"
 #include "yb/client/transaction_rpc.h"
@@ -29,6 +31,7 @@
 #include "yb/common/transaction.h"
 
 #include "yb/rpc/messenger.h"
+#include "yb/rpc/outbound_call.h"
 #include "yb/rpc/rpc.h"
 #include "yb/rpc/scheduler.h"
 
@@ -44,6 +47,20 @@ DEFINE_uint64(transaction_heartbeat_usec, 500000, "Interval of transaction heart
 DEFINE_bool(transaction_disable_heartbeat_in_tests, false, "Disable heartbeat during test.");
 DEFINE_bool(transaction_disable_proactive_cleanup_in_tests, false,
             "Disable cleanup of intents in abort path.");
+DEFINE_bool(enable_one_phase_commit, true,
+            "Commit transactions whose writes go to a single tablet in one round trip, "
+            "without status tablet and intents.");
+TAG_FLAG(enable_one_phase_commit, runtime);
+DEFINE_bool(enable_read_only_transactions_without_status_tablet, true,
+            "Execute reads of snapshot isolation transactions that did not write yet at the "
+            "transaction read time, without picking status tablet. So read only transactions "
+            "do not write to status tablet and do not send heartbeats.");
+TAG_FLAG(enable_read_only_transactions_without_status_tablet, runtime);
+DEFINE_bool(enable_transaction_heartbeat_batching, true,
+            "Send heartbeats of running transactions in batches, one RPC per status tablet "
+            "for all transactions of the client. Client falls back to per transaction heartbeats "
+            "when a tablet server does not support batches.");
+TAG_FLAG(enable_transaction_heartbeat_batching, advanced);
 DECLARE_uint64(max_clock_skew_usec);
 
 namespace yb {
@@ -52,7 +69,9 @@ namespace client {
 namespace {
 
 YB_STRONGLY_TYPED_BOOL(Child);
-YB_DEFINE_ENUM(TransactionState, (kRunning)(kAborted)(kCommitted));
+// kCommitUnknown - one phase commit write failed in a way that does not tell whether it
+// was applied.
+YB_DEFINE_ENUM(TransactionState, (kRunning)(kAborted)(kCommitted)(kCommitUnknown));
 
 } // namespace
 
@@ -103,6 +122,7 @@ class YBTransaction::Impl final {
   }
 
   ~Impl() {
+    UnregisterHeartbeat();
     manager_->rpcs().Abort({&heartbeat_handle_, &commit_handle_, &abort_handle_});
     LOG_IF_WITH_PREFIX(DFATAL, !waiters_.empty()) << "Non empty waiters";
   }
@@ -165,6 +185,13 @@ class YBTransaction::Impl final {
         other->metadata_.DEPRECATED_start_time = other->read_point_.Now();
       }
       state_.store(TransactionState::kAborted, std::memory_order_release);
+      if (!ready_) {
+        // Read only transaction is not known to status tablet, so there is nothing to abort.
+        if (requested_status_tablet_.load(std::memory_order_acquire)) {
+          waiters_.emplace_back(std::bind(&Impl::DoAbort, this, _1, transaction));
+        }
+        return Status::OK();
+      }
     }
     DoAbort(Status::OK(), transaction);
 
@@ -175,12 +202,40 @@ class YBTransaction::Impl final {
                ForceConsistentRead force_consistent_read,
                Waiter waiter,
                TransactionMetadata* metadata,
-               bool* may_have_metadata) {
+               bool* may_have_metadata,
+               const internal::Batcher* batcher) {
     VLOG_WITH_PREFIX(2) << "Prepare";
 
     bool has_tablets_without_metadata = false;
     {
       std::unique_lock<std::mutex> lock(mutex_);
+      if (one_phase_commit_batcher_ != nullptr && one_phase_commit_batcher_ == batcher) {
+        one_phase_commit_batcher_ = nullptr;
+        if (CanCommitInOnePhase(ops)) {
+          // Metadata is left empty, so ops are sent as regular writes and tablet applies
+          // the whole batch atomically.
+          one_phase_commit_ = true;
+          VLOG_WITH_PREFIX(2) << "Prepare, one phase commit of " << ops.size() << " ops";
+          return true;
+        }
+      } else if (one_phase_commit_) {
+        // Transaction is committed by its last batch, so no other batch could join it.
+        lock.unlock();
+        auto status = STATUS(IllegalState, "Transaction is committed in one phase");
+        VLOG_WITH_PREFIX(2) << "Prepare, rejected: " << status;
+        if (waiter) {
+          waiter(status);
+        }
+        return false;
+      }
+      if (!ready_ && CanReadWithoutStatusTablet(ops)) {
+        // Transaction did not write yet, so read is executed as non transactional consistent read
+        // at the transaction read time.
+        SetReadTimeIfNeeded(true);
+        VLOG_WITH_PREFIX(2) << "Prepare, read without status tablet: "
+                            << read_point_.GetReadTime();
+        return true;
+      }
       if (!ready_) {
         if (waiter) {
           waiters_.push_back(std::move(waiter));
@@ -260,6 +315,16 @@ class YBTransaction::Impl final {
         << "Flushed: " << yb::ToString(ops) << ", used_read_time: " << used_read_time
         << ", status: " << status;
 
+    if (one_phase_commit_.load(std::memory_order_acquire)) {
+      // Ops were written as regular writes, so there are no involved tablets to track.
+      // Status is handled by FlushAndCommit.
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!status.ok() && one_phase_commit_status_.ok()) {
+        one_phase_commit_status_ = status;
+      }
+      return;
+    }
+
     if (status.ok()) {
       std::lock_guard<std::mutex> lock(mutex_);
       if (used_read_time && metadata_.isolation == IsolationLevel::SNAPSHOT_ISOLATION) {
@@ -306,6 +371,13 @@ class YBTransaction::Impl final {
         return;
       }
       state_.store(TransactionState::kCommitted, std::memory_order_release);
+      if (!ready_ && !requested_status_tablet_.load(std::memory_order_acquire)) {
+        // Transaction did not write anything, so there is nothing to commit.
+        VLOG_WITH_PREFIX(2) << "Commit of read only transaction";
+        lock.unlock();
+        callback(Status::OK());
+        return;
+      }
       commit_callback_ = std::move(callback);
       if (!ready_) {
         waiters_.emplace_back(std::bind(&Impl::DoCommit, this, _1, transaction));
@@ -317,13 +389,56 @@ class YBTransaction::Impl final {
     DoCommit(Status::OK(), transaction);
   }
 
+  void FlushAndCommit(YBSession* session, CommitCallback callback) {
+    auto transaction = transaction_->shared_from_this();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto status = CheckRunning(&lock);
+      if (!status.ok()) {
+        callback(status);
+        return;
+      }
+      if (child_) {
+        callback(STATUS(IllegalState, "Commit of child transaction is not allowed"));
+        return;
+      }
+    }
+
+    // Only the batch flushed here could be committed in one phase, and only when no other batch
+    // of this session is in flight. Batches flushed earlier are detected by Prepare.
+    internal::BatcherPtr batcher;
+    if (FLAGS_enable_one_phase_commit) {
+      batcher = session->TakeBatcherIfNoFlushesInFlight();
+    }
+    auto flushed = [this, transaction, callback](const Status& status) {
+      if (!one_phase_commit_.load(std::memory_order_acquire)) {
+        if (!status.ok()) {
+          callback(status);
+          return;
+        }
+        Commit(callback);
+        return;
+      }
+      callback(OnePhaseCommitDone(status));
+    };
+    if (!batcher) {
+      session->FlushAsync(flushed);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      one_phase_commit_batcher_ = batcher.get();
+    }
+    session->FlushDetachedBatcher(batcher, flushed);
+  }
+
   void Abort() {
     auto transaction = transaction_->shared_from_this();
     {
       std::unique_lock<std::mutex> lock(mutex_);
       auto state = state_.load(std::memory_order_acquire);
       if (state != TransactionState::kRunning) {
-        LOG_IF(DFATAL, state != TransactionState::kAborted) << "Abort of committed transaction";
+        LOG_IF(DFATAL, state == TransactionState::kCommitted) << "Abort of committed transaction";
         return;
       }
       if (child_) {
@@ -331,6 +446,11 @@ class YBTransaction::Impl final {
         return;
       }
       state_.store(TransactionState::kAborted, std::memory_order_release);
+      if (!ready_ && !requested_status_tablet_.load(std::memory_order_acquire)) {
+        // Transaction did not write anything, so status tablet does not know about it.
+        VLOG_WITH_PREFIX(2) << "Abort of read only transaction";
+        return;
+      }
       if (!ready_) {
         waiters_.emplace_back(std::bind(&Impl::DoAbort, this, _1, transaction));
         lock.unlock();
@@ -475,9 +595,63 @@ class YBTransaction::Impl final {
     return Status::OK();
   }
 
+  // Tablet applied the whole batch as a single write, so flush status is the status of the whole
+  // transaction. Except when write did not complete in time, so it is unknown whether it was
+  // applied.
+  Status OnePhaseCommitDone(const Status& flush_status) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    one_phase_commit_batcher_ = nullptr;
+    if (flush_status.ok()) {
+      state_.store(TransactionState::kCommitted, std::memory_order_release);
+      VLOG_WITH_PREFIX(1) << "One phase commit done";
+      return Status::OK();
+    }
+    const auto& write_status =
+        one_phase_commit_status_.ok() ? flush_status : one_phase_commit_status_;
+    VLOG_WITH_PREFIX(1) << "One phase commit failed: " << write_status;
+    if (write_status.IsTimedOut() || write_status.IsNetworkError() ||
+        write_status.IsAborted()) {
+      state_.store(TransactionState::kCommitUnknown, std::memory_order_release);
+      return STATUS_FORMAT(
+          TimedOut, "Outcome of one phase commit is unknown: $0", write_status);
+    }
+    state_.store(TransactionState::kAborted, std::memory_order_release);
+    return flush_status;
+  }
+
+  // Transaction could be committed in one phase, when it is the first batch of this transaction
+  // and the whole batch is sent to a single tablet in one RPC.
+  // Such batch is written as regular write, so it is visible atomically after it is applied.
+  // Indexed tables are excluded, because index updates are sent to other tablets.
+  bool CanCommitInOnePhase(const std::unordered_set<internal::InFlightOpPtr>& ops) {
+    if (child_ || ops.empty() || !tablets_.empty() ||
+        requested_status_tablet_.load(std::memory_order_acquire) || read_point_.GetReadTime()) {
+      return false;
+    }
+    internal::RemoteTablet* tablet = nullptr;
+    size_t num_sidecars = 0;
+    for (const auto& op : ops) {
+      if (op->yb_op->read_only() || !op->yb_op->table()->index_map().empty()) {
+        return false;
+      }
+      if (tablet == nullptr) {
+        tablet = op->tablet.get();
+      } else if (tablet != op->tablet.get()) {
+        return false;
+      }
+      if (op->yb_op->returns_sidecar()) {
+        ++num_sidecars;
+      }
+    }
+    // Batcher splits batch into several RPCs when there are too many sidecars.
+    return num_sidecars < rpc::CallResponse::kMaxSidecarSlices;
+  }
+
   void DoCommit(const Status& status, const YBTransactionPtr& transaction) {
     VLOG_WITH_PREFIX(1) << Format("Commit, tablets: $0, status: $1", tablets_, status);
 
+    UnregisterHeartbeat();
+
     if (!status.ok()) {
       commit_callback_(status);
       return;
@@ -514,6 +688,8 @@ class YBTransaction::Impl final {
   void DoAbort(const Status& status, const YBTransactionPtr& transaction) {
     VLOG_WITH_PREFIX(1) << Format("Abort, status: $1", status);
 
+    UnregisterHeartbeat();
+
     if (!status.ok()) {
       // We already stopped to send heartbeats, so transaction would be aborted anyway.
       LOG(WARNING) << "Failed to abort transaction: " << status;
@@ -604,6 +780,24 @@ class YBTransaction::Impl final {
     }
   }
 
+  // Reads of snapshot isolation transaction could be executed without status tablet, until
+  // transaction writes something. Since there are no intents of this transaction, such reads
+  // just use consistent read time of the transaction.
+  // Serializable isolation reads write read intents, so require status tablet.
+  bool CanReadWithoutStatusTablet(const std::unordered_set<internal::InFlightOpPtr>& ops) {
+    if (!FLAGS_enable_read_only_transactions_without_status_tablet || child_ || ops.empty() ||
+        metadata_.isolation != IsolationLevel::SNAPSHOT_ISOLATION ||
+        requested_status_tablet_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    for (const auto& op : ops) {
+      if (!op->yb_op->read_only()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void ProcessResponse(const YBTransactionPtr& transaction) {
     VLOG_WITH_PREFIX(3) << "Cleanup intents for Abort done";
   }
@@ -660,6 +854,8 @@ class YBTransaction::Impl final {
     VLOG_WITH_PREFIX(1) << "Lookup tablet done: " << yb::ToString(result);
 
     if (!result.ok()) {
+      // Picked tablet could belong to a dropped transaction status table.
+      manager_->InvalidateStatusTablets();
       NotifyWaiters(result.status());
       return;
     }
@@ -724,6 +920,30 @@ class YBTransaction::Impl final {
     manager_->rpcs().Unregister(&heartbeat_handle_);
 
     if (status.ok()) {
+      const bool batch_heartbeats =
+          transaction_status == TransactionStatus::CREATED &&
+          FLAGS_enable_transaction_heartbeat_batching && manager_->HeartbeatBatchingSupported();
+      if (batch_heartbeats) {
+        // Registered before notifying waiters, so commit or abort invoked by them unregisters it.
+        std::weak_ptr<YBTransaction> weak_transaction(transaction);
+        heartbeat_registered_.store(true, std::memory_order_release);
+        manager_->RegisterHeartbeat(
+            metadata_.transaction_id, status_tablet_,
+            [this, weak_transaction](const Status& status) {
+              auto transaction = weak_transaction.lock();
+              if (!transaction) {
+                return;
+              }
+              heartbeat_registered_.store(false, std::memory_order_release);
+              if (status.IsNotSupported()) {
+                // Status tablet runs an older version, so send heartbeats one by one.
+                SendHeartbeat(TransactionStatus::PENDING, metadata_.transaction_id, transaction);
+                return;
+              }
+              LOG_WITH_PREFIX(WARNING) << "Heartbeat failed: " << status;
+              HeartbeatFailed(status, transaction);
+            });
+      }
       if (transaction_status == TransactionStatus::CREATED) {
         std::vector<Waiter> waiters;
         {
@@ -736,6 +956,9 @@ class YBTransaction::Impl final {
         for (const auto& waiter : waiters) {
           waiter(Status::OK());
         }
+        if (batch_heartbeats) {
+          return;
+        }
       }
       std::weak_ptr<YBTransaction> weak_transaction(transaction);
       manager_->client()->messenger()->scheduler().Schedule(
@@ -746,12 +969,7 @@ class YBTransaction::Impl final {
     } else {
       LOG_WITH_PREFIX(WARNING) << "Send heartbeat failed: " << status;
       if (status.IsExpired() || status.IsAborted()) {
-        SetError(status);
-        // If state is aborted, then we already requested this cleanup.
-        // If state is committed, then we should not cleanup.
-        if (state_.load(std::memory_order_acquire) == TransactionState::kRunning) {
-          DoAbortCleanup(transaction);
-        }
+        HeartbeatFailed(status, transaction);
         return;
       }
       // Other errors could have different causes, but we should just retry sending heartbeat
@@ -760,6 +978,22 @@ class YBTransaction::Impl final {
     }
   }
 
+  // Transaction expired or was aborted by status tablet.
+  void HeartbeatFailed(const Status& status, const YBTransactionPtr& transaction) {
+    SetError(status);
+    // If state is aborted, then we already requested this cleanup.
+    // If state is committed, then we should not cleanup.
+    if (state_.load(std::memory_order_acquire) == TransactionState::kRunning) {
+      DoAbortCleanup(transaction);
+    }
+  }
+
+  void UnregisterHeartbeat() {
+    if (heartbeat_registered_.exchange(false, std::memory_order_acq_rel)) {
+      manager_->UnregisterHeartbeat(metadata_.transaction_id, metadata_.status_tablet);
+    }
+  }
+
   void SetError(const Status& status, std::lock_guard<std::mutex>* lock = nullptr) {
     VLOG_WITH_PREFIX(1) << "Failed: " << status;
     if (!lock) {
@@ -809,9 +1043,18 @@ class YBTransaction::Impl final {
   const bool child_;
   bool child_had_read_time_ = false;
   bool ready_ = false;
+  // Batch flushed by FlushAndCommit, that could commit this transaction in one phase.
+  // Used only for identity, never dereferenced.
+  const internal::Batcher* one_phase_commit_batcher_ = nullptr;
+  // Transaction was committed together with its only batch, without status tablet.
+  std::atomic<bool> one_phase_commit_{false};
+  // First error of one phase commit write RPC.
+  Status one_phase_commit_status_;
   CommitCallback commit_callback_;
   Status error_;
   rpc::Rpcs::Handle heartbeat_handle_;
+  // Transaction is registered for batched heartbeats in transaction manager.
+  std::atomic<bool> heartbeat_registered_{false};
   rpc::Rpcs::Handle commit_handle_;
   rpc::Rpcs::Handle abort_handle_;
 
@@ -885,9 +1128,10 @@ bool YBTransaction::Prepare(const std::unordered_set<internal::InFlightOpPtr>& o
                             ForceConsistentRead force_consistent_read,
                             Waiter waiter,
                             TransactionMetadata* metadata,
-                            bool* may_have_metadata) {
+                            bool* may_have_metadata,
+                            const internal::Batcher* batcher) {
   return impl_->Prepare(
-      ops, force_consistent_read, std::move(waiter), metadata, may_have_metadata);
+      ops, force_consistent_read, std::move(waiter), metadata, may_have_metadata, batcher);
 }
 
 void YBTransaction::Flushed(
@@ -899,6 +1143,16 @@ void YBTransaction::Commit(CommitCallback callback) {
   impl_->Commit(std::move(callback));
 }
 
+void YBTransaction::FlushAndCommit(YBSession* session, CommitCallback callback) {
+  impl_->FlushAndCommit(session, std::move(callback));
+}
+
+std::future<Status> YBTransaction::FlushAndCommitFuture(YBSession* session) {
+  return MakeFuture<Status>([this, session](auto callback) {
+    impl_->FlushAndCommit(session, std::move(callback));
+  });
+}
+
 const TransactionId& YBTransaction::id() const {
   return impl_->id();
 }
@@ -78,11 +78,13 @@ class YBTransaction : public std::enable_shared_from_this<YBTransaction> {
   // This function is used to init metadata of Write/Read request.
   // If we don't have enough information, then the function returns false and stores
   // the waiter, which will be invoked when we obtain such information.
+  // 'batcher' identifies the batch being prepared, see FlushAndCommit.
   bool Prepare(const std::unordered_set<internal::InFlightOpPtr>& ops,
                ForceConsistentRead force_consistent_read,
                Waiter waiter,
                TransactionMetadata* metadata,
-               bool* may_have_metadata);
+               bool* may_have_metadata,
+               const internal::Batcher* batcher = nullptr);
 
   // Notifies transaction that specified ops were flushed with some status.
   void Flushed(
@@ -94,6 +96,18 @@ class YBTransaction : public std::enable_shared_from_this<YBTransaction> {
   // Utility function for Commit.
   std::future<Status> CommitFuture();
 
+  // Flushes session and commits this transaction.
+  // When the flushed batch is the only batch of this transaction, i.e. no other batch was flushed
+  // before or is in flight, and it goes to a single tablet, the batch is applied by that tablet
+  // in one round trip, without status tablet and intents.
+  // Otherwise it is equivalent to FlushAsync followed by Commit.
+  // When the one phase write times out its outcome is unknown, then TimedOut is reported and
+  // the transaction could not be used anymore.
+  void FlushAndCommit(YBSession* session, CommitCallback callback);
+
+  // Utility function for FlushAndCommit.
+  std::future<Status> FlushAndCommitFuture(YBSession* session);
+
   // Aborts this transaction.
   void Abort();
 
@@ -15,19 +15,51 @@
 
 #include "yb/client/transaction_manager.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/gutil/casts.h"
+
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc.h"
+#include "yb/rpc/scheduler.h"
 #include "yb/rpc/thread_pool.h"
 #include "yb/rpc/tasks_pool.h"
 
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/locks.h"
+#include "yb/util/monotime.h"
 #include "yb/util/random_util.h"
 #include "yb/util/thread_restrictions.h"
 
 #include "yb/client/client.h"
+#include "yb/client/meta_cache.h"
+#include "yb/client/transaction_rpc.h"
 
 #include "yb/common/transaction.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/master/master_defaults.h"
 
+DEFINE_bool(use_local_transaction_tables, true,
+            "Pick status tablets of transactions from transaction status table of the client's "
+            "region, when such table exists.");
+TAG_FLAG(use_local_transaction_tables, advanced);
+
+DEFINE_int32(transaction_tables_refresh_interval_ms, 60000,
+             "Interval after which status tablets picked for transactions are resolved again, "
+             "so the client starts using transaction status table of its region once it is "
+             "created, or stops using it after it was dropped.");
+TAG_FLAG(transaction_tables_refresh_interval_ms, advanced);
+TAG_FLAG(transaction_tables_refresh_interval_ms, runtime);
+
+DECLARE_uint64(transaction_heartbeat_usec);
+DECLARE_bool(transaction_disable_heartbeat_in_tests);
+
 namespace yb {
 namespace client {
 
@@ -35,10 +67,7 @@ namespace {
 
 const YBTableName kTransactionTableName(master::kSystemNamespaceName, kTransactionsTableName);
 
-// Exists - table exists.
-// Updating - intermediate state, we are currently updating local cache of tablets.
-// Resolved - final state, when all tablets are resolved and written to cache.
-YB_DEFINE_ENUM(TransactionTableStatus, (kExists)(kUpdating)(kResolved));
+typedef std::shared_ptr<const std::vector<TabletId>> StatusTabletsPtr;
 
 void InvokeCallback(const LocalTabletFilter& filter, const std::vector<TabletId>& tablets,
                     const PickStatusTabletCallback& callback) {
@@ -58,10 +87,57 @@ void InvokeCallback(const LocalTabletFilter& filter, const std::vector<TabletId>
   callback(RandomElement(tablets));
 }
 
-struct TransactionTableState {
-  LocalTabletFilter local_tablet_filter;
-  std::atomic<TransactionTableStatus> status{TransactionTableStatus::kExists};
-  std::vector<TabletId> tablets;
+// Cache of the status tablets, that transactions pick from.
+class TransactionTableState {
+ public:
+  explicit TransactionTableState(LocalTabletFilter local_tablet_filter)
+      : local_tablet_filter_(std::move(local_tablet_filter)) {}
+
+  const LocalTabletFilter& local_tablet_filter() const {
+    return local_tablet_filter_;
+  }
+
+  // Returns cached tablets, or nullptr when the caller should resolve them.
+  // After refresh interval passed only one caller is asked to resolve tablets again, others keep
+  // using the cached tablets meanwhile.
+  StatusTabletsPtr GetTablets() {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    if (tablets_ && !refreshing_ && CoarseMonoClock::Now() >= refresh_time_) {
+      refreshing_ = true;
+      return nullptr;
+    }
+    return tablets_;
+  }
+
+  StatusTabletsPtr SetTablets(std::vector<TabletId> tablets) {
+    auto result = std::make_shared<const std::vector<TabletId>>(std::move(tablets));
+    auto refresh_time = CoarseMonoClock::Now() +
+                        std::chrono::milliseconds(FLAGS_transaction_tables_refresh_interval_ms);
+    std::lock_guard<simple_spinlock> lock(lock_);
+    tablets_ = result;
+    refresh_time_ = refresh_time;
+    refreshing_ = false;
+    return result;
+  }
+
+  void ResolveFailed() {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    refreshing_ = false;
+  }
+
+  // Makes the next caller of GetTablets resolve tablets again.
+  void Invalidate() {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    refresh_time_ = CoarseTimePoint();
+  }
+
+ private:
+  const LocalTabletFilter local_tablet_filter_;
+
+  simple_spinlock lock_;
+  StatusTabletsPtr tablets_;
+  CoarseTimePoint refresh_time_;
+  bool refreshing_ = false;
 };
 
 // Picks status tablet for transaction.
@@ -77,27 +153,25 @@ class PickStatusTabletTask {
   void Run() {
     // TODO(dtxn) async
     std::vector<TabletId> tablets;
-    auto status = client_->GetTablets(kTransactionTableName, 0, &tablets, /* ranges */ nullptr);
-    if (!status.ok()) {
-      callback_(status);
+    auto table_name = GetStatusTablets(&tablets);
+    if (!table_name.ok()) {
+      table_state_->ResolveFailed();
+      callback_(table_name.status());
       return;
     }
     if (tablets.empty()) {
-      callback_(STATUS_FORMAT(IllegalState, "No tablets in table $0", kTransactionTableName));
+      table_state_->ResolveFailed();
+      callback_(STATUS_FORMAT(IllegalState, "No tablets in table $0", *table_name));
       return;
     }
-    auto expected = TransactionTableStatus::kExists;
-    if (table_state_->status.compare_exchange_strong(
-        expected, TransactionTableStatus::kUpdating, std::memory_order_acq_rel)) {
-      table_state_->tablets = tablets;
-      table_state_->status.store(TransactionTableStatus::kResolved, std::memory_order_release);
-    }
 
-    InvokeCallback(table_state_->local_tablet_filter, tablets, callback_);
+    auto resolved_tablets = table_state_->SetTablets(std::move(tablets));
+    InvokeCallback(table_state_->local_tablet_filter(), *resolved_tablets, callback_);
   }
 
   void Done(const Status& status) {
     if (!status.ok()) {
+      table_state_->ResolveFailed();
       callback_(status);
     }
     callback_ = PickStatusTabletCallback();
@@ -105,6 +179,26 @@ class PickStatusTabletTask {
   }
 
  private:
+  // Fills tablets of the transaction status table in the client's region, falling back to
+  // the global transaction status table when there is no such table.
+  // Returns name of the table that was used.
+  Result<YBTableName> GetStatusTablets(std::vector<TabletId>* tablets) {
+    const auto& cloud_info = client_->cloud_info();
+    if (FLAGS_use_local_transaction_tables && cloud_info.has_placement_region()) {
+      YBTableName local_table_name(
+          master::kSystemNamespaceName, LocalTransactionsTableName(cloud_info));
+      auto status = client_->GetTablets(local_table_name, 0, tablets, /* ranges */ nullptr);
+      if (status.ok() && !tablets->empty()) {
+        VLOG(1) << "Use local transaction status table " << local_table_name;
+        return local_table_name;
+      }
+      LOG_IF(WARNING, !status.ok() && !status.IsNotFound())
+          << "Failed to get tablets of " << local_table_name << ": " << status;
+      tablets->clear();
+    }
+    RETURN_NOT_OK(client_->GetTablets(kTransactionTableName, 0, tablets, /* ranges */ nullptr));
+    return kTransactionTableName;
+  }
 
   YBClient* client_;
   TransactionTableState* table_state_;
@@ -114,12 +208,13 @@ class PickStatusTabletTask {
 class InvokeCallbackTask {
  public:
   InvokeCallbackTask(TransactionTableState* table_state,
+                     StatusTabletsPtr tablets,
                      PickStatusTabletCallback callback)
-      : table_state_(table_state), callback_(std::move(callback)) {
+      : table_state_(table_state), tablets_(std::move(tablets)), callback_(std::move(callback)) {
   }
 
   void Run() {
-    InvokeCallback(table_state_->local_tablet_filter, table_state_->tablets, callback_);
+    InvokeCallback(table_state_->local_tablet_filter(), *tablets_, callback_);
   }
 
   void Done(const Status& status) {
@@ -131,6 +226,7 @@ class InvokeCallbackTask {
 
  private:
   TransactionTableState* table_state_;
+  StatusTabletsPtr tablets_;
   PickStatusTabletCallback callback_;
 };
 
@@ -145,7 +241,7 @@ class TransactionManager::Impl {
                 LocalTabletFilter local_tablet_filter)
       : client_(client),
         clock_(clock),
-        table_state_{std::move(local_tablet_filter)},
+        table_state_(std::move(local_tablet_filter)),
         thread_pool_("TransactionManager", kQueueLimit, kMaxWorkers),
         tasks_pool_(kQueueLimit),
         invoke_callback_tasks_(kQueueLimit) {
@@ -153,10 +249,12 @@ class TransactionManager::Impl {
   }
 
   void PickStatusTablet(PickStatusTabletCallback callback) {
-    if (table_state_.status.load(std::memory_order_acquire) == TransactionTableStatus::kResolved) {
+    auto tablets = table_state_.GetTablets();
+    if (tablets) {
       if (ThreadRestrictions::IsWaitAllowed()) {
-        InvokeCallback(table_state_.local_tablet_filter, table_state_.tablets, callback);
-      } else if (!invoke_callback_tasks_.Enqueue(&thread_pool_, &table_state_, callback)) {
+        InvokeCallback(table_state_.local_tablet_filter(), *tablets, callback);
+      } else if (!invoke_callback_tasks_.Enqueue(
+                     &thread_pool_, &table_state_, std::move(tablets), callback)) {
         callback(STATUS_FORMAT(ServiceUnavailable,
                               "Invoke callback queue overflow, number of tasks: $0",
                               invoke_callback_tasks_.size()));
@@ -164,10 +262,15 @@ class TransactionManager::Impl {
       return;
     }
     if (!tasks_pool_.Enqueue(&thread_pool_, client_, &table_state_, std::move(callback))) {
+      table_state_.ResolveFailed();
       callback(STATUS_FORMAT(ServiceUnavailable, "Tasks overflow, exists: $0", tasks_pool_.size()));
     }
   }
 
+  void InvalidateStatusTablets() {
+    table_state_.Invalidate();
+  }
+
   const scoped_refptr<ClockBase>& clock() const {
     return clock_;
   }
@@ -192,12 +295,199 @@ class TransactionManager::Impl {
     clock_->Update(time);
   }
 
+  bool HeartbeatBatchingSupported() const {
+    return heartbeat_batching_supported_.load(std::memory_order_acquire);
+  }
+
+  void RegisterHeartbeat(const TransactionId& id, const internal::RemoteTabletPtr& status_tablet,
+                         HeartbeatFailedCallback callback) {
+    std::unique_lock<std::mutex> lock(heartbeat_mutex_);
+    if (heartbeat_closing_) {
+      return;
+    }
+    if (!HeartbeatBatchingSupported()) {
+      lock.unlock();
+      callback(STATUS(NotSupported, "Heartbeat batching is not supported"));
+      return;
+    }
+    auto& data = heartbeat_tablets_[status_tablet->tablet_id()];
+    if (!data.tablet) {
+      data.tablet = status_tablet;
+    }
+    data.transactions[id] = std::move(callback);
+    if (heartbeat_task_id_ == rpc::kUninitializedScheduledTaskId) {
+      ScheduleHeartbeatsUnlocked();
+    }
+  }
+
+  void UnregisterHeartbeat(const TransactionId& id, const TabletId& status_tablet) {
+    HeartbeatFailedCallback callback;
+    std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+    auto it = heartbeat_tablets_.find(status_tablet);
+    if (it == heartbeat_tablets_.end()) {
+      return;
+    }
+    auto transaction_it = it->second.transactions.find(id);
+    if (transaction_it != it->second.transactions.end()) {
+      // Callback could hold the last reference to something, so it is destroyed after unlock.
+      callback = std::move(transaction_it->second);
+      it->second.transactions.erase(transaction_it);
+    }
+    if (it->second.transactions.empty() && !it->second.in_flight) {
+      heartbeat_tablets_.erase(it);
+    }
+  }
+
   void Shutdown() {
+    {
+      std::unique_lock<std::mutex> lock(heartbeat_mutex_);
+      heartbeat_closing_ = true;
+      if (heartbeat_task_id_ != rpc::kUninitializedScheduledTaskId) {
+        client_->messenger()->scheduler().Abort(heartbeat_task_id_);
+      }
+      heartbeat_cond_.wait(
+          lock, [this] { return heartbeat_task_id_ == rpc::kUninitializedScheduledTaskId; });
+    }
     rpcs_.Shutdown();
     thread_pool_.Shutdown();
   }
 
  private:
+  struct HeartbeatTabletData {
+    internal::RemoteTabletPtr tablet;
+    std::unordered_map<TransactionId, HeartbeatFailedCallback, TransactionIdHash> transactions;
+    // Whether there is heartbeat RPC in flight to this status tablet.
+    bool in_flight = false;
+  };
+
+  struct HeartbeatBatch {
+    TabletId status_tablet;
+    std::vector<TransactionId> ids;
+    tserver::HeartbeatTransactionsRequestPB request;
+    rpc::Rpcs::Handle handle;
+  };
+
+  typedef std::shared_ptr<HeartbeatBatch> HeartbeatBatchPtr;
+
+  void ScheduleHeartbeatsUnlocked() {
+    heartbeat_task_id_ = client_->messenger()->scheduler().Schedule(
+        std::bind(&Impl::SendHeartbeats, this, std::placeholders::_1),
+        std::chrono::microseconds(FLAGS_transaction_heartbeat_usec));
+  }
+
+  void SendHeartbeats(const Status& status) {
+    std::vector<std::pair<HeartbeatBatchPtr, internal::RemoteTabletPtr>> batches;
+    {
+      std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+      heartbeat_task_id_ = rpc::kUninitializedScheduledTaskId;
+      if (!status.ok() || heartbeat_closing_) {
+        heartbeat_cond_.notify_all();
+        return;
+      }
+      if (heartbeat_tablets_.empty()) {
+        // Will be scheduled again by the next registered transaction.
+        return;
+      }
+      if (!GetAtomicFlag(&FLAGS_transaction_disable_heartbeat_in_tests)) {
+        for (auto& tablet_and_data : heartbeat_tablets_) {
+          auto& data = tablet_and_data.second;
+          if (data.in_flight || data.transactions.empty()) {
+            continue;
+          }
+          auto batch = std::make_shared<HeartbeatBatch>();
+          batch->handle = rpcs_.Prepare();
+          if (batch->handle == rpcs_.InvalidHandle()) {
+            break;
+          }
+          batch->status_tablet = tablet_and_data.first;
+          batch->request.set_tablet_id(tablet_and_data.first);
+          batch->ids.reserve(data.transactions.size());
+          for (const auto& id_and_callback : data.transactions) {
+            const auto& id = id_and_callback.first;
+            batch->ids.push_back(id);
+            batch->request.add_transaction_id(id.data, id.size());
+          }
+          data.in_flight = true;
+          batches.emplace_back(std::move(batch), data.tablet);
+        }
+      }
+      ScheduleHeartbeatsUnlocked();
+    }
+
+    for (auto& batch_and_tablet : batches) {
+      auto& batch = batch_and_tablet.first;
+      VLOG(4) << "Send heartbeat of " << batch->ids.size() << " transactions to "
+              << batch->status_tablet;
+      batch->request.set_propagated_hybrid_time(Now().ToUint64());
+      *batch->handle = HeartbeatTransactions(
+          TransactionRpcDeadline(),
+          batch_and_tablet.second.get(),
+          client_,
+          &batch->request,
+          std::bind(&Impl::HeartbeatsDone, this, std::placeholders::_1, std::placeholders::_2,
+                    batch));
+      (**batch->handle).SendRpc();
+    }
+  }
+
+  void HeartbeatsDone(const Status& status,
+                      const tserver::HeartbeatTransactionsResponsePB& response,
+                      const HeartbeatBatchPtr& batch) {
+    if (response.has_propagated_hybrid_time()) {
+      UpdateClock(HybridTime(response.propagated_hybrid_time()));
+    }
+    rpcs_.Unregister(&batch->handle);
+
+    bool status_count_matches =
+        implicit_cast<size_t>(response.status().size()) == batch->ids.size();
+    LOG_IF(WARNING, !status.ok()) << "Send heartbeats failed: " << status;
+    LOG_IF(DFATAL, status.ok() && !status_count_matches)
+        << "Wrong number of heartbeat statuses for " << batch->ids.size() << " transactions: "
+        << response.ShortDebugString();
+
+    std::vector<std::pair<HeartbeatFailedCallback, Status>> failed;
+    {
+      std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+      auto it = heartbeat_tablets_.find(batch->status_tablet);
+      if (it == heartbeat_tablets_.end()) {
+        return;
+      }
+      auto& data = it->second;
+      data.in_flight = false;
+      if (status.IsNotSupported()) {
+        // Status tablet leader runs an older version without HeartbeatTransactions, so all
+        // transactions of this client fall back to individual heartbeats.
+        LOG(WARNING) << "Heartbeat batching is not supported by " << batch->status_tablet
+                     << ", falling back to per transaction heartbeats";
+        heartbeat_batching_supported_.store(false, std::memory_order_release);
+        for (auto& id_and_callback : data.transactions) {
+          failed.emplace_back(std::move(id_and_callback.second), status);
+        }
+        data.transactions.clear();
+      } else if (status.ok() && status_count_matches) {
+        for (size_t i = 0; i != batch->ids.size(); ++i) {
+          auto heartbeat_status = StatusFromPB(response.status(i));
+          // Other errors are transient, so heartbeat is just sent again in the next round.
+          if (!heartbeat_status.IsExpired() && !heartbeat_status.IsAborted()) {
+            continue;
+          }
+          auto transaction_it = data.transactions.find(batch->ids[i]);
+          if (transaction_it != data.transactions.end()) {
+            failed.emplace_back(std::move(transaction_it->second), heartbeat_status);
+            data.transactions.erase(transaction_it);
+          }
+        }
+      }
+      if (data.transactions.empty()) {
+        heartbeat_tablets_.erase(it);
+      }
+    }
+
+    for (const auto& callback_and_status : failed) {
+      callback_and_status.first(callback_and_status.second);
+    }
+  }
+
   YBClient* const client_;
   scoped_refptr<ClockBase> clock_;
   TransactionTableState table_state_;
@@ -206,6 +496,14 @@ class TransactionManager::Impl {
   yb::rpc::TasksPool<PickStatusTabletTask> tasks_pool_;
   yb::rpc::TasksPool<InvokeCallbackTask> invoke_callback_tasks_;
   yb::rpc::Rpcs rpcs_;
+
+  std::mutex heartbeat_mutex_;
+  std::condition_variable heartbeat_cond_;
+  bool heartbeat_closing_ = false;
+  rpc::ScheduledTaskId heartbeat_task_id_ = rpc::kUninitializedScheduledTaskId;
+  std::atomic<bool> heartbeat_batching_supported_{true};
+  // Running transactions of this client, grouped by status tablet.
+  std::unordered_map<TabletId, HeartbeatTabletData> heartbeat_tablets_;
 };
 
 TransactionManager::TransactionManager(
@@ -221,6 +519,25 @@ void TransactionManager::PickStatusTablet(PickStatusTabletCallback callback) {
   impl_->PickStatusTablet(std::move(callback));
 }
 
+void TransactionManager::InvalidateStatusTablets() {
+  impl_->InvalidateStatusTablets();
+}
+
+bool TransactionManager::HeartbeatBatchingSupported() const {
+  return impl_->HeartbeatBatchingSupported();
+}
+
+void TransactionManager::RegisterHeartbeat(
+    const TransactionId& id, const internal::RemoteTabletPtr& status_tablet,
+    HeartbeatFailedCallback callback) {
+  impl_->RegisterHeartbeat(id, status_tablet, std::move(callback));
+}
+
+void TransactionManager::UnregisterHeartbeat(const TransactionId& id,
+                                             const TabletId& status_tablet) {
+  impl_->UnregisterHeartbeat(id, status_tablet);
+}
+
 YBClient* TransactionManager::client() const {
   return impl_->client();
 }
@@ -23,6 +23,7 @@
 
 #include "yb/common/clock.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
 
 #include "yb/rpc/rpc_fwd.h"
 
@@ -32,6 +33,7 @@ namespace yb {
 namespace client {
 
 typedef std::function<void(const Result<std::string>&)> PickStatusTabletCallback;
+typedef std::function<void(const Status&)> HeartbeatFailedCallback;
 
 // TransactionManager manages multiple transactions. It lives at the YQL engine layer.
 class TransactionManager {
@@ -42,6 +44,24 @@ class TransactionManager {
 
   void PickStatusTablet(PickStatusTabletCallback callback);
 
+  // Makes the next PickStatusTablet resolve status tablets again, for instance after the picked
+  // tablet could not be found.
+  void InvalidateStatusTablets();
+
+  // Returns false after a status tablet did not recognize batched heartbeats, i.e. it runs an
+  // older version. Transactions should send their own heartbeats in this case.
+  bool HeartbeatBatchingSupported() const;
+
+  // Registers running transaction for periodic heartbeats. Heartbeats of all transactions of
+  // this client that are managed by the same status tablet are sent in a single RPC.
+  // Callback is invoked when heartbeat failed because transaction expired or was aborted,
+  // after that transaction is unregistered. NotSupported status is passed to the callback when
+  // heartbeat batching is not supported, the transaction should send heartbeats itself then.
+  void RegisterHeartbeat(const TransactionId& id, const internal::RemoteTabletPtr& status_tablet,
+                         HeartbeatFailedCallback callback);
+
+  void UnregisterHeartbeat(const TransactionId& id, const TabletId& status_tablet);
+
   rpc::Rpcs& rpcs();
   YBClient* client() const;
 
@@ -20,6 +20,7 @@
 #include "yb/client/tablet_rpc.h"
 
 #include "yb/rpc/rpc.h"
+#include "yb/rpc/rpc_header.pb.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 #include "yb/tserver/tserver_service.proxy.h"
@@ -57,6 +58,13 @@ class TransactionRpcBase : public rpc::Rpc, public internal::TabletRpc {
   void Finished(const Status& status) override {
     Status new_status = status;
     if (invoker_.Done(&new_status)) {
+      // Tablet servers of older versions do not have newer methods, report it as NotSupported, so
+      // caller could fall back to other methods.
+      const auto* error = retrier().controller().error_response();
+      if (new_status.IsRemoteError() && error &&
+          error->code() == rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD) {
+        new_status = STATUS(NotSupported, new_status.message());
+      }
       auto retain_self = shared_from_this();
       InvokeCallback(new_status);
     }
@@ -199,6 +207,29 @@ struct AbortTransactionTraits {
 
 constexpr const char* AbortTransactionTraits::kName;
 
+struct HeartbeatTransactionsTraits {
+  static constexpr const char* kName = "HeartbeatTransactions";
+
+  typedef tserver::HeartbeatTransactionsRequestPB Request;
+  typedef tserver::HeartbeatTransactionsResponsePB Response;
+  typedef HeartbeatTransactionsCallback Callback;
+
+  static void CallCallback(
+      const Callback& callback, const Status& status, const Response& response) {
+    callback(status, response);
+  }
+
+  static void InvokeAsync(tserver::TabletServerServiceProxy* proxy,
+                          const Request& request,
+                          Response* response,
+                          rpc::RpcController* controller,
+                          rpc::ResponseCallback callback) {
+    proxy->HeartbeatTransactionsAsync(request, response, controller, std::move(callback));
+  }
+};
+
+constexpr const char* HeartbeatTransactionsTraits::kName;
+
 } // namespace
 
 rpc::RpcCommandPtr UpdateTransaction(
@@ -231,5 +262,15 @@ rpc::RpcCommandPtr AbortTransaction(
       deadline, tablet, client, req, std::move(callback));
 }
 
+rpc::RpcCommandPtr HeartbeatTransactions(
+    CoarseTimePoint deadline,
+    internal::RemoteTablet* tablet,
+    YBClient* client,
+    tserver::HeartbeatTransactionsRequestPB* req,
+    HeartbeatTransactionsCallback callback) {
+  return std::make_shared<TransactionRpc<HeartbeatTransactionsTraits>>(
+      deadline, tablet, client, req, std::move(callback));
+}
+
 } // namespace client
 } // namespace yb
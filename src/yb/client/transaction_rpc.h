@@ -35,6 +35,8 @@ class AbortTransactionRequestPB;
 class AbortTransactionResponsePB;
 class GetTransactionStatusRequestPB;
 class GetTransactionStatusResponsePB;
+class HeartbeatTransactionsRequestPB;
+class HeartbeatTransactionsResponsePB;
 class UpdateTransactionRequestPB;
 
 }
@@ -78,6 +80,16 @@ MUST_USE_RESULT rpc::RpcCommandPtr AbortTransaction(
     tserver::AbortTransactionRequestPB* req,
     AbortTransactionCallback callback);
 
+typedef std::function<void(const Status&, const tserver::HeartbeatTransactionsResponsePB&)>
+    HeartbeatTransactionsCallback;
+
+MUST_USE_RESULT rpc::RpcCommandPtr HeartbeatTransactions(
+    CoarseTimePoint deadline,
+    internal::RemoteTablet* tablet,
+    YBClient* client,
+    tserver::HeartbeatTransactionsRequestPB* req,
+    HeartbeatTransactionsCallback callback);
+
 } // namespace client
 } // namespace yb
 
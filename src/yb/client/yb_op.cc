@@ -193,6 +193,10 @@ YBqlWriteOp::YBqlWriteOp(const shared_ptr<YBTable>& table)
 
 YBqlWriteOp::~YBqlWriteOp() {}
 
+size_t YBqlWriteOp::space_used_by_request() const {
+  return ql_write_request_->ByteSizeLong();
+}
+
 static YBqlWriteOp *NewYBqlWriteOp(const shared_ptr<YBTable>& table,
                                    QLWriteRequestPB::QLStmtType stmt_type) {
   YBqlWriteOp *op = new YBqlWriteOp(table);
@@ -343,6 +347,10 @@ YBqlReadOp::YBqlReadOp(const shared_ptr<YBTable>& table)
 
 YBqlReadOp::~YBqlReadOp() {}
 
+size_t YBqlReadOp::space_used_by_request() const {
+  return ql_read_request_->ByteSizeLong();
+}
+
 YBqlReadOp *YBqlReadOp::NewSelect(const shared_ptr<YBTable>& table) {
   YBqlReadOp *op = new YBqlReadOp(table);
   QLReadRequestPB *req = op->mutable_request();
@@ -479,6 +487,10 @@ YBPgsqlWriteOp::YBPgsqlWriteOp(const shared_ptr<YBTable>& table)
 
 YBPgsqlWriteOp::~YBPgsqlWriteOp() {}
 
+size_t YBPgsqlWriteOp::space_used_by_request() const {
+  return write_request_->ByteSizeLong();
+}
+
 static YBPgsqlWriteOp *NewYBPgsqlWriteOp(const shared_ptr<YBTable>& table,
                                          PgsqlWriteRequestPB::PgsqlStmtType stmt_type) {
   YBPgsqlWriteOp *op = new YBPgsqlWriteOp(table);
@@ -540,6 +552,10 @@ YBPgsqlReadOp::YBPgsqlReadOp(const shared_ptr<YBTable>& table)
 
 YBPgsqlReadOp::~YBPgsqlReadOp() {}
 
+size_t YBPgsqlReadOp::space_used_by_request() const {
+  return read_request_->ByteSizeLong();
+}
+
 YBPgsqlReadOp *YBPgsqlReadOp::NewSelect(const shared_ptr<YBTable>& table) {
   YBPgsqlReadOp *op = new YBPgsqlReadOp(table);
   PgsqlReadRequestPB *req = op->mutable_request();
@@ -104,6 +104,9 @@ class YBOperation {
 
   virtual void SetHashCode(uint16_t hash_code) = 0;
 
+  // Returns estimated size of the request of this operation.
+  virtual size_t space_used_by_request() const = 0;
+
   const scoped_refptr<internal::RemoteTablet>& tablet() const {
     return tablet_;
   }
@@ -140,7 +143,6 @@ class YBRedisOp : public YBOperation {
   virtual ~YBRedisOp();
 
   bool has_response() { return redis_response_ ? true : false; }
-  virtual size_t space_used_by_request() const = 0;
 
   const RedisResponsePB& response() const;
 
@@ -265,6 +267,8 @@ class YBqlWriteOp : public YBqlOp {
   // (see WriteRpc's constructor).
   const QLWriteRequestPB& request() const { return *ql_write_request_; }
 
+  size_t space_used_by_request() const override;
+
   QLWriteRequestPB* mutable_request() { return ql_write_request_.get(); }
 
   std::string ToString() const override;
@@ -331,6 +335,8 @@ class YBqlReadOp : public YBqlOp {
   // (see ReadRpc's constructor).
   const QLReadRequestPB& request() const { return *ql_read_request_; }
 
+  size_t space_used_by_request() const override;
+
   QLReadRequestPB* mutable_request() { return ql_read_request_.get(); }
 
   virtual std::string ToString() const override;
@@ -410,6 +416,8 @@ class YBPgsqlWriteOp : public YBPgsqlOp {
   // (see WriteRpc's constructor).
   const PgsqlWriteRequestPB& request() const { return *write_request_; }
 
+  size_t space_used_by_request() const override;
+
   PgsqlWriteRequestPB* mutable_request() { return write_request_.get(); }
 
   std::string ToString() const override;
@@ -458,6 +466,8 @@ class YBPgsqlReadOp : public YBPgsqlOp {
   // (see ReadRpc's constructor).
   const PgsqlReadRequestPB& request() const { return *read_request_; }
 
+  size_t space_used_by_request() const override;
+
   PgsqlReadRequestPB* mutable_request() { return read_request_.get(); }
 
   virtual std::string ToString() const override;
@@ -108,6 +108,11 @@ CoarseTimePoint TransactionRpcDeadline() {
   return CoarseMonoClock::Now() + TransactionRpcTimeout();
 }
 
+std::string LocalTransactionsTableName(const CloudInfoPB& cloud_info) {
+  return Format("$0_$1_$2", kTransactionsTableName, cloud_info.placement_cloud(),
+                cloud_info.placement_region());
+}
+
 bool TransactionOperationContext::transactional() const {
   return !transaction_id.is_nil();
 }
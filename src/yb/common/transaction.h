@@ -241,6 +241,10 @@ CoarseTimePoint TransactionRpcDeadline();
 extern const std::string kTransactionsTableName;
 extern const std::string kMetricsSnapshotsTableName;
 
+// Returns name of transaction status table, whose replicas are placed in the region specified by
+// cloud info.
+std::string LocalTransactionsTableName(const CloudInfoPB& cloud_info);
+
 } // namespace yb
 
 #endif // YB_COMMON_TRANSACTION_H
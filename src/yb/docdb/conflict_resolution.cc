@@ -35,10 +35,13 @@ namespace docdb {
 
 namespace {
 
-using TransactionIdSet = std::unordered_set<TransactionId, TransactionIdHash>;
+// Maps conflicting transaction to the first key where conflict with it was found.
+using ConflictsMap = std::unordered_map<TransactionId, std::string, TransactionIdHash>;
 
 struct TransactionData {
   TransactionId id;
+  // Key where conflict with this transaction was found.
+  std::string key;
   TransactionStatus status;
   HybridTime commit_time;
   TransactionMetadata metadata;
@@ -61,7 +64,9 @@ struct TransactionData {
 
 CHECKED_STATUS MakeConflictStatus(const TransactionId& id, const char* reason,
                                   Counter* conflicts_metric) {
-  conflicts_metric->Increment();
+  if (conflicts_metric) {
+    conflicts_metric->Increment();
+  }
   return STATUS_FORMAT(TryAgain,
                        "Conflicts with $0 transaction: $1",
                        reason,
@@ -82,7 +87,10 @@ class ConflictResolverContext {
 
   // Check for conflict against committed transaction.
   virtual CHECKED_STATUS CheckConflictWithCommitted(
-      const TransactionId& id, HybridTime commit_time) = 0;
+      const TransactionData& transaction, HybridTime commit_time) = 0;
+
+  // Invoked when conflicting transaction was aborted by this resolution.
+  virtual void ConflictingTransactionAborted(const TransactionData& transaction) = 0;
 
   virtual HybridTime GetResolutionHt() = 0;
 
@@ -173,8 +181,9 @@ class ConflictResolver {
         auto transaction_id = VERIFY_RESULT(FullyDecodeTransactionId(
             Slice(existing_value.data(), TransactionId::static_size())));
 
-        if (!context_.IgnoreConflictsWith(transaction_id)) {
-          conflicts_.insert(transaction_id);
+        if (!context_.IgnoreConflictsWith(transaction_id) &&
+            conflicts_.find(transaction_id) == conflicts_.end()) {
+          conflicts_.emplace(transaction_id, prefix_slice.ToBuffer());
         }
       }
 
@@ -202,8 +211,8 @@ class ConflictResolver {
     VLOG(3) << context_.ToString() << ", conflicts: " << yb::ToString(conflicts_);
     if (!conflicts_.empty()) {
       transactions_.reserve(conflicts_.size());
-      for (const auto& transaction_id : conflicts_) {
-        transactions_.push_back({ transaction_id });
+      for (auto& id_and_key : conflicts_) {
+        transactions_.push_back({ id_and_key.first, std::move(id_and_key.second) });
       }
 
       return DoResolveConflicts();
@@ -244,7 +253,7 @@ class ConflictResolver {
         ++write_iterator;
         continue;
       }
-      RETURN_NOT_OK(context_.CheckConflictWithCommitted(transaction.id, commit_time));
+      RETURN_NOT_OK(context_.CheckConflictWithCommitted(transaction, commit_time));
       VLOG(4) << context_.ToString() << ", locally committed: " << transaction.id;
     }
     transactions_.erase(write_iterator, transactions_.end());
@@ -260,13 +269,13 @@ class ConflictResolver {
       RETURN_NOT_OK(transaction.failure);
       auto status = transaction.status;
       if (status == TransactionStatus::COMMITTED) {
-        RETURN_NOT_OK(context_.CheckConflictWithCommitted(transaction.id, transaction.commit_time));
+        RETURN_NOT_OK(context_.CheckConflictWithCommitted(transaction, transaction.commit_time));
         VLOG(4) << context_.ToString() << ", committed: " << transaction.id;
         continue;
       } else if (status == TransactionStatus::ABORTED) {
         auto commit_time = status_manager().LocalCommitTime(transaction.id);
         if (commit_time.is_valid()) {
-          RETURN_NOT_OK(context_.CheckConflictWithCommitted(transaction.id, commit_time));
+          RETURN_NOT_OK(context_.CheckConflictWithCommitted(transaction, commit_time));
           VLOG(4) << context_.ToString() << ", locally committed: " << transaction.id;
         } else {
           VLOG(4) << context_.ToString() << ", aborted: " << transaction.id;
@@ -345,6 +354,11 @@ class ConflictResolver {
     }
     std::unique_lock<std::mutex> lock(context.mutex);
     context.cond.wait(lock, [&context] { return context.left == 0; });
+    for (const auto& transaction : transactions_) {
+      if (transaction.status == TransactionStatus::ABORTED) {
+        context_.ConflictingTransactionAborted(transaction);
+      }
+    }
     return context.result;
   }
 
@@ -354,7 +368,7 @@ class ConflictResolver {
   TransactionStatusManager& status_manager_;
   RequestScope request_scope_;
   ConflictResolverContext& context_;
-  TransactionIdSet conflicts_;
+  ConflictsMap conflicts_;
   std::vector<TransactionData> transactions_;
 };
 
@@ -366,7 +380,9 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
                                      HybridTime resolution_ht,
                                      HybridTime read_time,
                                      PartialRangeKeyIntents partial_range_key_intents,
-                                     Counter* conflicts_metric)
+                                     Counter* conflicts_metric,
+                                     std::vector<ConflictInfo>* wait_for,
+                                     ConflictObserver* conflict_observer)
       : doc_ops_(doc_ops),
         write_batch_(write_batch),
         resolution_ht_(resolution_ht),
@@ -374,7 +390,9 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
         transaction_id_(FullyDecodeTransactionId(
             write_batch.transaction().transaction_id())),
         partial_range_key_intents_(partial_range_key_intents),
-        conflicts_metric_(conflicts_metric)
+        conflicts_metric_(conflicts_metric),
+        wait_for_(wait_for),
+        conflict_observer_(conflict_observer)
   {}
 
   virtual ~TransactionConflictResolverContext() {}
@@ -481,6 +499,8 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
                 << ", found key: " << SubDocKey::DebugSliceToString(value_iter.key());
         if (doc_ht.hybrid_time() >= read_time_) {
           conflicts_metric_->Increment();
+          ReportConflict(boost::uuids::nil_uuid(), key_slice,
+                         ConflictOutcome::kValueOverwrite);
           return STATUS_FORMAT(TryAgain, "Value write after transaction start: $0 >= $1",
                                doc_ht.hybrid_time(), read_time_);
         }
@@ -497,6 +517,7 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
   CHECKED_STATUS CheckPriority(ConflictResolver* resolver,
                                std::vector<TransactionData>* transactions) override {
     auto our_priority = metadata_.priority;
+    const TransactionData* higher_priority_transaction = nullptr;
     for (auto& transaction : *transactions) {
       if (!fetched_metadata_for_transactions_) {
         auto their_metadata = resolver->Metadata(transaction.id);
@@ -510,19 +531,35 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
       }
       auto their_priority = transaction.metadata.priority;
       if (our_priority < their_priority) {
-        return MakeConflictStatus(transaction.id, "higher priority", conflicts_metric_);
+        if (!wait_for_) {
+          ReportConflict(transaction.id, transaction.key, ConflictOutcome::kHigherPriority);
+          return MakeConflictStatus(transaction.id, "higher priority", conflicts_metric_);
+        }
+        // Transaction could wait only for transactions with higher priority, so there are
+        // no cycles in wait-for graph and waits cannot deadlock.
+        // Conflict is reported by the caller, that could retry resolution several times while
+        // waiting.
+        wait_for_->push_back(ConflictInfo{
+            *transaction_id_, transaction.id, transaction.key, ConflictOutcome::kHigherPriority});
+        higher_priority_transaction = &transaction;
       }
     }
     fetched_metadata_for_transactions_ = true;
 
+    if (higher_priority_transaction) {
+      // Caller waits for this conflict, so it is counted as wait instead of conflict.
+      return MakeConflictStatus(
+          higher_priority_transaction->id, "higher priority", nullptr /* conflicts_metric */);
+    }
+
     return Status::OK();
   }
 
   CHECKED_STATUS CheckConflictWithCommitted(
-      const TransactionId& id, HybridTime commit_time) override {
+      const TransactionData& transaction, HybridTime commit_time) override {
     DSCHECK(commit_time.is_valid(), Corruption, "Invalid transaction commit time");
 
-    VLOG(4) << "Committed: " << id << ", " << commit_time;
+    VLOG(4) << "Committed: " << transaction.id << ", " << commit_time;
 
     // commit_time equals to HybridTime::kMax means that transaction is not actually committed,
     // but is being committed. I.e. status tablet is trying to replicate COMMITTED state.
@@ -536,12 +573,24 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
     // In all other cases we have concrete read time and should conflict with transactions
     // that were committed after this point.
     if (commit_time >= read_time_) {
-      return MakeConflictStatus(id, "committed", conflicts_metric_);
+      ReportConflict(transaction.id, transaction.key, ConflictOutcome::kCommitted);
+      return MakeConflictStatus(transaction.id, "committed", conflicts_metric_);
     }
 
     return Status::OK();
   }
 
+  void ConflictingTransactionAborted(const TransactionData& transaction) override {
+    ReportConflict(transaction.id, transaction.key, ConflictOutcome::kAbortedOther);
+  }
+
+  void ReportConflict(const TransactionId& conflicting_id, Slice key, ConflictOutcome outcome) {
+    if (conflict_observer_ && transaction_id_.ok()) {
+      conflict_observer_->ConflictDetected(
+          ConflictInfo{*transaction_id_, conflicting_id, key.ToBuffer(), outcome});
+    }
+  }
+
   HybridTime GetResolutionHt() override {
     return resolution_ht_;
   }
@@ -572,6 +621,10 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
   bool fetched_metadata_for_transactions_ = false;
   PartialRangeKeyIntents partial_range_key_intents_;
   Counter* conflicts_metric_ = nullptr;
+  // When specified, conflicts with higher priority transactions are stored here, so caller could
+  // wait for them instead of failing the whole transaction.
+  std::vector<ConflictInfo>* wait_for_ = nullptr;
+  ConflictObserver* conflict_observer_ = nullptr;
 };
 
 class OperationConflictResolverContext : public ConflictResolverContext {
@@ -632,11 +685,14 @@ class OperationConflictResolverContext : public ConflictResolverContext {
   }
 
   CHECKED_STATUS CheckConflictWithCommitted(
-      const TransactionId& id, HybridTime commit_time) override {
+      const TransactionData& transaction, HybridTime commit_time) override {
     resolution_ht_.MakeAtLeast(commit_time);
     return Status::OK();
   }
 
+  void ConflictingTransactionAborted(const TransactionData& transaction) override {
+  }
+
  private:
   const DocOperations& doc_ops_;
   HybridTime resolution_ht_;
@@ -651,10 +707,13 @@ Status ResolveTransactionConflicts(const DocOperations& doc_ops,
                                    const DocDB& doc_db,
                                    PartialRangeKeyIntents partial_range_key_intents,
                                    TransactionStatusManager* status_manager,
-                                   Counter* conflicts_metric) {
+                                   Counter* conflicts_metric,
+                                   std::vector<ConflictInfo>* wait_for,
+                                   ConflictObserver* conflict_observer) {
   DCHECK(hybrid_time.is_valid());
   TransactionConflictResolverContext context(
-      doc_ops, write_batch, hybrid_time, read_time, partial_range_key_intents, conflicts_metric);
+      doc_ops, write_batch, hybrid_time, read_time, partial_range_key_intents, conflicts_metric,
+      wait_for, conflict_observer);
   ConflictResolver resolver(doc_db, status_manager, &context);
   return resolver.Resolve();
 }
@@ -704,6 +763,11 @@ Result<ParsedIntent> ParseIntentKey(Slice intent_key, Slice transaction_id_sourc
   return result;
 }
 
+std::string ConflictInfo::ToString() const {
+  return Format("{ transaction_id: $0 conflicting_id: $1 key: $2 outcome: $3 }",
+                transaction_id, conflicting_id, SubDocKey::DebugSliceToString(key), outcome);
+}
+
 std::string DebugIntentKeyToString(Slice intent_key) {
   auto parsed = ParseIntentKey(intent_key, Slice());
   if (!parsed.ok()) {
@@ -14,10 +14,13 @@
 #ifndef YB_DOCDB_CONFLICT_RESOLUTION_H
 #define YB_DOCDB_CONFLICT_RESOLUTION_H
 
+#include "yb/common/transaction.h"
+
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/value_type.h"
 
+#include "yb/util/enums.h"
 #include "yb/util/result.h"
 
 namespace rocksdb {
@@ -35,17 +38,54 @@ class TransactionStatusManager;
 
 namespace docdb {
 
+YB_DEFINE_ENUM(ConflictOutcome,
+    // Conflicting transaction was committed after our read time, so our transaction failed.
+    (kCommitted)
+    // Conflicting transaction has higher priority, so our transaction failed or will wait for it.
+    (kHigherPriority)
+    // Value was written after our read time, so our transaction failed.
+    (kValueOverwrite)
+    // Conflicting transaction has lower priority and was aborted.
+    (kAbortedOther));
+
+// Conflict detected while resolving conflicts of a transaction.
+struct ConflictInfo {
+  // Transaction whose conflicts are resolved.
+  TransactionId transaction_id;
+  // Conflicting transaction, nil when conflicting value was written by non transactional write.
+  TransactionId conflicting_id;
+  // Encoded key (without hybrid time) where conflict was found.
+  std::string key;
+  ConflictOutcome outcome;
+
+  std::string ToString() const;
+};
+
+// Receives conflicts detected by ResolveTransactionConflicts.
+class ConflictObserver {
+ public:
+  virtual void ConflictDetected(const ConflictInfo& info) = 0;
+
+ protected:
+  ~ConflictObserver() {}
+};
+
 // Resolves conflicts for write batch of transaction.
 // Read all intents that could conflict with intents generated by provided write_batch.
 // Forms set of conflicting transactions.
 // Tries to abort transactions with lower priority.
 // If it conflicts with transaction with higher priority or committed one then error is returned.
+// If wait_for is specified, conflicts with pending transactions of higher priority are stored
+// there instead of being reported to conflict_observer, so caller could wait for their completion
+// and retry resolution.
 //
 // write_batch - values that would be written as part of transaction.
 // hybrid_time - current hybrid time.
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
 // conflicts_metric - transaction_conflicts metric to update.
+// wait_for - if not null, receives conflicts with pending transactions this one should wait for.
+// conflict_observer - if not null, is notified about each detected conflict.
 CHECKED_STATUS ResolveTransactionConflicts(const DocOperations& doc_ops,
                                            const KeyValueWriteBatchPB& write_batch,
                                            HybridTime resolution_ht,
@@ -53,7 +93,9 @@ CHECKED_STATUS ResolveTransactionConflicts(const DocOperations& doc_ops,
                                            const DocDB& doc_db,
                                            PartialRangeKeyIntents partial_range_key_intents,
                                            TransactionStatusManager* status_manager,
-                                           Counter* conflicts_metric);
+                                           Counter* conflicts_metric,
+                                           std::vector<ConflictInfo>* wait_for = nullptr,
+                                           ConflictObserver* conflict_observer = nullptr);
 
 // Resolves conflicts for doc operations.
 // Read all intents that could conflict with provided doc_ops.
@@ -61,6 +61,7 @@ using namespace std::chrono_literals;
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
 DECLARE_bool(docdb_sort_weak_intents_in_tests);
+DECLARE_int32(txn_max_written_weak_intents);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -3256,6 +3257,28 @@ TEST_F(DocDBTest, ForceFlushedFrontier) {
   ASSERT_EQ(*new_user_frontier_ptr, *rocksdb_->GetFlushedFrontier());
 }
 
+TEST_F(DocDBTest, WrittenWeakIntents) {
+  FLAGS_txn_max_written_weak_intents = 2;
+  const IntentTypeSet weak_read{IntentType::kWeakRead};
+  const IntentTypeSet weak_write{IntentType::kWeakWrite};
+  const IntentTypeSet weak_read_write{IntentType::kWeakRead, IntentType::kWeakWrite};
+
+  WrittenWeakIntents written_weak_intents;
+  ASSERT_TRUE(written_weak_intents.ShouldWrite("a", weak_write));
+  ASSERT_FALSE(written_weak_intents.ShouldWrite("a", weak_write));
+  // Wider set of intent types should be written again.
+  ASSERT_TRUE(written_weak_intents.ShouldWrite("a", weak_read_write));
+  ASSERT_FALSE(written_weak_intents.ShouldWrite("a", weak_read));
+  ASSERT_FALSE(written_weak_intents.ShouldWrite("a", weak_write));
+
+  ASSERT_TRUE(written_weak_intents.ShouldWrite("b", weak_read));
+  // Limit is reached, so new keys are always written.
+  ASSERT_TRUE(written_weak_intents.ShouldWrite("c", weak_read));
+  ASSERT_TRUE(written_weak_intents.ShouldWrite("c", weak_read));
+  ASSERT_FALSE(written_weak_intents.ShouldWrite("b", weak_read));
+  ASSERT_EQ(2U, written_weak_intents.size());
+}
+
 // Handy code to analyze some DB.
 TEST_F(DocDBTest, DISABLED_DumpDB) {
   tablet::TabletOptions tablet_options;
@@ -72,6 +72,11 @@ using namespace std::placeholders;
 DEFINE_test_flag(bool, docdb_sort_weak_intents_in_tests, false,
                 "Sort weak intents to make their order deterministic.");
 
+DEFINE_int32(txn_max_written_weak_intents, 10000,
+             "Max number of weak intents remembered per transaction per tablet to avoid writing "
+             "them again. 0 to disable.");
+TAG_FLAG(txn_max_written_weak_intents, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -502,11 +507,13 @@ class PrepareTransactionWriteBatchHelper {
   PrepareTransactionWriteBatchHelper(HybridTime hybrid_time,
                                      rocksdb::WriteBatch* rocksdb_write_batch,
                                      const TransactionId& transaction_id,
-                                     IntraTxnWriteId* intra_txn_write_id)
+                                     IntraTxnWriteId* intra_txn_write_id,
+                                     WrittenWeakIntents* written_weak_intents)
       : hybrid_time_(hybrid_time),
         rocksdb_write_batch_(rocksdb_write_batch),
         transaction_id_(transaction_id),
-        intra_txn_write_id_(intra_txn_write_id) {
+        intra_txn_write_id_(intra_txn_write_id),
+        written_weak_intents_(written_weak_intents) {
   }
 
   void Setup(IsolationLevel isolation_level, OperationKind kind) {
@@ -578,6 +585,10 @@ class PrepareTransactionWriteBatchHelper {
       const std::pair<std::string, IntentTypeSet>& intent_and_types,
       const std::array<Slice, 2>& value,
       DocHybridTimeBuffer* doc_ht_buffer) {
+    if (written_weak_intents_ &&
+        !written_weak_intents_->ShouldWrite(intent_and_types.first, intent_and_types.second)) {
+      return;
+    }
     char intent_type[2] = { ValueTypeAsChar::kIntentTypeSet,
                             static_cast<char>(intent_and_types.second.ToUIntPtr()) };
     std::array<Slice, 3> key = {{
@@ -598,8 +609,23 @@ class PrepareTransactionWriteBatchHelper {
   std::unordered_map<std::string, IntentTypeSet> weak_intents_;
   IntraTxnWriteId write_id_ = 0;
   IntraTxnWriteId* intra_txn_write_id_;
+  WrittenWeakIntents* written_weak_intents_;
 };
 
+bool WrittenWeakIntents::ShouldWrite(const std::string& key, IntentTypeSet intent_types) {
+  auto it = intents_.find(key);
+  if (it != intents_.end()) {
+    if ((it->second & intent_types) == intent_types) {
+      return false;
+    }
+    it->second |= intent_types;
+  } else if (FLAGS_txn_max_written_weak_intents > 0 &&
+             intents_.size() < static_cast<size_t>(FLAGS_txn_max_written_weak_intents)) {
+    intents_.emplace(key, intent_types);
+  }
+  return true;
+}
+
 // We have the following distinct types of data in this "intent store":
 // Main intent data:
 //   Prefix + SubDocKey (no HybridTime) + IntentType + HybridTime -> TxnId + value of the intent
@@ -617,11 +643,12 @@ void PrepareTransactionWriteBatch(
     const TransactionId& transaction_id,
     IsolationLevel isolation_level,
     PartialRangeKeyIntents partial_range_key_intents,
-    IntraTxnWriteId* write_id) {
+    IntraTxnWriteId* write_id,
+    WrittenWeakIntents* written_weak_intents) {
   VLOG(4) << "PrepareTransactionWriteBatch(), write_id = " << *write_id;
 
   PrepareTransactionWriteBatchHelper helper(
-      hybrid_time, rocksdb_write_batch, transaction_id, write_id);
+      hybrid_time, rocksdb_write_batch, transaction_id, write_id, written_weak_intents);
 
   if (!put_batch.write_pairs().empty()) {
     helper.Setup(isolation_level, OperationKind::kWrite);
@@ -1416,8 +1443,13 @@ CHECKED_STATUS IntentToWriteRequest(
   return Status::OK();
 }
 
-Status PrepareApplyIntentsBatch(
+std::string ApplyTransactionState::ToString() const {
+  return Format("{ key: $0 write_id: $1 }", Slice(key).ToDebugString(), write_id);
+}
+
+Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const TransactionId &transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
+    const ApplyTransactionState* apply_state, size_t max_records,
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch) {
   // regular_batch or intents_batch could be null. In this case we don't fill apply batch for
@@ -1445,11 +1477,15 @@ Status PrepareApplyIntentsBatch(
   txn_reverse_index_upperbound.AppendValueType(ValueType::kMaxByte);
   reverse_index_upperbound = txn_reverse_index_upperbound.AsSlice();
 
-  reverse_index_iter.Seek(txn_reverse_index_prefix.data());
-
-  DocHybridTimeBuffer doc_ht_buffer;
-
   IntraTxnWriteId write_id = 0;
+  if (apply_state && apply_state->active()) {
+    reverse_index_iter.Seek(apply_state->key);
+    write_id = apply_state->write_id;
+  } else {
+    reverse_index_iter.Seek(txn_reverse_index_prefix.data());
+  }
+
+  size_t num_records = 0;
   while (reverse_index_iter.Valid()) {
     rocksdb::Slice key_slice(reverse_index_iter.key());
 
@@ -1457,6 +1493,10 @@ Status PrepareApplyIntentsBatch(
       break;
     }
 
+    if (max_records && num_records >= max_records) {
+      return ApplyTransactionState{key_slice.ToBuffer(), write_id};
+    }
+
     VLOG(4) << "Apply reverse index record: "
             << EntryToString(reverse_index_iter, StorageDbType::kIntents);
 
@@ -1469,21 +1509,26 @@ Status PrepareApplyIntentsBatch(
         RETURN_NOT_OK(IntentToWriteRequest(
             transaction_id_slice, commit_ht, &reverse_index_iter, &intent_iter,
             regular_batch, &write_id));
+        ++num_records;
       }
 
+      // Intent and its reverse index record are written exactly once, since their keys contain
+      // unique hybrid time. So single delete could be used, that is dropped together with the
+      // deleted record by any compaction that sees both of them, instead of leaving a tombstone
+      // until the major compaction.
       if (intents_batch) {
-        intents_batch->Delete(reverse_index_iter.value());
+        intents_batch->SingleDelete(reverse_index_iter.value());
+        intents_batch->SingleDelete(reverse_index_iter.key());
       }
-    }
-
-    if (intents_batch) {
+    } else if (intents_batch) {
+      // Transaction metadata could be written several times, so regular delete is required.
       intents_batch->Delete(reverse_index_iter.key());
     }
 
     reverse_index_iter.Next();
   }
 
-  return Status::OK();
+  return ApplyTransactionState();
 }
 
 }  // namespace docdb
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <ostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <boost/function.hpp>
 
@@ -168,6 +169,27 @@ CHECKED_STATUS EnumerateIntents(
     Slice key, const Slice& intent_value, const EnumerateIntentsCallback& functor,
     KeyBytes* encoded_key_buffer, PartialRangeKeyIntents partial_range_key_intents);
 
+// Weak intents that were already written to the intents DB by a transaction on a tablet.
+// Weak intents are used only for conflict detection and are removed together with the rest of
+// transaction intents, so there is no need to write the same weak intent for every operation of
+// the transaction, e.g. for every row written to the same table or hash bucket.
+class WrittenWeakIntents {
+ public:
+  // Returns true when weak intent of specified types should be written for the key, i.e. it was
+  // not written before with the same or a wider set of types. Remembers the intent types if
+  // there is room for them.
+  bool ShouldWrite(const std::string& key, IntentTypeSet intent_types);
+
+  size_t size() const {
+    return intents_.size();
+  }
+
+ private:
+  std::unordered_map<std::string, IntentTypeSet> intents_;
+};
+
+// written_weak_intents - could be null, otherwise weak intents that are already present in it are
+// not written again, and written ones are added to it.
 void PrepareTransactionWriteBatch(
     const docdb::KeyValueWriteBatchPB& put_batch,
     HybridTime hybrid_time,
@@ -175,10 +197,31 @@ void PrepareTransactionWriteBatch(
     const TransactionId& transaction_id,
     IsolationLevel isolation_level,
     PartialRangeKeyIntents partial_range_key_intents,
-    IntraTxnWriteId* write_id);
+    IntraTxnWriteId* write_id,
+    WrittenWeakIntents* written_weak_intents = nullptr);
+
+// State of transaction intents application, when intents are applied in several batches.
+struct ApplyTransactionState {
+  // Reverse index key to continue application from. Empty when all intents were applied.
+  std::string key;
+  // Write id of the first intent that was not applied yet.
+  IntraTxnWriteId write_id = 0;
+
+  bool active() const {
+    return !key.empty();
+  }
+
+  std::string ToString() const;
+};
 
-CHECKED_STATUS PrepareApplyIntentsBatch(
+// Fills regular_batch and intents_batch with records for applying and removing intents of
+// the transaction. Starts from apply_state when it is specified.
+// When max_records is not zero, stops after that number of records were added to regular_batch,
+// the returned state could be used to continue application. Inactive state is returned when all
+// intents were processed.
+Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const TransactionId& transaction_id, HybridTime commit_ht, const KeyBounds* key_bounds,
+    const ApplyTransactionState* apply_state, size_t max_records,
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db, rocksdb::WriteBatch* intents_batch);
 
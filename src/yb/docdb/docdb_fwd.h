@@ -14,6 +14,8 @@
 #ifndef YB_DOCDB_DOCDB_FWD_H
 #define YB_DOCDB_DOCDB_FWD_H
 
+#include <memory>
+
 #include "yb/util/strongly_typed_bool.h"
 
 namespace yb {
@@ -25,9 +27,13 @@ class IntentAwareIterator;
 class KeyValueWriteBatchPB;
 class QLWriteOperation;
 class PgsqlWriteOperation;
+class WrittenWeakIntents;
 
+struct ApplyTransactionState;
 struct DocDB;
 
+typedef std::unique_ptr<WrittenWeakIntents> WrittenWeakIntentsPtr;
+
 YB_STRONGLY_TYPED_BOOL(PartialRangeKeyIntents);
 
 }  // namespace docdb
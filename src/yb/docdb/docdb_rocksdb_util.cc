@@ -55,6 +55,17 @@ DEFINE_int32(rocksdb_universal_compaction_size_ratio, 20,
              "The percentage upto which files that are larger are include in a compaction.");
 DEFINE_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
+DEFINE_int32(intents_db_level0_file_num_compaction_trigger, 2,
+             "Number of files to trigger level-0 compaction of intents DB. Intents are short lived, "
+             "so compacting them early purges deleted intents and keeps conflict resolution "
+             "reads cheap. -1 to use rocksdb_level0_file_num_compaction_trigger.");
+DEFINE_int32(intents_db_universal_compaction_min_merge_width, 2,
+             "The minimum number of files in a single compaction run of intents DB. "
+             "-1 to use rocksdb_universal_compaction_min_merge_width.");
+DEFINE_int32(intents_db_memstore_size_mb, -1,
+             "Max size (in mb) of the intents DB memstore, before needing to flush. Intents that "
+             "are removed while still in memstore are never written to disk. "
+             "-1 to use the same size as regular DB memstore.");
 DEFINE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 256_MB,
              "Use to control write rate of flush and compaction.");
 DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
@@ -562,5 +573,24 @@ void InitRocksDBOptions(
       0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
 }
 
+void InitRocksDBOptionsForIntentsDB(rocksdb::Options* options) {
+  if (FLAGS_intents_db_memstore_size_mb > 0) {
+    options->write_buffer_size = FLAGS_intents_db_memstore_size_mb * 1_MB;
+  }
+  if (options->compaction_style != rocksdb::CompactionStyle::kCompactionStyleUniversal) {
+    return;
+  }
+  // Respect disabled compaction by number of files, i.e. in tests.
+  if (FLAGS_intents_db_level0_file_num_compaction_trigger >= 0 &&
+      options->level0_file_num_compaction_trigger >= 0) {
+    options->level0_file_num_compaction_trigger =
+        FLAGS_intents_db_level0_file_num_compaction_trigger;
+  }
+  if (FLAGS_intents_db_universal_compaction_min_merge_width >= 0) {
+    options->compaction_options_universal.min_merge_width =
+        FLAGS_intents_db_universal_compaction_min_merge_width;
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
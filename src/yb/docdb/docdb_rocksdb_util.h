@@ -139,6 +139,11 @@ void InitRocksDBOptions(
     const std::shared_ptr<rocksdb::Statistics>& statistics,
     const tablet::TabletOptions& tablet_options);
 
+// Adjusts 'options' initialized by InitRocksDBOptions for the intents DB. Intents are short lived
+// and most of them are removed soon after being written, so intents DB uses smaller compaction
+// trigger to purge them early.
+void InitRocksDBOptionsForIntentsDB(rocksdb::Options* options);
+
 }  // namespace docdb
 }  // namespace yb
 
@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <atomic>
 #include <string>
 #include <mutex>
 
@@ -48,6 +49,20 @@ DECLARE_int32(tserver_unresponsive_timeout_ms);
 namespace yb {
 namespace master {
 
+namespace {
+
+std::atomic<uint64_t> catalog_entities_version{0};
+
+} // namespace
+
+uint64_t CatalogEntitiesVersion() {
+  return catalog_entities_version.load(std::memory_order_acquire);
+}
+
+void BumpCatalogEntitiesVersion() {
+  catalog_entities_version.fetch_add(1, std::memory_order_acq_rel);
+}
+
 // ================================================================================================
 // TabletReplica
 // ================================================================================================
@@ -95,9 +110,12 @@ TabletInfo::~TabletInfo() {
 }
 
 void TabletInfo::SetReplicaLocations(ReplicaMap replica_locations) {
-  std::lock_guard<simple_spinlock> l(lock_);
-  last_update_time_ = MonoTime::Now();
-  replica_locations_ = std::move(replica_locations);
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    last_update_time_ = MonoTime::Now();
+    replica_locations_ = std::move(replica_locations);
+  }
+  BumpCatalogEntitiesVersion();
 }
 
 void TabletInfo::GetReplicaLocations(ReplicaMap* replica_locations) const {
@@ -106,13 +124,21 @@ void TabletInfo::GetReplicaLocations(ReplicaMap* replica_locations) const {
 }
 
 void TabletInfo::UpdateReplicaLocations(const TabletReplica& replica) {
-  std::lock_guard<simple_spinlock> l(lock_);
-  auto it = replica_locations_.find(replica.ts_desc->permanent_uuid());
-  if (it == replica_locations_.end()) {
-    replica_locations_.emplace(replica.ts_desc->permanent_uuid(), replica);
-    return;
+  bool changed = true;
+  {
+    std::lock_guard<simple_spinlock> l(lock_);
+    auto it = replica_locations_.find(replica.ts_desc->permanent_uuid());
+    if (it == replica_locations_.end()) {
+      replica_locations_.emplace(replica.ts_desc->permanent_uuid(), replica);
+    } else {
+      // Only role and member type are visible to clients.
+      changed = it->second.role != replica.role || it->second.member_type != replica.member_type;
+      it->second.UpdateFrom(replica);
+    }
+  }
+  if (changed) {
+    BumpCatalogEntitiesVersion();
   }
-  it->second.UpdateFrom(replica);
 }
 
 void TabletInfo::set_last_update_time(const MonoTime& ts) {
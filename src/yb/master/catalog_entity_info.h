@@ -50,6 +50,12 @@
 namespace yb {
 namespace master {
 
+// Version of the catalog state visible to clients. It is bumped whenever persistent metadata of a
+// catalog entity is committed, replica locations of a tablet change or a tablet server registers.
+// Used to invalidate cached responses of catalog read RPCs.
+uint64_t CatalogEntitiesVersion();
+void BumpCatalogEntitiesVersion();
+
 // Information on a current replica of a tablet.
 // This is copyable so that no locking is needed.
 struct TabletReplica {
@@ -98,6 +104,11 @@ class MetadataLock : public CowLock<typename MetadataClass::cow_state> {
       : super(DCHECK_NOTNULL(info)->mutable_metadata(), mode) {}
   MetadataLock(const MetadataClass* info, typename super::LockMode mode)
       : super(&(DCHECK_NOTNULL(info))->metadata(), mode) {}
+
+  void Commit() {
+    super::Commit();
+    BumpCatalogEntitiesVersion();
+  }
 };
 
 // This class is a base wrapper around accessors for the persistent proto data, through CowObject.
@@ -261,5 +261,34 @@ TEST(TestCatalogManager, TestLeaderLoadBalanced) {
 }
 
 
+// Cached catalog responses should not be served after catalog entities are modified.
+TEST(CatalogResponseCacheTest, InvalidatedOnCommit) {
+  scoped_refptr<TableInfo> table(new TableInfo(CURRENT_TEST_NAME()));
+  scoped_refptr<TabletInfo> tablet(new TabletInfo(table, "tablet"));
+
+  CatalogResponseCache<GetTableLocationsResponsePB> cache(2);
+  GetTableLocationsResponsePB resp;
+  resp.set_table_type(TableType::YQL_TABLE_TYPE);
+  auto version = CatalogEntitiesVersion();
+  cache.Put("key", version, resp);
+  auto cached = cache.Get("key", version);
+  ASSERT_NE(cached, nullptr);
+  ASSERT_EQ(TableType::YQL_TABLE_TYPE, cached->table_type());
+  ASSERT_EQ(cache.Get("other", version), nullptr);
+
+  {
+    auto l = tablet->LockForWrite();
+    l->mutable_data()->pb.set_state(SysTabletsEntryPB::RUNNING);
+    l->Commit();
+  }
+  auto new_version = CatalogEntitiesVersion();
+  ASSERT_NE(version, new_version);
+  ASSERT_EQ(cache.Get("key", new_version), nullptr);
+
+  cache.Put("key", new_version, resp);
+  ASSERT_NE(cache.Get("key", new_version), nullptr);
+}
+
+
 } // namespace master
 } // namespace yb
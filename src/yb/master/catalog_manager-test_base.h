@@ -179,6 +179,14 @@ class TestLoadBalancerBase {
 
     PrepareTestState(ts_descs_multi_az);
     TestLeaderOverReplication();
+
+    // Tablet loads are reported to the descriptors, so use fresh ones.
+    PrepareTestState({SetupTS("0000", "a"), SetupTS("1111", "b"), SetupTS("2222", "c")});
+    TestLoadAwareBalancing();
+
+    gflags::SetCommandLineOption("leader_balance_threshold", "0");
+    PrepareTestState({SetupTS("0000", "a"), SetupTS("1111", "b"), SetupTS("2222", "c")});
+    TestLeaderTrafficBalancing();
   }
 
  protected:
@@ -486,6 +494,66 @@ class TestLoadBalancerBase {
     ASSERT_EQ(0, cb_->get_total_over_replication());
   }
 
+  void TestLoadAwareBalancing() {
+    LOG(INFO) << "Testing balancing by reported tablet load";
+    PlacementInfoPB* cluster_placement = replication_info_.mutable_live_replicas();
+    cluster_placement->set_num_replicas(kNumReplicas);
+
+    // The last tablet is ten times larger than the others.
+    for (const auto& ts_desc : ts_descs_) {
+      for (size_t i = 0; i != tablets_.size(); ++i) {
+        TSDescriptor::TabletLoad load;
+        load.sst_file_size = i + 1 == tablets_.size() ? 10000 : 1000;
+        ts_desc->set_tablet_load(tablets_[i]->tablet_id(), load);
+      }
+    }
+    ts_descs_.push_back(SetupTS("3333", "a"));
+
+    // Tablet servers with high CPU usage do not receive new replicas.
+    ts_descs_[3]->set_cpu_usage(0.95);
+    ASSERT_OK(AnalyzeTablets());
+    string tablet_id, from_ts, to_ts;
+    ASSERT_FALSE(ASSERT_RESULT(HandleAddReplicas(&tablet_id, &from_ts, &to_ts)));
+
+    ts_descs_[3]->set_cpu_usage(0.1);
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+
+    // Moving the large tablet alone halves the load difference with the empty TS, while counting
+    // tablets would move the first one.
+    string expected_tablet_id = tablets_.back()->tablet_id();
+    string expected_from_ts = ts_descs_[2]->permanent_uuid();
+    string expected_to_ts = ts_descs_[3]->permanent_uuid();
+    TestAddLoad(expected_tablet_id, expected_from_ts, expected_to_ts);
+  }
+
+  void TestLeaderTrafficBalancing() {
+    LOG(INFO) << "Testing balancing leaders by reported traffic";
+    // Tablets 0 and 1 serve all traffic and are led by ts0, tablets 2 and 3 are led by ts1.
+    // Only leaders report traffic.
+    for (size_t i = 0; i != tablets_.size(); ++i) {
+      auto& leader = ts_descs_[i < 2 ? 0 : 1];
+      MoveTabletLeader(tablets_[i].get(), leader);
+      TSDescriptor::TabletLoad load;
+      load.read_ops_per_sec = i < 2 ? 1000 : 0;
+      leader->set_tablet_load(tablets_[i]->tablet_id(), load);
+    }
+    LOG(INFO) << "Leader distribution: 2 2 0";
+
+    ASSERT_OK(AnalyzeTablets());
+
+    // Leader counts of ts0 and ts1 are the same, but ts0 serves all traffic, so one of its hot
+    // leaders is moved to ts2.
+    string tablet_id;
+    TestMoveLeader(&tablet_id, ts_descs_[0]->permanent_uuid(), ts_descs_[2]->permanent_uuid());
+    ASSERT_TRUE(tablet_id == tablets_[0]->tablet_id() || tablet_id == tablets_[1]->tablet_id())
+        << tablet_id;
+
+    // Moving the remaining hot leader, or a cold one, would not make leaders more balanced.
+    string placeholder;
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+  }
+
   void TestWithMissingTabletServers() {
     LOG(INFO) << "Testing with missing tablet servers";
     SetupClusterConfig({"a"}, &replication_info_);
@@ -220,6 +220,12 @@ DEFINE_uint64(transaction_table_num_tablets, 0,
     "Number of tablets to use when creating the transaction status table."
     "0 to use the same default num tablets as for regular tables.");
 
+DEFINE_bool(auto_create_local_transaction_tables, false,
+    "Whether to create a transaction status table for each region that has enough live tablet "
+    "servers, with all replicas placed in this region. Clients of the region pick status tablets "
+    "of their transactions from this table.");
+TAG_FLAG(auto_create_local_transaction_tables, advanced);
+
 DEFINE_bool(master_enable_metrics_snapshotter, false, "Should metrics snapshotter be enabled");
 
 DEFINE_uint64(metrics_snapshots_table_num_tablets, 0,
@@ -247,6 +253,12 @@ DEFINE_test_flag(int32, simulate_slow_system_tablet_bootstrap_secs, 0,
 DEFINE_test_flag(bool, return_error_if_namespace_not_found, false,
     "Return an error from ListTables if a namespace id is not found in the map");
 
+DEFINE_int32(master_catalog_response_cache_size, 10000,
+             "Max number of GetTableLocations, GetTabletLocations and GetTableSchema responses "
+             "cached by master. Cached responses are dropped on any catalog change. "
+             "0 to disable.");
+TAG_FLAG(master_catalog_response_cache_size, advanced);
+
 namespace yb {
 namespace master {
 
@@ -436,6 +448,13 @@ YQLDatabase GetDatabaseTypeForTable(const TableType table_type) {
   return YQL_DATABASE_UNKNOWN;
 }
 
+// Table level placement is supported only for transaction status tables, that are kept in
+// the region of their clients.
+bool HasTablePlacement(TableType table_type, const ReplicationInfoPB& replication_info) {
+  return table_type == TableType::TRANSACTION_STATUS_TABLE_TYPE &&
+         !replication_info.live_replicas().placement_blocks().empty();
+}
+
 }  // anonymous namespace
 
 CatalogManager::CatalogManager(Master* master)
@@ -446,6 +465,9 @@ CatalogManager::CatalogManager(Master* master)
       leader_ready_term_(-1),
       leader_lock_(RWMutex::Priority::PREFER_WRITING),
       load_balance_policy_(new enterprise::ClusterLoadBalancer(this)),
+      table_locations_cache_(FLAGS_master_catalog_response_cache_size),
+      tablet_locations_cache_(FLAGS_master_catalog_response_cache_size),
+      table_schema_cache_(FLAGS_master_catalog_response_cache_size),
       permissions_manager_(std::make_unique<PermissionsManager>(this)),
       tasks_tracker_(new TasksTracker()) {
   yb::InitCommonFlags();
@@ -687,6 +709,9 @@ Status CatalogManager::VisitSysCatalog(int64_t term) {
 }
 
 Status CatalogManager::RunLoaders() {
+  // Entities are recreated below, so responses built from the old ones should not be served.
+  BumpCatalogEntitiesVersion();
+
   // Clear the table and tablet state.
   table_names_map_.clear();
   table_ids_map_.clear();
@@ -1371,6 +1396,45 @@ Status CatalogManager::ValidateTableReplicationInfo(const ReplicationInfoPB& rep
   return Status::OK();
 }
 
+Status CatalogManager::ValidateTablePlacementInfo(const ReplicationInfoPB& replication_info,
+                                                  const TSDescriptorVector& ts_descs) {
+  if (!replication_info.read_replicas().empty() ||
+      !replication_info.affinitized_leaders().empty()) {
+    return STATUS(InvalidArgument,
+                  "Unsupported: read replicas and leader affinity in table level placement");
+  }
+  const auto& placement_info = replication_info.live_replicas();
+  const int num_replicas = GetNumReplicasFromPlacementInfo(placement_info);
+  int minimum_sum = 0;
+  for (const auto& pb : placement_info.placement_blocks()) {
+    if (!pb.has_cloud_info()) {
+      return STATUS_FORMAT(InvalidArgument, "Got placement info without cloud info set: $0",
+                           pb.ShortDebugString());
+    }
+    if (pb.min_num_replicas() <= 0) {
+      return STATUS_FORMAT(InvalidArgument, "Placement block should have positive minimum "
+                           "number of replicas: $0", pb.ShortDebugString());
+    }
+    minimum_sum += pb.min_num_replicas();
+    const auto num_matching_tservers = std::count_if(
+        ts_descs.begin(), ts_descs.end(), [&pb](const TSDescriptorPtr& ts_desc) {
+          return ts_desc->MatchesCloudInfo(pb.cloud_info());
+        });
+    if (num_matching_tservers < pb.min_num_replicas()) {
+      return STATUS_FORMAT(
+          InvalidArgument, "Not enough live tablet servers in $0: $1, while $2 required",
+          TSDescriptor::generate_placement_id(pb.cloud_info()), num_matching_tservers,
+          pb.min_num_replicas());
+    }
+  }
+  if (minimum_sum > num_replicas) {
+    return STATUS_FORMAT(
+        InvalidArgument, "Sum of minimum replicas per placement ($0) is greater than num_replicas "
+        "($1)", minimum_sum, num_replicas);
+  }
+  return Status::OK();
+}
+
 Status CatalogManager::AddIndexInfoToTable(const scoped_refptr<TableInfo>& indexed_table,
                                            const IndexInfoPB& index_info) {
   TRACE("Locking indexed table");
@@ -1858,10 +1922,20 @@ Status CatalogManager::CreateTable(const CreateTableRequestPB* orig_req,
     DFATAL_OR_RETURN_NOT_OK(STATUS(InvalidArgument, "Invalid partition method"));
   }
 
-  // Validate the table placement rules are a subset of the cluster ones.
-  s = ValidateTableReplicationInfo(req.replication_info());
-  if (PREDICT_FALSE(!s.ok())) {
-    return SetupError(resp->mutable_error(), MasterErrorPB::INVALID_SCHEMA, s);
+  if (HasTablePlacement(req.table_type(), req.replication_info())) {
+    TSDescriptorVector ts_descs;
+    master_->ts_manager()->GetAllLiveDescriptors(&ts_descs);
+    s = ValidateTablePlacementInfo(req.replication_info(), ts_descs);
+    if (PREDICT_FALSE(!s.ok())) {
+      return SetupError(resp->mutable_error(), MasterErrorPB::INVALID_SCHEMA, s);
+    }
+    replication_info = req.replication_info();
+  } else {
+    // Validate the table placement rules are a subset of the cluster ones.
+    s = ValidateTableReplicationInfo(req.replication_info());
+    if (PREDICT_FALSE(!s.ok())) {
+      return SetupError(resp->mutable_error(), MasterErrorPB::INVALID_SCHEMA, s);
+    }
   }
 
   // For index table, populate the index info.
@@ -2154,8 +2228,19 @@ Status CatalogManager::CreateTableInMemory(const CreateTableRequestPB& req,
 }
 
 Status CatalogManager::CreateTransactionsStatusTableIfNeeded(rpc::RpcContext *rpc) {
+  RETURN_NOT_OK(CreateTransactionsStatusTableIfNeeded(
+      kTransactionsTableName, nullptr /* replication_info */, rpc));
+  if (FLAGS_auto_create_local_transaction_tables) {
+    RETURN_NOT_OK(CreateLocalTransactionsStatusTablesIfNeeded(rpc));
+  }
+  return Status::OK();
+}
+
+Status CatalogManager::CreateTransactionsStatusTableIfNeeded(
+    const TableName& table_name, const ReplicationInfoPB* replication_info,
+    rpc::RpcContext *rpc) {
   TableIdentifierPB table_indentifier;
-  table_indentifier.set_table_name(kTransactionsTableName);
+  table_indentifier.set_table_name(table_name);
   table_indentifier.mutable_namespace_()->set_name(kSystemNamespaceName);
 
   // Check that the namespace exists.
@@ -2173,9 +2258,12 @@ Status CatalogManager::CreateTransactionsStatusTableIfNeeded(rpc::RpcContext *rp
     // Set up a CreateTable request internally.
     CreateTableRequestPB req;
     CreateTableResponsePB resp;
-    req.set_name(kTransactionsTableName);
+    req.set_name(table_name);
     req.mutable_namespace_()->set_name(kSystemNamespaceName);
     req.set_table_type(TableType::TRANSACTION_STATUS_TABLE_TYPE);
+    if (replication_info) {
+      *req.mutable_replication_info() = *replication_info;
+    }
 
     // Explicitly set the number tablets if the corresponding flag is set, otherwise CreateTable
     // will use the same defaults as for regular tables.
@@ -2196,6 +2284,72 @@ Status CatalogManager::CreateTransactionsStatusTableIfNeeded(rpc::RpcContext *rp
   return Status::OK();
 }
 
+Status CatalogManager::CreateLocalTransactionsStatusTablesIfNeeded(rpc::RpcContext *rpc) {
+  PlacementInfoPB cluster_placement;
+  {
+    auto l = cluster_config_->LockForRead();
+    cluster_placement = l->data().pb.replication_info().live_replicas();
+  }
+  const int num_replicas = GetNumReplicasFromPlacementInfo(cluster_placement);
+
+  TSDescriptorVector ts_descs;
+  master_->ts_manager()->GetAllLiveDescriptorsInCluster(
+      &ts_descs, cluster_placement.placement_uuid());
+
+  // Number of live tablet servers in each zone, grouped by cloud and region.
+  std::map<std::pair<std::string, std::string>, std::map<std::string, int>> regions;
+  for (const auto& ts_desc : ts_descs) {
+    const auto& cloud_info = ts_desc->GetRegistration().common().cloud_info();
+    ++regions[{cloud_info.placement_cloud(), cloud_info.placement_region()}][
+        cloud_info.placement_zone()];
+  }
+
+  for (const auto& region_and_zones : regions) {
+    const auto& zones = region_and_zones.second;
+    // Spread replicas over zones of the region, as evenly as tablet servers allow.
+    std::map<std::string, int> replicas_per_zone;
+    int assigned = 0;
+    bool progress = true;
+    while (assigned < num_replicas && progress) {
+      progress = false;
+      for (const auto& zone_and_servers : zones) {
+        auto& replicas = replicas_per_zone[zone_and_servers.first];
+        if (assigned < num_replicas && replicas < zone_and_servers.second) {
+          ++replicas;
+          ++assigned;
+          progress = true;
+        }
+      }
+    }
+
+    CloudInfoPB cloud_info;
+    cloud_info.set_placement_cloud(region_and_zones.first.first);
+    cloud_info.set_placement_region(region_and_zones.first.second);
+    if (assigned < num_replicas) {
+      VLOG(1) << "Not enough live tablet servers to create local transaction status table in "
+              << cloud_info.ShortDebugString() << ": " << assigned;
+      continue;
+    }
+
+    ReplicationInfoPB replication_info;
+    auto* placement = replication_info.mutable_live_replicas();
+    placement->set_num_replicas(num_replicas);
+    placement->set_placement_uuid(cluster_placement.placement_uuid());
+    for (const auto& zone_and_replicas : replicas_per_zone) {
+      if (zone_and_replicas.second == 0) {
+        continue;
+      }
+      auto* block = placement->add_placement_blocks();
+      *block->mutable_cloud_info() = cloud_info;
+      block->mutable_cloud_info()->set_placement_zone(zone_and_replicas.first);
+      block->set_min_num_replicas(zone_and_replicas.second);
+    }
+    RETURN_NOT_OK(CreateTransactionsStatusTableIfNeeded(
+        LocalTransactionsTableName(cloud_info), &replication_info, rpc));
+  }
+  return Status::OK();
+}
+
 Status CatalogManager::CreateMetricsSnapshotsTableIfNeeded(rpc::RpcContext *rpc) {
   TableIdentifierPB table_indentifier;
   table_indentifier.set_table_name(kMetricsSnapshotsTableName);
@@ -2382,6 +2536,9 @@ scoped_refptr<TableInfo> CatalogManager::CreateTableInfo(const CreateTableReques
   metadata->set_version(0);
   metadata->set_next_column_id(ColumnId(schema.max_col_id() + 1));
   // TODO(bogdan): add back in replication_info once we allow overrides!
+  if (HasTablePlacement(req.table_type(), req.replication_info())) {
+    *metadata->mutable_replication_info() = req.replication_info();
+  }
   // Use the Schema object passed in, since it has the column IDs already assigned,
   // whereas the user request PB does not.
   SchemaToPB(schema, metadata->mutable_schema());
@@ -3223,6 +3380,19 @@ Status CatalogManager::GetTableSchema(const GetTableSchemaRequestPB* req,
 
   RETURN_NOT_OK(CheckOnline());
 
+  const bool use_cache = FLAGS_master_catalog_response_cache_size > 0;
+  const auto version = CatalogEntitiesVersion();
+  std::string cache_key;
+  if (use_cache) {
+    cache_key = req->table().SerializeAsString();
+    auto cached = table_schema_cache_.Get(cache_key, version);
+    if (cached) {
+      TRACE("Found cached schema");
+      resp->CopyFrom(*cached);
+      return Status::OK();
+    }
+  }
+
   scoped_refptr<TableInfo> table;
 
   // Lookup the table and verify if it exists.
@@ -3279,6 +3449,10 @@ Status CatalogManager::GetTableSchema(const GetTableSchemaRequestPB* req,
   }
 
   resp->mutable_identifier()->mutable_namespace_()->set_name(ns->name());
+  // Table creation state is not tracked by catalog entities version.
+  if (use_cache && resp->create_table_done()) {
+    table_schema_cache_.Put(cache_key, version, *resp);
+  }
   return Status::OK();
 }
 
@@ -3562,10 +3736,24 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
   // the server should have, compare vs the ones being reported, and somehow mark
   // any that have been "lost" (eg somehow the tablet metadata got corrupted or something).
 
-  for (const ReportedTabletPB& reported : report.updated_tablets()) {
+  RETURN_NOT_OK_PREPEND(CheckIsLeaderAndReady(),
+      "This master is no longer the leader, unable to handle tablet report");
+
+  // Look up all reported tablets with a single acquisition of the catalog lock.
+  std::vector<scoped_refptr<TabletInfo>> tablets;
+  tablets.reserve(report.updated_tablets_size());
+  {
+    boost::shared_lock<LockType> l(lock_);
+    for (const ReportedTabletPB& reported : report.updated_tablets()) {
+      tablets.push_back(FindPtrOrNull(tablet_map_, reported.tablet_id()));
+    }
+  }
+
+  for (int i = 0; i != report.updated_tablets_size(); ++i) {
+    const ReportedTabletPB& reported = report.updated_tablets(i);
     ReportedTabletUpdatesPB *tablet_report = report_update->add_tablets();
     tablet_report->set_tablet_id(reported.tablet_id());
-    RETURN_NOT_OK_PREPEND(HandleReportedTablet(ts_desc, reported, tablet_report,
+    RETURN_NOT_OK_PREPEND(HandleReportedTablet(ts_desc, reported, tablets[i], tablet_report,
                           report.is_incremental()),
                           Substitute("Error handling $0", reported.ShortDebugString()));
   }
@@ -3608,20 +3796,50 @@ bool ShouldTransitionTabletToRunning(const ReportedTabletPB& report) {
 }
 }  // anonymous namespace
 
+Result<bool> CatalogManager::HandleUnchangedReportedTablet(
+    TSDescriptor* ts_desc,
+    const ReportedTabletPB& report,
+    const scoped_refptr<TabletInfo>& tablet,
+    ReportedTabletUpdatesPB* report_updates) {
+  auto table_lock = tablet->table()->LockForRead();
+  auto tablet_lock = tablet->LockForRead();
+  if (tablet_lock->data().is_deleted() || table_lock->data().started_deleting() ||
+      (report.has_schema_version() && report.schema_version() != table_lock->data().pb.version())) {
+    // Let the regular path send delete or alter requests.
+    return false;
+  }
+
+  TabletInfo::ReplicaMap replicas;
+  tablet->GetReplicaLocations(&replicas);
+  auto it = replicas.find(ts_desc->permanent_uuid());
+  if (!table_lock->data().is_running() || !tablet_lock->data().is_running() ||
+      it == replicas.end() || it->second.state != tablet::RUNNING) {
+    // We don't know enough about this replica to act without its consensus state.
+    VLOG(1) << "Requesting consensus state of tablet " << tablet->tablet_id() << " from "
+            << ts_desc->permanent_uuid();
+    report_updates->set_needs_consensus_state(true);
+    return true;
+  }
+
+  if (report.has_schema_version()) {
+    if (table_lock->data().pb.state() == SysTablesEntryPB::ALTERING) {
+      table_lock->Unlock();
+      tablet_lock->Unlock();
+      RETURN_NOT_OK(HandleTabletSchemaVersionReport(tablet.get(), report.schema_version()));
+    } else {
+      tablet->set_reported_schema_version(report.schema_version());
+    }
+  }
+  return true;
+}
+
 Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
                                             const ReportedTabletPB& report,
+                                            const scoped_refptr<TabletInfo>& tablet,
                                             ReportedTabletUpdatesPB *report_updates,
                                             bool is_incremental) {
   TRACE_EVENT1("master", "HandleReportedTablet",
                "tablet_id", report.tablet_id());
-  scoped_refptr<TabletInfo> tablet;
-  {
-    boost::shared_lock<LockType> l(lock_);
-    tablet = FindPtrOrNull(tablet_map_, report.tablet_id());
-  }
-  RETURN_NOT_OK_PREPEND(CheckIsLeaderAndReady(),
-      Substitute("This master is no longer the leader, unable to handle report for tablet $0",
-                 report.tablet_id()));
   if (!tablet) {
     LOG(INFO) << "Got report from unknown tablet " << report.tablet_id()
               << ": Sending delete request for this orphan tablet";
@@ -3637,6 +3855,14 @@ Status CatalogManager::HandleReportedTablet(TSDescriptor* ts_desc,
   }
   VLOG(3) << "tablet report: " << report.ShortDebugString();
 
+  // Tablet server omits consensus state of RUNNING tablets when it did not change, such reports
+  // are handled under read locks.
+  if (is_incremental && report.state() == tablet::RUNNING && !report.has_error() &&
+      !report.has_committed_consensus_state() &&
+      VERIFY_RESULT(HandleUnchangedReportedTablet(ts_desc, report, tablet, report_updates))) {
+    return Status::OK();
+  }
+
   // TODO: we don't actually need to do the COW here until we see we're going
   // to change the state. Can we change CowedObject to lazily do the copy?
   auto table_lock = tablet->table()->LockForRead();
@@ -5314,12 +5540,15 @@ Status CatalogManager::SelectReplicasForTablet(const TSDescriptorVector& ts_desc
         tablet->tablet_id());
   }
 
-  // Validate that we do not have placement blocks in both cluster and table data.
-  RETURN_NOT_OK(ValidateTableReplicationInfo(table_guard->data().pb.replication_info()));
-
-  // Default to the cluster placement object.
   ReplicationInfoPB replication_info;
-  {
+  const auto& table_pb = table_guard->data().pb;
+  if (HasTablePlacement(table_pb.table_type(), table_pb.replication_info())) {
+    replication_info = table_pb.replication_info();
+  } else {
+    // Validate that we do not have placement blocks in both cluster and table data.
+    RETURN_NOT_OK(ValidateTableReplicationInfo(table_pb.replication_info()));
+
+    // Default to the cluster placement object.
     auto l = cluster_config_->LockForRead();
     replication_info = l->data().pb.replication_info();
   }
@@ -5674,6 +5903,18 @@ Result<shared_ptr<tablet::AbstractTablet>> CatalogManager::GetSystemTablet(const
 Status CatalogManager::GetTabletLocations(const TabletId& tablet_id, TabletLocationsPB* locs_pb) {
   RETURN_NOT_OK(CheckOnline());
 
+  // Locations of system tablets come from the master Raft config, that is not versioned.
+  const bool use_cache =
+      FLAGS_master_catalog_response_cache_size > 0 && !system_tablets_.count(tablet_id);
+  const auto version = CatalogEntitiesVersion();
+  if (use_cache) {
+    auto cached = tablet_locations_cache_.Get(tablet_id, version);
+    if (cached) {
+      locs_pb->CopyFrom(*cached);
+      return Status::OK();
+    }
+  }
+
   locs_pb->mutable_replicas()->Clear();
   scoped_refptr<TabletInfo> tablet_info;
   {
@@ -5692,6 +5933,9 @@ Status CatalogManager::GetTabletLocations(const TabletId& tablet_id, TabletLocat
         << locs_pb->replicas().size() << " for tablet " << tablet_id;
   }
 
+  if (s.ok() && use_cache) {
+    tablet_locations_cache_.Put(tablet_id, version, *locs_pb);
+  }
   return s;
 }
 
@@ -5710,6 +5954,19 @@ Status CatalogManager::GetTableLocations(const GetTableLocationsRequestPB* req,
     return STATUS(InvalidArgument, "max_returned_locations must be greater than 0");
   }
 
+  const bool use_cache = FLAGS_master_catalog_response_cache_size > 0;
+  const auto version = CatalogEntitiesVersion();
+  std::string cache_key;
+  if (use_cache) {
+    cache_key = req->SerializeAsString();
+    auto cached = table_locations_cache_.Get(cache_key, version);
+    if (cached) {
+      TRACE("Found cached locations");
+      resp->CopyFrom(*cached);
+      return Status::OK();
+    }
+  }
+
   scoped_refptr<TableInfo> table;
   RETURN_NOT_OK(FindTable(req->table(), &table));
 
@@ -5725,7 +5982,12 @@ Status CatalogManager::GetTableLocations(const GetTableLocationsRequestPB* req,
   table->GetTabletsInRange(req, &tablets_in_range);
 
   bool require_tablets_runnings = req->require_tablets_running();
+  // Locations of system tablets come from the master Raft config, that is not versioned.
+  bool cacheable = use_cache;
   for (const scoped_refptr<TabletInfo>& tablet : tablets_in_range) {
+    if (system_tablets_.count(tablet->id())) {
+      cacheable = false;
+    }
     auto status = BuildLocationsForTablet(tablet, resp->add_tablet_locations());
     if (!status.ok()) {
       // Not running.
@@ -5738,6 +6000,9 @@ Status CatalogManager::GetTableLocations(const GetTableLocationsRequestPB* req,
   }
 
   resp->set_table_type(table->metadata().state().pb.table_type());
+  if (cacheable) {
+    table_locations_cache_.Put(cache_key, version, *resp);
+  }
   return Status::OK();
 }
 
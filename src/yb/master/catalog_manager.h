@@ -68,6 +68,7 @@
 #include "yb/util/status.h"
 #include "yb/gutil/thread_annotations.h"
 #include "yb/master/catalog_entity_info.h"
+#include "yb/master/catalog_response_cache.h"
 #include "yb/master/scoped_leader_shared_lock.h"
 #include "yb/master/permissions_manager.h"
 #include "yb/master/initial_sys_catalog_snapshot.h"
@@ -584,6 +585,15 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   FRIEND_TEST(SysCatalogTest, TestSysCatalogTabletsOperations);
   FRIEND_TEST(SysCatalogTest, TestTableInfoCommit);
 
+  // Create transaction status table with specified name and placement, if it does not exist.
+  CHECKED_STATUS CreateTransactionsStatusTableIfNeeded(
+      const TableName& table_name, const ReplicationInfoPB* replication_info,
+      rpc::RpcContext *rpc);
+
+  // Create transaction status table for each region, that has enough live tablet servers to
+  // host all replicas of the table.
+  CHECKED_STATUS CreateLocalTransactionsStatusTablesIfNeeded(rpc::RpcContext *rpc);
+
   // Called by SysCatalog::SysCatalogStateChanged when this node
   // becomes the leader of a consensus configuration.
   //
@@ -717,9 +727,17 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Requires that the lock is already held.
   CHECKED_STATUS HandleReportedTablet(TSDescriptor* ts_desc,
                                       const ReportedTabletPB& report,
+                                      const scoped_refptr<TabletInfo>& tablet,
                                       ReportedTabletUpdatesPB* report_updates,
                                       bool is_incremental);
 
+  // Handles report of a RUNNING tablet whose consensus state did not change since the last report,
+  // without taking write locks. Returns false if the report should go through the regular path.
+  Result<bool> HandleUnchangedReportedTablet(TSDescriptor* ts_desc,
+                                             const ReportedTabletPB& report,
+                                             const scoped_refptr<TabletInfo>& tablet,
+                                             ReportedTabletUpdatesPB* report_updates);
+
   CHECKED_STATUS ResetTabletReplicasFromReportedConfig(const ReportedTabletPB& report,
                                                        const scoped_refptr<TabletInfo>& tablet,
                                                        TabletInfo::lock_type* tablet_lock,
@@ -900,6 +918,12 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // example, if the cluster is confined to AWS, you cannot have tables in GCE.
   CHECKED_STATUS ValidateTableReplicationInfo(const ReplicationInfoPB& replication_info);
 
+  // Validates table level placement, that is allowed for some system tables, the same way as
+  // cluster level placement: minimum replicas of all placement blocks should fit into the number
+  // of replicas, and each block should have enough live tablet servers.
+  CHECKED_STATUS ValidateTablePlacementInfo(const ReplicationInfoPB& replication_info,
+                                            const TSDescriptorVector& ts_descs);
+
   // Report metrics.
   void ReportMetrics();
 
@@ -1070,6 +1094,12 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Tablets of system tables on the master indexed by the tablet id.
   std::unordered_map<std::string, std::shared_ptr<tablet::AbstractTablet>> system_tablets_;
 
+  // Responses of catalog reads, valid while catalog entities version does not change.
+  CatalogResponseCache<GetTableLocationsResponsePB> table_locations_cache_;
+  // Locations of a single tablet, keyed by tablet id.
+  CatalogResponseCache<TabletLocationsPB> tablet_locations_cache_;
+  CatalogResponseCache<GetTableSchemaResponsePB> table_schema_cache_;
+
   boost::optional<std::future<Status>> initdb_future_;
   boost::optional<InitialSysCatalogSnapshotWriter> initial_snapshot_writer_;
 
@@ -0,0 +1,70 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_MASTER_CATALOG_RESPONSE_CACHE_H
+#define YB_MASTER_CATALOG_RESPONSE_CACHE_H
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "yb/util/locks.h"
+
+namespace yb {
+namespace master {
+
+// Caches responses of catalog read RPCs keyed by serialized request.
+// Each response is stamped with the catalog entities version it was built from, and is served
+// only while that version is still current.
+template <class Response>
+class CatalogResponseCache {
+ public:
+  explicit CatalogResponseCache(size_t max_entries) : max_entries_(max_entries) {}
+
+  // Returns response cached for key at the specified version, or nullptr.
+  std::shared_ptr<const Response> Get(const std::string& key, uint64_t version) const {
+    std::shared_lock<rw_spinlock> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.version != version) {
+      return nullptr;
+    }
+    return it->second.response;
+  }
+
+  void Put(const std::string& key, uint64_t version, const Response& response) {
+    auto entry = std::make_shared<const Response>(response);
+    std::lock_guard<rw_spinlock> lock(mutex_);
+    if (entries_.size() >= max_entries_ && !entries_.count(key)) {
+      // All entries are usually stale at the same time, since version is shared.
+      entries_.clear();
+    }
+    entries_[key] = Entry{version, std::move(entry)};
+  }
+
+ private:
+  struct Entry {
+    uint64_t version;
+    std::shared_ptr<const Response> response;
+  };
+
+  const size_t max_entries_;
+  mutable rw_spinlock mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+} // namespace master
+} // namespace yb
+
+#endif // YB_MASTER_CATALOG_RESPONSE_CACHE_H
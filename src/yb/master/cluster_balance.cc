@@ -14,6 +14,8 @@
 #include "yb/master/cluster_balance.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 
 #include <boost/thread/locks.hpp>
@@ -63,6 +65,26 @@ DEFINE_int32(load_balancer_max_concurrent_moves,
              "Maximum number of tablet leaders on tablet servers to move in any one run of the "
              "load balancer.");
 
+DEFINE_double(load_balancer_tablet_size_weight,
+              1.0,
+              "Weight of the reported SST file size of a tablet, relative to the weight of its "
+              "replica count, when the load balancer computes load of tablet servers. "
+              "0 to ignore tablet sizes.");
+TAG_FLAG(load_balancer_tablet_size_weight, advanced);
+
+DEFINE_double(load_balancer_tablet_ops_weight,
+              1.0,
+              "Weight of the read and write rates reported by a tablet leader, relative to the "
+              "weight of its replica count, when the load balancer computes load of tablet "
+              "servers and leader load. 0 to ignore tablet traffic.");
+TAG_FLAG(load_balancer_tablet_ops_weight, advanced);
+
+DEFINE_double(load_balancer_max_target_cpu_usage,
+              0.9,
+              "Load balancer does not move replicas to a tablet server whose reported CPU usage, "
+              "as a fraction of the machine CPU, is above this value. 1 to disable.");
+TAG_FLAG(load_balancer_max_target_cpu_usage, advanced);
+
 DEFINE_int32(load_balancer_num_idle_runs,
              5,
              "Number of idle runs of load balancer to deem it idle.");
@@ -384,8 +406,9 @@ Status ClusterLoadBalancer::AnalyzeTablets(const TableId& table_uuid) {
   // low for the given configuration.
   state_->AdjustLeaderBalanceThreshold();
 
-  // Once we've analyzed both the tablet server information as well as the tablets, we can sort the
-  // load and are ready to apply the load balancing rules.
+  // Once we've analyzed both the tablet server information as well as the tablets, we can compute
+  // and sort the load and are ready to apply the load balancing rules.
+  state_->ComputeLoads();
   state_->SortLoad();
 
   // Since leader load is only needed to rebalance leaders, we keep the sorting separate.
@@ -528,7 +551,7 @@ void ClusterLoadBalancer::DumpSortedLoad() const {
   out << "Table load: ";
   for (int left = 0; left <= last_pos; ++left) {
     const TabletServerId& uuid = state_->sorted_load_[left];
-    int load = state_->GetLoad(uuid);
+    double load = state_->GetLoad(uuid);
     out << uuid << ":" << load << " ";
   }
   VLOG(1) << out.str();
@@ -565,7 +588,7 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
     for (int right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_load_[right];
-      int load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
+      double load_variance = state_->GetLoad(high_load_uuid) - state_->GetLoad(low_load_uuid);
 
       // Check for state change or end conditions.
       if (left == right || load_variance < state_->options_->kMinLoadVarianceToBalance) {
@@ -578,6 +601,11 @@ Result<bool> ClusterLoadBalancer::GetLoadToMove(
         }
       }
 
+      // Do not add load to a tablet server that is already running hot.
+      if (state_->IsCpuOverloaded(low_load_uuid)) {
+        break;
+      }
+
       // If we don't find a tablet_id to move between these two TSs, advance the state.
       if (VERIFY_RESULT(GetTabletToMove(high_load_uuid, low_load_uuid, moving_tablet_id))) {
         // If we got this far, we have the candidate we want, so fill in the output params and
@@ -642,6 +670,12 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
 
   bool same_placement = state_->per_ts_meta_[from_ts].descriptor->placement_id() ==
                         state_->per_ts_meta_[to_ts].descriptor->placement_id();
+  // Pick the tablet whose weight is closest to half of the load difference, so the move evens out
+  // the two tablet servers best. Tablets that are heavier than the difference are skipped, since
+  // moving them would only swap which server is overloaded.
+  const double load_diff = state_->GetLoad(from_ts) - state_->GetLoad(to_ts);
+  double best_distance = std::numeric_limits<double>::max();
+  bool found = false;
   for (const auto& tablet_id : non_over_replicated_tablets) {
     const auto& placement_info = GetPlacementByTablet(tablet_id);
     // TODO(bogdan): this should be augmented as well to allow dropping by one replica, if still
@@ -659,13 +693,20 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
       continue;
     }
     // If we got here, it means we either have no placement, in which case we can pick any TS, or
-    // we have placement and it's valid to move across these two tablet servers, so set the tablet
-    // and leave.
-    *moving_tablet_id = tablet_id;
-    return true;
+    // we have placement and it's valid to move across these two tablet servers.
+    const double weight = state_->GetReplicaMoveWeight(tablet_id, from_ts);
+    if (weight >= load_diff) {
+      continue;
+    }
+    const double distance = std::abs(weight - load_diff / 2);
+    if (distance < best_distance) {
+      best_distance = distance;
+      *moving_tablet_id = tablet_id;
+      found = true;
+    }
   }
   // If we couldn't select a tablet above, we have to return failure.
-  return false;
+  return found;
 }
 
 Result<bool> ClusterLoadBalancer::GetLeaderToMove(
@@ -702,7 +743,7 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
     for (int right = last_pos; right >= 0; --right) {
       const TabletServerId& low_load_uuid = state_->sorted_leader_load_[left];
       const TabletServerId& high_load_uuid = state_->sorted_leader_load_[right];
-      int load_variance =
+      double load_variance =
           state_->GetLeaderLoad(high_load_uuid) - state_->GetLeaderLoad(low_load_uuid);
 
       // Check for state change or end conditions.
@@ -718,16 +759,24 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
 
       // Find the leaders on the higher loaded TS that have running peers on the lower loaded TS.
       // If there are, we have a candidate we want, so fill in the output params and return.
+      // As with tablets, pick the leader whose weight is closest to half of the load difference
+      // and skip leaders heavier than the difference.
       const set<TabletId>& leaders = state_->per_ts_meta_[high_load_uuid].leaders;
       const set<TabletId>& peers = state_->per_ts_meta_[low_load_uuid].running_tablets;
       set<TabletId> intersection;
       const auto& itr = std::inserter(intersection, intersection.begin());
       std::set_intersection(leaders.begin(), leaders.end(), peers.begin(), peers.end(), itr);
 
+      double best_distance = std::numeric_limits<double>::max();
       for (const auto& tablet_id : intersection) {
-        *moving_tablet_id = tablet_id;
-        *from_ts = high_load_uuid;
-        *to_ts = low_load_uuid;
+        const double weight = state_->GetLeaderWeight(tablet_id);
+        if (weight >= load_variance) {
+          continue;
+        }
+        const double distance = std::abs(weight - load_variance / 2);
+        if (distance >= best_distance) {
+          continue;
+        }
 
         const auto& per_tablet_meta = state_->per_tablet_meta_;
         const auto tablet_meta_iter = per_tablet_meta.find(tablet_id);
@@ -739,7 +788,8 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
             const auto time_since_failure = current_time - stepdown_failure_iter->second;
             if (time_since_failure.ToMilliseconds() < FLAGS_min_leader_stepdown_retry_interval_ms) {
               LOG(INFO) << "Cannot move tablet " << tablet_id << " leader from TS "
-                        << *from_ts << " to TS " << *to_ts << " yet: previous attempt with the same"
+                        << high_load_uuid << " to TS " << low_load_uuid
+                        << " yet: previous attempt with the same"
                         << " intended leader failed only " << ToString(time_since_failure)
                         << " ago (less " << "than " << FLAGS_min_leader_stepdown_retry_interval_ms
                         << "ms).";
@@ -747,8 +797,14 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
             continue;
           }
         } else {
-          LOG(WARNING) << "Did not find load balancer metadata for tablet " << *moving_tablet_id;
+          LOG(WARNING) << "Did not find load balancer metadata for tablet " << tablet_id;
         }
+        best_distance = distance;
+        *moving_tablet_id = tablet_id;
+        *from_ts = high_load_uuid;
+        *to_ts = low_load_uuid;
+      }
+      if (best_distance != std::numeric_limits<double>::max()) {
         return true;
       }
     }
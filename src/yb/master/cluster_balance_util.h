@@ -16,6 +16,7 @@
 
 #include <unordered_set>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
@@ -48,6 +49,12 @@ DECLARE_int32(load_balancer_max_concurrent_removals);
 
 DECLARE_int32(load_balancer_max_concurrent_moves);
 
+DECLARE_double(load_balancer_tablet_size_weight);
+
+DECLARE_double(load_balancer_tablet_ops_weight);
+
+DECLARE_double(load_balancer_max_target_cpu_usage);
+
 namespace yb {
 namespace master {
 
@@ -116,6 +123,17 @@ struct CBTabletMetadata {
   // Leader stepdown failures. We use this to prevent retrying the same leader stepdown too soon.
   LeaderStepDownFailureTimes leader_stepdown_failures;
 
+  // Largest SST file size reported by the replicas of this tablet.
+  uint64_t sst_file_size = 0;
+  // Read plus write rate reported by the leader. Followers do not serve this traffic.
+  double ops_per_sec = 0;
+
+  // Load added to a tablet server by hosting a replica of this tablet, by serving the traffic of
+  // its leader and by being its leader for leader balancing. See ComputeLoads.
+  double replica_weight = 1;
+  double traffic_weight = 0;
+  double leader_weight = 1;
+
   std::string ToString() const {
     return Format("{ running: $0 starting: $1 is_under_replicated: $2 "
                       "under_replicated_placements: $3 is_over_replicated: $4 "
@@ -141,6 +159,13 @@ struct CBTabletServerMetadata {
 
   // The set of tablet leader ids that this tablet server is currently running.
   std::set<TabletId> leaders;
+
+  // CPU usage reported by this tablet server, as of the start of the load balancer run.
+  double cpu_usage = 0;
+
+  // Weighted replica and leader loads, kept up to date with the planned moves.
+  double load = 0;
+  double leader_load = 0;
 };
 
 struct Options {
@@ -175,6 +200,14 @@ struct Options {
   // Max number of tablet leaders on tablet servers to move in any one run of the load balancer.
   int kMaxConcurrentLeaderMoves = FLAGS_load_balancer_max_concurrent_moves;
 
+  // Weights of the tablet size and tablet traffic in the load of a tablet server, relative to the
+  // weight of the replica count.
+  double kTabletSizeWeight = FLAGS_load_balancer_tablet_size_weight;
+  double kTabletOpsWeight = FLAGS_load_balancer_tablet_ops_weight;
+
+  // Max CPU usage of a tablet server that could receive new replicas during load balancing.
+  double kMaxTargetCpuUsage = FLAGS_load_balancer_max_target_cpu_usage;
+
   // TODO(bogdan): add state for leaders starting remote bootstraps, to limit on that end too.
 };
 
@@ -187,10 +220,12 @@ class ClusterLoadState {
 
   // Comparators used for sorting by load.
   bool CompareByUuid(const TabletServerId& a, const TabletServerId& b) {
-    int load_a = GetLoad(a);
-    int load_b = GetLoad(b);
+    double load_a = GetLoad(a);
+    double load_b = GetLoad(b);
     if (load_a == load_b) {
-      return a < b;
+      double cpu_a = per_ts_meta_.at(a).cpu_usage;
+      double cpu_b = per_ts_meta_.at(b).cpu_usage;
+      return cpu_a == cpu_b ? a < b : cpu_a < cpu_b;
     } else {
       return load_a < load_b;
     }
@@ -224,14 +259,80 @@ class ClusterLoadState {
     ClusterLoadState* state_;
   };
 
-  // Get the load for a certain TS.
-  int GetLoad(const TabletServerId& ts_uuid) const {
-    const auto& ts_meta = per_ts_meta_.at(ts_uuid);
-    return ts_meta.starting_tablets.size() + ts_meta.running_tablets.size();
+  // Get the load for a certain TS, i.e. the sum of replica weights of the tablets it hosts plus
+  // traffic weights of the tablets it leads. Without reported tablet metrics this is the number of
+  // tablets.
+  double GetLoad(const TabletServerId& ts_uuid) const {
+    return per_ts_meta_.at(ts_uuid).load;
   }
 
-  // Get the load for a certain TS.
-  int GetLeaderLoad(const TabletServerId& ts_uuid) const {
+  // Load removed from the TS by moving its replica of the tablet away.
+  double GetReplicaMoveWeight(const TabletId& tablet_id, const TabletServerId& ts_uuid) const {
+    const auto& tablet_meta = per_tablet_meta_.at(tablet_id);
+    return tablet_meta.replica_weight +
+           (tablet_meta.leader_uuid == ts_uuid ? tablet_meta.traffic_weight : 0);
+  }
+
+  double GetLeaderWeight(const TabletId& tablet_id) const {
+    auto it = per_tablet_meta_.find(tablet_id);
+    return it == per_tablet_meta_.end() ? 1 : it->second.leader_weight;
+  }
+
+  // Computes tablet weights and the loads of tablet servers. Should be called once all tablets
+  // were added, since weights are relative to the average tablet.
+  //
+  // Tablet size is taken relative to the average tablet and applies to every replica. Traffic is
+  // served by the leader only, so the traffic of all replicas is added to the load of the leader.
+  // Weights are normalized, so the average replica costs 1 and a table without reported metrics is
+  // balanced by tablet count. Leader balancing weighs leaders by their traffic the same way.
+  void ComputeLoads() {
+    const double num_tablets = per_tablet_meta_.size();
+    const bool use_size = options_->kTabletSizeWeight > 0 && total_sst_file_size_ > 0;
+    const bool use_ops = options_->kTabletOpsWeight > 0 && total_ops_per_sec_ > 0;
+    const double size_weight = use_size ? options_->kTabletSizeWeight : 0;
+    const double ops_weight = use_ops ? options_->kTabletOpsWeight : 0;
+    const double total_weight = 1 + size_weight + ops_weight;
+    for (auto& entry : per_tablet_meta_) {
+      auto& tablet_meta = entry.second;
+      const double relative_size =
+          use_size ? tablet_meta.sst_file_size * num_tablets / total_sst_file_size_ : 0;
+      const double relative_ops =
+          use_ops ? tablet_meta.ops_per_sec * num_tablets / total_ops_per_sec_ : 0;
+      tablet_meta.replica_weight = (1 + size_weight * relative_size) / total_weight;
+      tablet_meta.traffic_weight =
+          ops_weight * relative_ops * (tablet_meta.running + tablet_meta.starting) / total_weight;
+      tablet_meta.leader_weight = (1 + ops_weight * relative_ops) / (1 + ops_weight);
+    }
+    for (auto& entry : per_ts_meta_) {
+      auto& ts_meta = entry.second;
+      ts_meta.load = 0;
+      for (const auto& tablet_id : ts_meta.starting_tablets) {
+        ts_meta.load += per_tablet_meta_[tablet_id].replica_weight;
+      }
+      for (const auto& tablet_id : ts_meta.running_tablets) {
+        ts_meta.load += per_tablet_meta_[tablet_id].replica_weight;
+      }
+      ts_meta.leader_load = 0;
+      for (const auto& tablet_id : ts_meta.leaders) {
+        const auto& tablet_meta = per_tablet_meta_[tablet_id];
+        ts_meta.load += tablet_meta.traffic_weight;
+        ts_meta.leader_load += tablet_meta.leader_weight;
+      }
+    }
+  }
+
+  // Whether the TS reports CPU usage above the limit for receiving new replicas.
+  bool IsCpuOverloaded(const TabletServerId& ts_uuid) const {
+    return options_->kMaxTargetCpuUsage < 1 &&
+           per_ts_meta_.at(ts_uuid).cpu_usage > options_->kMaxTargetCpuUsage;
+  }
+
+  // Get the leader load for a certain TS, i.e. the sum of leader weights of the tablets it leads.
+  double GetLeaderLoad(const TabletServerId& ts_uuid) const {
+    return per_ts_meta_.at(ts_uuid).leader_load;
+  }
+
+  int GetLeaderCount(const TabletServerId& ts_uuid) const {
     return per_ts_meta_.at(ts_uuid).leaders.size();
   }
 
@@ -293,7 +394,17 @@ class ClusterLoadState {
       if (blacklisted_servers_.count(ts_uuid)) {
         tablet_meta.blacklisted_tablet_servers.insert(ts_uuid);
       }
+
+      TSDescriptor::TabletLoad tablet_load;
+      if (replica.second.ts_desc->GetTabletLoad(tablet_id, &tablet_load)) {
+        tablet_meta.sst_file_size = std::max(tablet_meta.sst_file_size, tablet_load.sst_file_size);
+        if (replica.second.role == consensus::RaftPeerPB::LEADER) {
+          tablet_meta.ops_per_sec = tablet_load.read_ops_per_sec + tablet_load.write_ops_per_sec;
+        }
+      }
     }
+    total_sst_file_size_ += tablet_meta.sst_file_size;
+    total_ops_per_sec_ += tablet_meta.ops_per_sec;
 
     // Only set the over-replication section if we need to.
     int placement_num_replicas = placement.num_replicas() > 0 ?
@@ -378,6 +489,8 @@ class ClusterLoadState {
     // tablet servers that happen to not be serving any tablets, so were not in the map yet.
     auto& ts_meta = per_ts_meta_[ts_uuid];
     ts_meta.descriptor = ts_desc;
+    // Heartbeats update CPU usage concurrently, so sorting should use a snapshot of it.
+    ts_meta.cpu_usage = ts_desc->cpu_usage();
 
     sorted_load_.push_back(ts_uuid);
 
@@ -519,6 +632,7 @@ class ClusterLoadState {
 
   Status AddReplica(const TabletId& tablet_id, const TabletServerId& to_ts) {
     per_ts_meta_[to_ts].starting_tablets.insert(tablet_id);
+    per_ts_meta_[to_ts].load += per_tablet_meta_[tablet_id].replica_weight;
     ++per_tablet_meta_[tablet_id].starting;
     ++total_starting_;
     tablets_added_.insert(tablet_id);
@@ -529,11 +643,13 @@ class ClusterLoadState {
   Status RemoveReplica(const TabletId& tablet_id, const TabletServerId& from_ts) {
     if (per_ts_meta_[from_ts].running_tablets.count(tablet_id)) {
       per_ts_meta_[from_ts].running_tablets.erase(tablet_id);
+      per_ts_meta_[from_ts].load -= per_tablet_meta_[tablet_id].replica_weight;
       --per_tablet_meta_[tablet_id].running;
       --total_running_;
     }
     if (per_ts_meta_[from_ts].starting_tablets.count(tablet_id)) {
       per_ts_meta_[from_ts].starting_tablets.erase(tablet_id);
+      per_ts_meta_[from_ts].load -= per_tablet_meta_[tablet_id].replica_weight;
       --per_tablet_meta_[tablet_id].starting;
       --total_starting_;
     }
@@ -563,11 +679,21 @@ class ClusterLoadState {
       return STATUS_SUBSTITUTE(IllegalState, "Tablet $0 has leader $1, but $2 expected.",
                                tablet_id, per_tablet_meta_[tablet_id].leader_uuid, from_ts);
     }
-    per_tablet_meta_[tablet_id].leader_uuid = to_ts;
-    per_ts_meta_[from_ts].leaders.erase(tablet_id);
+    auto& tablet_meta = per_tablet_meta_[tablet_id];
+    auto& from_ts_meta = per_ts_meta_[from_ts];
+    tablet_meta.leader_uuid = to_ts;
+    if (from_ts_meta.leaders.erase(tablet_id)) {
+      from_ts_meta.load -= tablet_meta.traffic_weight;
+      from_ts_meta.leader_load -= tablet_meta.leader_weight;
+    }
     if (!to_ts.empty()) {
-      per_ts_meta_[to_ts].leaders.insert(tablet_id);
+      auto& to_ts_meta = per_ts_meta_[to_ts];
+      if (to_ts_meta.leaders.insert(tablet_id).second) {
+        to_ts_meta.load += tablet_meta.traffic_weight;
+        to_ts_meta.leader_load += tablet_meta.leader_weight;
+      }
     }
+    SortLoad();
     SortLeaderLoad();
     return Status::OK();
   }
@@ -579,7 +705,7 @@ class ClusterLoadState {
 
   inline bool IsLeaderLoadBelowThreshold(const TabletServerId& ts_uuid) {
     return ((leader_balance_threshold_ > 0) &&
-            (GetLeaderLoad(ts_uuid) <= leader_balance_threshold_));
+            (GetLeaderCount(ts_uuid) <= leader_balance_threshold_));
   }
 
   void AdjustLeaderBalanceThreshold() {
@@ -621,6 +747,10 @@ class ClusterLoadState {
   // Total number of tablet replicas being started across the cluster.
   int total_starting_ = 0;
 
+  // Sums over tablets of the reported tablet sizes and traffic, used to compute tablet weights.
+  double total_sst_file_size_ = 0;
+  double total_ops_per_sec_ = 0;
+
   // Set of ts_uuid sorted ascending by load. This is the actual raw data of TS load.
   vector<TabletServerId> sorted_load_;
 
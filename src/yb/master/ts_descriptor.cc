@@ -40,6 +40,7 @@
 #include "yb/common/wire_protocol.h"
 #include "yb/consensus/consensus.proxy.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/master/catalog_entity_info.h"
 #include "yb/master/master.pb.h"
 #include "yb/tserver/tserver_admin.proxy.h"
 #include "yb/tserver/tserver_service.proxy.h"
@@ -110,6 +111,8 @@ Status TSDescriptor::RegisterUnlocked(
   ts_information_->mutable_registration()->CopyFrom(registration);
   ts_information_->mutable_tserver_instance()->set_permanent_uuid(permanent_uuid_);
   ts_information_->mutable_tserver_instance()->set_instance_seqno(latest_seqno);
+  // Registration is included in tablet locations returned to clients.
+  BumpCatalogEntitiesVersion();
 
   placement_id_ = generate_placement_id(registration.common().cloud_info());
 
@@ -255,6 +258,24 @@ void TSDescriptor::UpdateMetrics(const TServerMetricsPB& metrics) {
   ts_metrics_.read_ops_per_sec = metrics.read_ops_per_sec();
   ts_metrics_.write_ops_per_sec = metrics.write_ops_per_sec();
   ts_metrics_.uptime_seconds = metrics.uptime_seconds();
+  ts_metrics_.cpu_usage = metrics.cpu_usage();
+  ts_metrics_.tablet_loads.clear();
+  for (const auto& tablet_load : metrics.tablet_loads()) {
+    auto& load = ts_metrics_.tablet_loads[tablet_load.tablet_id()];
+    load.sst_file_size = tablet_load.sst_file_size();
+    load.read_ops_per_sec = tablet_load.read_ops_per_sec();
+    load.write_ops_per_sec = tablet_load.write_ops_per_sec();
+  }
+}
+
+bool TSDescriptor::GetTabletLoad(const std::string& tablet_id, TabletLoad* load) const {
+  std::shared_lock<rw_spinlock> l(lock_);
+  auto it = ts_metrics_.tablet_loads.find(tablet_id);
+  if (it == ts_metrics_.tablet_loads.end()) {
+    return false;
+  }
+  *load = it->second;
+  return true;
 }
 
 bool TSDescriptor::HasTabletDeletePending() const {
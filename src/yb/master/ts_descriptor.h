@@ -37,6 +37,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "yb/gutil/gscoped_ptr.h"
 
@@ -228,6 +229,31 @@ class TSDescriptor {
     return ts_metrics_.uptime_seconds;
   }
 
+  void set_cpu_usage(double cpu_usage) {
+    std::lock_guard<rw_spinlock> l(lock_);
+    ts_metrics_.cpu_usage = cpu_usage;
+  }
+
+  double cpu_usage() {
+    std::shared_lock<rw_spinlock> l(lock_);
+    return ts_metrics_.cpu_usage;
+  }
+
+  // Load of a tablet replica hosted by this tablet server, as reported in the last heartbeat.
+  struct TabletLoad {
+    uint64_t sst_file_size = 0;
+    double read_ops_per_sec = 0;
+    double write_ops_per_sec = 0;
+  };
+
+  void set_tablet_load(const std::string& tablet_id, const TabletLoad& load) {
+    std::lock_guard<rw_spinlock> l(lock_);
+    ts_metrics_.tablet_loads[tablet_id] = load;
+  }
+
+  // Returns false if load of the specified tablet was not reported.
+  bool GetTabletLoad(const std::string& tablet_id, TabletLoad* load) const;
+
   void UpdateMetrics(const TServerMetricsPB& metrics);
 
   void ClearMetrics() {
@@ -292,6 +318,10 @@ class TSDescriptor {
 
     uint64_t uptime_seconds = 0;
 
+    double cpu_usage = 0;
+
+    std::unordered_map<std::string, TabletLoad> tablet_loads;
+
     void ClearMetrics() {
       total_memory_usage = 0;
       total_sst_file_size = 0;
@@ -299,6 +329,8 @@ class TSDescriptor {
       read_ops_per_sec = 0;
       write_ops_per_sec = 0;
       uptime_seconds = 0;
+      cpu_usage = 0;
+      tablet_loads.clear();
     }
   };
 
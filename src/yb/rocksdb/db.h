@@ -26,6 +26,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <functional>
 #include <memory>
 #include <vector>
 #include <string>
@@ -108,6 +109,10 @@ YB_DEFINE_ENUM(FlushAbility, (kNoNewData)(kHasNewData)(kAlreadyFlushing))
 // A collections of table properties objects, where
 //  key: is the table's file name.
 //  value: the table properties object of the given table.
+// Invoked with smallest and largest user keys of each file of imported DB. Import fails if it
+// returns an error.
+typedef std::function<Status(const Slice& smallest, const Slice& largest)> ImportFileValidator;
+
 typedef std::unordered_map<std::string, std::shared_ptr<const TableProperties>>
     TablePropertiesCollection;
 
@@ -798,6 +803,12 @@ class DB {
   // rocksdb instance.
   virtual uint64_t GetCurrentVersionDataSstFilesSize() { return 0; }
 
+  // Returns approximate middle key of the default column family, sampled from the index of the
+  // largest SST file.
+  virtual yb::Result<std::string> GetMiddleKey() {
+    return STATUS(NotSupported, "GetMiddleKey() not supported");
+  }
+
   // Returns a list of all table files for the current version with their level, start key and end
   // key.
   virtual void GetLiveFilesMetaData(std::vector<LiveFileMetaData>* /*metadata*/) {}
@@ -886,7 +897,8 @@ class DB {
   // Needed for StackableDB
   virtual DB* GetRootDB() { return this; }
 
-  virtual CHECKED_STATUS Import(const std::string& source_dir) {
+  virtual CHECKED_STATUS Import(
+      const std::string& source_dir, const ImportFileValidator& validator = nullptr) {
     return STATUS(NotSupported, "");
   }
 
@@ -1710,6 +1710,21 @@ uint64_t DBImpl::GetCurrentVersionDataSstFilesSize() {
   return data_sst_file_size;
 }
 
+yb::Result<std::string> DBImpl::GetMiddleKey() {
+  mutex_.Lock();
+  auto version = default_cf_handle_->cfd()->current();
+  version->Ref();
+  mutex_.Unlock();
+
+  auto result = version->GetMiddleKey();
+
+  mutex_.Lock();
+  version->Unref();
+  mutex_.Unlock();
+
+  return result;
+}
+
 void DBImpl::NotifyOnFlushCompleted(ColumnFamilyData* cfd,
                                     FileMetaData* file_meta,
                                     const MutableCFOptions& mutable_cf_options,
@@ -5455,13 +5470,13 @@ ColumnFamilyHandle* DBImpl::GetColumnFamilyHandleUnlocked(
   return cf_memtables->GetColumnFamilyHandle();
 }
 
-Status DBImpl::Import(const std::string& source_dir) {
+Status DBImpl::Import(const std::string& source_dir, const ImportFileValidator& validator) {
   const auto seqno = versions_->LastSequence();
   FlushOptions options;
   Flush(options);
   VersionEdit edit;
-  auto status = versions_->Import(source_dir, seqno, &edit);
-  if (!status.ok()) {
+  auto status = versions_->Import(source_dir, seqno, validator, &edit);
+  if (!status.ok() || edit.GetNewFiles().empty()) {
     return status;
   }
   return ApplyVersionEdit(&edit);
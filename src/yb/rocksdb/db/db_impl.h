@@ -466,7 +466,9 @@ class DBImpl : public DB {
   // Checks that source database has appropriate seqno.
   // I.e. seqno ranges of imported database does not overlap with seqno ranges of destination db.
   // And max seqno of imported database is less that active seqno of destination db.
-  CHECKED_STATUS Import(const std::string& source_dir) override;
+  // Key range of each imported file is checked by validator, when specified.
+  CHECKED_STATUS Import(
+      const std::string& source_dir, const ImportFileValidator& validator = nullptr) override;
 
   bool AreWritesStopped();
   bool NeedsDelay() override;
@@ -624,6 +626,8 @@ class DBImpl : public DB {
 
   uint64_t GetCurrentVersionDataSstFilesSize() override;
 
+  yb::Result<std::string> GetMiddleKey() override;
+
   // Updates stats_ object with SST files size metrics.
   void SetSSTFileSizeTickers();
 
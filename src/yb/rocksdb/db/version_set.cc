@@ -565,6 +565,32 @@ class BaseReferencedVersionBuilder {
 };
 }  // anonymous namespace
 
+yb::Result<std::string> Version::GetMiddleKey() {
+  // The largest file is used as a sample of the whole data, since with universal compaction most of
+  // the data ends up in it.
+  const FileMetaData* largest_file = nullptr;
+  for (int level = 0; level < storage_info_.num_levels(); ++level) {
+    for (const auto* file : storage_info_.LevelFiles(level)) {
+      if (!largest_file ||
+          file->fd.GetTotalFileSize() > largest_file->fd.GetTotalFileSize()) {
+        largest_file = file;
+      }
+    }
+  }
+  if (!largest_file) {
+    return STATUS(Incomplete, "No SST files");
+  }
+
+  auto table_cache = cfd_->table_cache();
+  Cache::Handle* handle = nullptr;
+  RETURN_NOT_OK(table_cache->FindTable(
+      vset_->env_options_, cfd_->internal_comparator(), largest_file->fd, &handle,
+      kDefaultQueryId));
+  auto result = table_cache->GetTableReaderFromHandle(handle)->GetMiddleKey();
+  table_cache->ReleaseHandle(handle);
+  return result;
+}
+
 Status Version::GetTableProperties(std::shared_ptr<const TableProperties>* tp,
                                    const FileMetaData* file_meta,
                                    const std::string* fname) const {
@@ -2817,6 +2843,7 @@ Status VersionSet::Recover(
 
 Status VersionSet::Import(const std::string& source_dir,
                           SequenceNumber seqno,
+                          const ImportFileValidator& validator,
                           VersionEdit* edit) {
   ManifestReader manifest_reader(env_, env_options_, db_options_->boundary_extractor.get(),
                                  source_dir);
@@ -2846,6 +2873,12 @@ Status VersionSet::Import(const std::string& source_dir,
                              filemeta.largest.seqno,
                              seqno);
       }
+      if (validator) {
+        status = validator(filemeta.smallest.user_key(), filemeta.largest.user_key());
+        if (!status.ok()) {
+          return status;
+        }
+      }
       files.push_back(filemeta);
       segments.emplace_back(filemeta.smallest.seqno, filemeta.largest.seqno);
     }
@@ -2855,7 +2888,9 @@ Status VersionSet::Import(const std::string& source_dir,
   }
 
   if (files.empty()) {
-    return STATUS_FORMAT(NotFound, "Imported DB is empty: $0", source_dir);
+    // Nothing to import, edit is left empty.
+    LOG(INFO) << "Imported DB is empty: " << source_dir;
+    return Status::OK();
   }
 
   std::vector<LiveFileMetaData> live_files;
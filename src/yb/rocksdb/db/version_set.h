@@ -515,6 +515,9 @@ class Version {
 
   size_t GetMemoryUsageByTableReaders();
 
+  // Returns approximate middle key of the largest SST file of this version.
+  yb::Result<std::string> GetMiddleKey();
+
   ColumnFamilyData* cfd() const { return cfd_; }
 
   // Return the next Version in the linked list. Used for debug only
@@ -745,7 +748,8 @@ class VersionSet {
   ColumnFamilySet* GetColumnFamilySet() { return column_family_set_.get(); }
   const EnvOptions& env_options() { return env_options_; }
 
-  CHECKED_STATUS Import(const std::string& source_dir, SequenceNumber seqno, VersionEdit* edit);
+  CHECKED_STATUS Import(const std::string& source_dir, SequenceNumber seqno,
+                        const ImportFileValidator& validator, VersionEdit* edit);
 
   void UnrefFile(ColumnFamilyData* cfd, FileMetaData* f);
 
@@ -1580,6 +1580,39 @@ Status BlockBasedTable::CreateDataBlockIndexReader(
   }
 }
 
+yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
+  unique_ptr<InternalIterator> index_iter(NewIndexIterator(ReadOptions::kDefault));
+
+  size_t num_entries = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid(); index_iter->Next()) {
+    ++num_entries;
+  }
+  RETURN_NOT_OK(index_iter->status());
+  if (num_entries == 0) {
+    return STATUS(Incomplete, "Empty SST file");
+  }
+
+  index_iter->SeekToFirst();
+  for (size_t i = 0; i != num_entries / 2; ++i) {
+    index_iter->Next();
+  }
+  RETURN_NOT_OK(index_iter->status());
+  if (!index_iter->Valid()) {
+    return STATUS(Corruption, "Data index changed while iterating");
+  }
+
+  // Index keys are shortened separators between data blocks, that are not necessary valid keys.
+  // So the first key of the middle data block is used instead.
+  unique_ptr<InternalIterator> datablock_iter(
+      NewDataBlockIterator(ReadOptions::kDefault, index_iter->value(), BlockType::kData));
+  datablock_iter->SeekToFirst();
+  RETURN_NOT_OK(datablock_iter->status());
+  if (!datablock_iter->Valid()) {
+    return STATUS(Incomplete, "Empty data block");
+  }
+  return ExtractUserKey(datablock_iter->key()).ToBuffer();
+}
+
 uint64_t BlockBasedTable::ApproximateOffsetOf(const Slice& key) {
   unique_ptr<InternalIterator> index_iter(NewIndexIterator(ReadOptions::kDefault));
 
@@ -178,6 +178,10 @@ class BlockBasedTable : public TableReader {
   // convert SST file to a human readable form
   Status DumpTable(WritableFile* out_file) override;
 
+  // Returns the first key of the middle data block, so both halves have the same number of data
+  // blocks.
+  yb::Result<std::string> GetMiddleKey() override;
+
   // input_iter: if it is not null, update this one and return it as Iterator
   InternalIterator* NewDataBlockIterator(
       const ReadOptions& ro, const Slice& index_value, BlockType block_type,
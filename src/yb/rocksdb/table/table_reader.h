@@ -26,6 +26,7 @@
 
 #include <memory>
 
+#include "yb/util/result.h"
 #include "yb/util/slice.h"
 
 namespace rocksdb {
@@ -114,6 +115,12 @@ class TableReader {
   virtual Status DumpTable(WritableFile* out_file) {
     return STATUS(NotSupported, "DumpTable() not supported");
   }
+
+  // Returns approximate middle key of the table, i.e. a key that splits the table data into two
+  // parts of roughly equal size.
+  virtual yb::Result<std::string> GetMiddleKey() {
+    return STATUS(NotSupported, "GetMiddleKey() not supported");
+  }
 };
 
 }  // namespace rocksdb
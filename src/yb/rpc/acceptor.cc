@@ -35,6 +35,8 @@
 #include <inttypes.h>
 #include <pthread.h>
 #include <stdint.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <gflags/gflags.h>
 #include <glog/logging.h>
@@ -42,6 +44,8 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/rpc/messenger.h"
+#include "yb/rpc/tcp_stream.h"
+#include "yb/util/errno.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/metrics.h"
 #include "yb/util/net/sockaddr.h"
@@ -78,17 +82,70 @@ Acceptor::~Acceptor() {
   Shutdown();
 }
 
+namespace {
+
+// Only owner is allowed to connect to the socket, i.e. processes running as the same user.
+constexpr mode_t kUnixSocketPermissions = S_IRUSR | S_IWUSR;
+
+Status RemoveStaleUnixSocket(const std::string& path) {
+  struct stat st;
+  if (lstat(path.c_str(), &st) != 0) {
+    if (errno == ENOENT) {
+      return Status::OK();
+    }
+    return STATUS_FORMAT(NetworkError, "Failed to stat $0: $1", path, ErrnoToString(errno));
+  }
+  if (!S_ISSOCK(st.st_mode)) {
+    return STATUS_FORMAT(AlreadyPresent, "$0 exists and is not a socket", path);
+  }
+  // Socket file could be left by previous process that was listening on the same endpoint.
+  // Since we have already bound TCP socket to this endpoint, nobody else is using it now.
+  if (unlink(path.c_str()) != 0 && errno != ENOENT) {
+    return STATUS_FORMAT(NetworkError, "Failed to remove stale Unix domain socket $0: $1",
+                         path, ErrnoToString(errno));
+  }
+  return Status::OK();
+}
+
+Result<Socket> ListenUnixDomain(const std::string& path) {
+  Socket socket;
+  RETURN_NOT_OK(socket.Init(Socket::FLAG_UNIX_DOMAIN));
+  RETURN_NOT_OK(RemoveStaleUnixSocket(path));
+  RETURN_NOT_OK(socket.BindUnixDomain(path));
+  // Socket file is created with permissions depending on umask, so set them explicitly.
+  if (chmod(path.c_str(), kUnixSocketPermissions) != 0) {
+    return STATUS_FORMAT(NetworkError, "Failed to set permissions of $0: $1",
+                         path, ErrnoToString(errno));
+  }
+  RETURN_NOT_OK(socket.SetNonBlocking(true));
+  RETURN_NOT_OK(socket.Listen(FLAGS_rpc_acceptor_listen_backlog));
+  return std::move(socket);
+}
+
+} // namespace
+
 Status Acceptor::Listen(const Endpoint& endpoint, Endpoint* bound_endpoint) {
   Socket socket;
   RETURN_NOT_OK(socket.Init(endpoint.address().is_v6() ? Socket::FLAG_IPV6 : 0));
   RETURN_NOT_OK(socket.SetReuseAddr(true));
   RETURN_NOT_OK(socket.Bind(endpoint));
+  Endpoint actual_endpoint;
+  RETURN_NOT_OK(socket.GetSocketAddress(&actual_endpoint));
   if (bound_endpoint) {
-    RETURN_NOT_OK(socket.GetSocketAddress(bound_endpoint));
+    *bound_endpoint = actual_endpoint;
   }
   RETURN_NOT_OK(socket.SetNonBlocking(true));
   RETURN_NOT_OK(socket.Listen(FLAGS_rpc_acceptor_listen_backlog));
 
+  auto unix_socket_path = UnixSocketPathForEndpoint(actual_endpoint);
+  Socket unix_socket;
+  if (!unix_socket_path.empty()) {
+    auto listening_socket = VERIFY_RESULT(ListenUnixDomain(unix_socket_path));
+    unix_socket.Reset(listening_socket.Release());
+    LOG(INFO) << "Accepting connections to " << actual_endpoint << " also on "
+              << unix_socket_path;
+  }
+
   bool was_empty;
   {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -97,6 +154,11 @@ Status Acceptor::Listen(const Endpoint& endpoint, Endpoint* bound_endpoint) {
     }
     was_empty = sockets_to_add_.empty();
     sockets_to_add_.push_back(std::move(socket));
+    if (unix_socket.GetFd() >= 0) {
+      unix_socket_endpoints_.emplace(unix_socket.GetFd(), actual_endpoint);
+      sockets_to_add_.push_back(std::move(unix_socket));
+      unix_socket_paths_.push_back(std::move(unix_socket_path));
+    }
   }
 
   if (was_empty) {
@@ -131,6 +193,14 @@ void Acceptor::Shutdown() {
     CHECK_OK(ThreadJoiner(thread_.get()).Join());
     thread_.reset();
   }
+
+  for (const auto& path : unix_socket_paths_) {
+    if (unlink(path.c_str()) != 0) {
+      LOG(WARNING) << "Failed to remove Unix domain socket " << path << ": "
+                   << ErrnoToString(errno);
+    }
+  }
+  unix_socket_paths_.clear();
 }
 
 void Acceptor::IoHandler(ev::io& io, int events) {
@@ -159,6 +229,22 @@ void Acceptor::IoHandler(ev::io& io, int events) {
         }
         return;
       }
+      if (it->second.unix_domain) {
+        // Peer of Unix domain socket does not have IP address, but it is always on this host.
+        // So report the address this host is reached at, i.e. the address of the TCP endpoint
+        // that the socket accepts connections for.
+        const auto& endpoint = it->second.endpoint;
+        remote = endpoint.address().is_unspecified()
+            ? Endpoint(endpoint.address().is_v6()
+                           ? IpAddress(boost::asio::ip::address_v6::loopback())
+                           : IpAddress(boost::asio::ip::address_v4::loopback()),
+                       endpoint.port())
+            : endpoint;
+        VLOG(2) << "Accepted Unix domain connection for " << endpoint;
+        rpc_connections_accepted_->Increment();
+        handler_(&new_sock, remote);
+        continue;
+      }
       s = new_sock.SetNoDelay(true);
       if (!s.ok()) {
         LOG(WARNING) << "Acceptor with remote = " << remote
@@ -174,10 +260,12 @@ void Acceptor::IoHandler(ev::io& io, int events) {
 
 void Acceptor::AsyncHandler(ev::async& async, int events) {
   bool closing;
+  std::unordered_map<int, Endpoint> unix_socket_endpoints;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     closing = closing_;
     sockets_to_add_.swap(processing_sockets_to_add_);
+    unix_socket_endpoints.swap(unix_socket_endpoints_);
   }
 
   if (closing) {
@@ -190,15 +278,22 @@ void Acceptor::AsyncHandler(ev::async& async, int events) {
   while (!processing_sockets_to_add_.empty()) {
     auto& socket = processing_sockets_to_add_.back();
     Endpoint endpoint;
-    auto status = socket.GetSocketAddress(&endpoint);
-    if (!status.ok()) {
-      LOG(WARNING) << "Failed to get address for socket: "
-                   << socket.GetFd() << ": " << status.ToString();
+    const bool unix_domain = socket.IsUnixDomain();
+    if (unix_domain) {
+      endpoint = unix_socket_endpoints[socket.GetFd()];
+    } else {
+      auto status = socket.GetSocketAddress(&endpoint);
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to get address for socket: "
+                     << socket.GetFd() << ": " << status.ToString();
+      }
     }
-    VLOG(1) << "Adding socket fd " << socket.GetFd() << " at " << endpoint;
+    VLOG(1) << "Adding socket fd " << socket.GetFd() << " at " << endpoint
+            << (unix_domain ? " (unix domain)" : "");
     AcceptingSocket ac{ std::unique_ptr<ev::io>(new ev::io),
                         Socket(std::move(socket)),
-                        endpoint };
+                        endpoint,
+                        unix_domain };
     processing_sockets_to_add_.pop_back();
     ac.io->set(loop_);
     ac.io->set<Acceptor, &Acceptor::IoHandler>(this);
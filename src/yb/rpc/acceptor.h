@@ -34,6 +34,7 @@
 #define YB_RPC_ACCEPTOR_H
 
 #include <mutex>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -77,7 +78,9 @@ class Acceptor {
   struct AcceptingSocket {
     std::unique_ptr<ev::io> io;
     Socket socket;
+    // For Unix domain socket, TCP endpoint that it accepts connections for.
     Endpoint endpoint;
+    bool unix_domain;
   };
 
   NewSocketHandler handler_;
@@ -88,6 +91,12 @@ class Acceptor {
   std::vector<Socket> sockets_to_add_;
   std::vector<Socket> processing_sockets_to_add_;
 
+  // TCP endpoints of Unix domain sockets in sockets_to_add_, keyed by fd.
+  std::unordered_map<int, Endpoint> unix_socket_endpoints_;
+
+  // Paths of Unix domain sockets we listen on, removed during shutdown.
+  std::vector<std::string> unix_socket_paths_;
+
   scoped_refptr<Counter> rpc_connections_accepted_;
 
   bool closing_ = false;
@@ -0,0 +1,106 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include "yb/rpc/call_pool.h"
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(rpc_use_call_pool, true,
+            "Whether RPC call objects should be allocated from size classed per CPU pool, "
+            "instead of allocating them from heap for each call.");
+TAG_FLAG(rpc_use_call_pool, advanced);
+TAG_FLAG(rpc_use_call_pool, runtime);
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+// Blocks from 256 bytes up to 8KB, larger objects are allocated directly from heap.
+constexpr size_t kMinBlockSize = 256;
+constexpr size_t kNumSizeClasses = 6;
+
+} // namespace
+
+CallMemoryPool& CallMemoryPool::Instance() {
+  // Pool is never destroyed, since calls could be released during static destruction.
+  static CallMemoryPool* instance = new CallMemoryPool();
+  return *instance;
+}
+
+CallMemoryPool::CallMemoryPool()
+    : mem_tracker_(MemTracker::FindOrCreateTracker("Call Pool", MemTracker::GetRootTracker())) {
+  pools_.reserve(kNumSizeClasses);
+  for (size_t size_class = 0; size_class != kNumSizeClasses; ++size_class) {
+    const auto block_size = BlockSize(size_class);
+    pools_.push_back(std::make_unique<ThreadSafeObjectPool<char>>(
+        [this, block_size] { return static_cast<char*>(AllocateFromHeap(block_size)); },
+        [this, block_size](char* block) { FreeToHeap(block, block_size); }));
+  }
+}
+
+size_t CallMemoryPool::SizeClass(size_t size) {
+  size_t result = 0;
+  while (result < kNumSizeClasses && BlockSize(result) < size) {
+    ++result;
+  }
+  return result;
+}
+
+size_t CallMemoryPool::BlockSize(size_t size_class) {
+  return kMinBlockSize << size_class;
+}
+
+void* CallMemoryPool::Allocate(size_t size) {
+  const auto size_class = SizeClass(size);
+  if (size_class == kNumSizeClasses) {
+    return AllocateFromHeap(size);
+  }
+  // Even when pool is disabled we allocate the whole block, so it could be returned to the pool
+  // if flag was changed during lifetime of the object.
+  if (!FLAGS_rpc_use_call_pool) {
+    return AllocateFromHeap(BlockSize(size_class));
+  }
+  return pools_[size_class]->Take();
+}
+
+void CallMemoryPool::Free(void* block, size_t size) {
+  const auto size_class = SizeClass(size);
+  if (size_class == kNumSizeClasses) {
+    FreeToHeap(block, size);
+    return;
+  }
+  if (!FLAGS_rpc_use_call_pool) {
+    FreeToHeap(block, BlockSize(size_class));
+    return;
+  }
+  pools_[size_class]->Release(static_cast<char*>(block));
+}
+
+void* CallMemoryPool::AllocateFromHeap(size_t size) {
+  heap_allocations_.fetch_add(1, std::memory_order_acq_rel);
+  mem_tracker_->Consume(size);
+  auto result = malloc(size);
+  CHECK(result != nullptr);
+  return result;
+}
+
+void CallMemoryPool::FreeToHeap(void* block, size_t size) {
+  free(block);
+  mem_tracker_->Release(size);
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,98 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#ifndef YB_RPC_CALL_POOL_H
+#define YB_RPC_CALL_POOL_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "yb/util/mem_tracker.h"
+#include "yb/util/object_pool.h"
+
+namespace yb {
+namespace rpc {
+
+// Size classed pool of memory blocks used to allocate RPC call objects.
+// Free blocks are cached per CPU, so block released by reactor thread is usually reused by the
+// same reactor for the next call.
+// Memory obtained from heap by the pool is accounted in the "Call Pool" mem tracker.
+class CallMemoryPool {
+ public:
+  static CallMemoryPool& Instance();
+
+  void* Allocate(size_t size);
+  void Free(void* block, size_t size);
+
+  // Number of blocks that were allocated from heap, i.e. were not reused from the pool.
+  size_t heap_allocations() const {
+    return heap_allocations_.load(std::memory_order_acquire);
+  }
+
+ private:
+  CallMemoryPool();
+
+  void* AllocateFromHeap(size_t size);
+  void FreeToHeap(void* block, size_t size);
+
+  static size_t SizeClass(size_t size);
+  static size_t BlockSize(size_t size_class);
+
+  std::atomic<size_t> heap_allocations_{0};
+  MemTrackerPtr mem_tracker_;
+  std::vector<std::unique_ptr<ThreadSafeObjectPool<char>>> pools_;
+};
+
+// STL allocator that takes memory from CallMemoryPool.
+template <class T>
+class CallAllocator {
+ public:
+  typedef T value_type;
+
+  CallAllocator() = default;
+
+  template <class U>
+  CallAllocator(const CallAllocator<U>& rhs) {} // NOLINT
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(CallMemoryPool::Instance().Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    CallMemoryPool::Instance().Free(p, n * sizeof(T));
+  }
+};
+
+template <class T, class U>
+bool operator==(const CallAllocator<T>& lhs, const CallAllocator<U>& rhs) {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const CallAllocator<T>& lhs, const CallAllocator<U>& rhs) {
+  return false;
+}
+
+// Creates call object, placing it and its shared_ptr control block into single pooled block.
+template <class T, class... Args>
+std::shared_ptr<T> AllocateCall(Args&&... args) {
+  return std::allocate_shared<T>(CallAllocator<T>(), std::forward<Args>(args)...);
+}
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_CALL_POOL_H
@@ -475,6 +475,7 @@ void Connection::UpdateLastActivity() {
 }
 
 void Connection::UpdateLastRead() {
+  last_read_time_ = MonoTime::Now();
   context_->UpdateLastRead(shared_from_this());
 }
 
@@ -112,6 +112,12 @@ class Connection final : public StreamContext, public std::enable_shared_from_th
     return last_activity_time_;
   }
 
+  // The last time we started reading from the socket.
+  // Should only be called from the reactor thread.
+  MonoTime last_read_time() const {
+    return last_read_time_;
+  }
+
   void UpdateLastActivity() override;
 
   // Returns true if we are not in the process of receiving or sending a
@@ -218,6 +224,9 @@ class Connection final : public StreamContext, public std::enable_shared_from_th
   // The last time we read or wrote from the socket.
   CoarseTimePoint last_activity_time_;
 
+  // The last time we started reading from the socket, used to track call parse latency.
+  MonoTime last_read_time_;
+
   // Calls which have been sent and are now waiting for a response.
   std::unordered_map<int32_t, OutboundCallPtr> awaiting_response_;
 
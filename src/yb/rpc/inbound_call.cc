@@ -38,15 +38,18 @@
 
 #include "yb/rpc/connection.h"
 #include "yb/rpc/connection_context.h"
+#include "yb/rpc/reactor.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/rpc_metrics.h"
 #include "yb/rpc/serialization.h"
+#include "yb/rpc/service_if.h"
 #include "yb/rpc/service_pool.h"
 
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
+#include "yb/util/numa.h"
 #include "yb/util/trace.h"
 #include "yb/util/memory/memory.h"
 
@@ -101,6 +104,8 @@ InboundCall::~InboundCall() {
 void InboundCall::NotifyTransferred(const Status& status, Connection* conn) {
   if (status.ok()) {
     TRACE_TO(trace_, "Transfer finished");
+    timing_.time_transferred = MonoTime::Now();
+    RecordStageLatencies();
   } else {
     YB_LOG_EVERY_N_SECS(WARNING, 10) << LogPrefix() << "Connection torn down before " << ToString()
                                      << " could send its response: " << status.ToString();
@@ -138,6 +143,13 @@ void InboundCall::RecordCallReceived() {
   LOG_IF_WITH_PREFIX(DFATAL, timing_.time_received.Initialized()) << "Already marked as received";
   VLOG_WITH_PREFIX(4) << "Received";
   timing_.time_received = MonoTime::Now();
+  if (conn_) {
+    timing_.time_read = conn_->last_read_time();
+  }
+}
+
+void InboundCall::RecordQueued() {
+  timing_.time_queued = MonoTime::Now();
 }
 
 void InboundCall::RecordHandlingStarted(scoped_refptr<Histogram> incoming_queue_time) {
@@ -146,6 +158,12 @@ void InboundCall::RecordHandlingStarted(scoped_refptr<Histogram> incoming_queue_
   LOG_IF_WITH_PREFIX(DFATAL, timing_.time_handled.Initialized()) << "Already marked as started";
   timing_.time_handled = MonoTime::Now();
   VLOG_WITH_PREFIX(4) << "Handling";
+  if (conn_) {
+    auto reactor_node = conn_->reactor()->numa_node();
+    if (reactor_node >= 0 && reactor_node != CachedCurrentNumaNode()) {
+      IncrementCounter(rpc_metrics_->inbound_calls_cross_numa_node);
+    }
+  }
   incoming_queue_time->Increment(
       timing_.time_handled.GetDeltaSince(timing_.time_received).ToMicroseconds());
 }
@@ -175,6 +193,7 @@ bool InboundCall::ClientTimedOut() const {
 
 void InboundCall::QueueResponse(bool is_success) {
   TRACE_TO(trace_, is_success ? "Queueing success response" : "Queueing failure response");
+  timing_.time_responded = MonoTime::Now();
   LogTrace();
   bool expected = false;
   if (responded_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
@@ -184,6 +203,31 @@ void InboundCall::QueueResponse(bool is_success) {
   }
 }
 
+namespace {
+
+void IncrementStageHistogram(
+    const scoped_refptr<Histogram>& histogram, const MonoTime& start, const MonoTime& finish) {
+  if (histogram && start.Initialized() && finish.Initialized()) {
+    histogram->Increment(finish.GetDeltaSince(start).ToMicroseconds());
+  }
+}
+
+} // namespace
+
+void InboundCall::RecordStageLatencies() {
+  const auto* stages = stage_metrics_.get();
+  if (!stages) {
+    return;
+  }
+  IncrementStageHistogram(stages->parse_time, timing_.time_read, timing_.time_received);
+  IncrementStageHistogram(stages->dispatch_time, timing_.time_received, timing_.time_queued);
+  IncrementStageHistogram(stages->queue_time, timing_.time_queued, timing_.time_handled);
+  IncrementStageHistogram(
+      stages->response_serialize_time, timing_.time_completed, timing_.time_responded);
+  IncrementStageHistogram(
+      stages->response_transfer_time, timing_.time_responded, timing_.time_transferred);
+}
+
 std::string InboundCall::LogPrefix() const {
   return Format("$0: ", this);
 }
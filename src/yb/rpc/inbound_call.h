@@ -44,6 +44,7 @@
 
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/rpc/call_data.h"
+#include "yb/rpc/call_pool.h"
 #include "yb/rpc/growable_buffer.h"
 #include "yb/rpc/rpc_call.h"
 #include "yb/rpc/remote_method.h"
@@ -79,9 +80,13 @@ class RpcCallDetailsPB;
 class CQLCallDetailsPB;
 
 struct InboundCallTiming {
-  MonoTime time_received;   // Time the call was first accepted.
-  MonoTime time_handled;    // Time the call handler was kicked off.
-  MonoTime time_completed;  // Time the call handler completed.
+  MonoTime time_read;         // Time the last chunk of the call was read from the socket.
+  MonoTime time_received;     // Time the call was first accepted.
+  MonoTime time_queued;       // Time the call was put into the service queue.
+  MonoTime time_handled;      // Time the call handler was kicked off.
+  MonoTime time_completed;    // Time the call handler completed.
+  MonoTime time_responded;    // Time the serialized response was queued for sending.
+  MonoTime time_transferred;  // Time the response was written to the socket.
 };
 
 class InboundCallHandler {
@@ -125,6 +130,10 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // Not thread-safe. Should only be called by the current "owner" thread.
   void RecordCallReceived();
 
+  // When this InboundCall was put into the service queue.
+  // Not thread-safe. Should only be called by the current "owner" thread.
+  void RecordQueued();
+
   // When RPC call Handle() was called on the server side.
   // Updates the Histogram with time elapsed since the call was received,
   // and should only be called once on a given instance.
@@ -137,6 +146,11 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // Not thread-safe. Should only be called by the current "owner" thread.
   void RecordHandlingCompleted(scoped_refptr<Histogram> handler_run_time);
 
+  // Histograms that receive latency of the stages of this call, when response is transferred.
+  void SetStageMetrics(std::shared_ptr<const RpcCallStageMetrics> stage_metrics) {
+    stage_metrics_ = std::move(stage_metrics);
+  }
+
   // Return true if the deadline set by the client has already elapsed.
   // In this case, the server may stop processing the call, since the
   // call response will be ignored anyway.
@@ -187,7 +201,7 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   template <class T, class ...Args>
   static std::shared_ptr<T> Create(Args&&... args) {
-    auto result = std::make_shared<T>(std::forward<Args>(args)...);
+    auto result = AllocateCall<T>(std::forward<Args>(args)...);
     result->RecordCallReceived();
     return result;
   }
@@ -213,6 +227,8 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   void QueueResponse(bool is_success);
 
+  void RecordStageLatencies();
+
   // The serialized bytes of the request param protobuf. Set by ParseFrom().
   // This references memory held by 'transfer_'.
   Slice serialized_request_;
@@ -235,6 +251,7 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   ConnectionPtr conn_ = nullptr;
   RpcMetrics* rpc_metrics_;
   const std::function<void(InboundCall*)> call_processed_listener_;
+  std::shared_ptr<const RpcCallStageMetrics> stage_metrics_;
 
   class InboundCallTask : public ThreadPoolTask {
    public:
@@ -58,6 +58,7 @@
 #include "yb/rpc/constants.h"
 #include "yb/rpc/proxy.h"
 #include "yb/rpc/rpc_header.pb.h"
+#include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/rpc_metrics.h"
 #include "yb/rpc/rpc_service.h"
 #include "yb/rpc/tcp_stream.h"
@@ -69,6 +70,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/net/socket.h"
+#include "yb/util/numa.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status.h"
 #include "yb/util/threadpool.h"
@@ -97,6 +99,11 @@ DEFINE_int32(rpc_workers_limit, 256, "Workers limit for rpc server");
 
 DEFINE_int32(socket_receive_buffer_size, 0, "Socket receive buffer size, 0 to use default");
 
+DEFINE_bool(rpc_numa_aware_placement, false,
+            "Bind reactor threads to NUMA nodes, and route connections to reactors on the node "
+            "that received or initiated them.");
+TAG_FLAG(rpc_numa_aware_placement, advanced);
+
 namespace yb {
 namespace rpc {
 
@@ -474,7 +481,12 @@ class NotifyDisconnectedReactorTask : public ReactorTask {
 
 void Messenger::QueueOutboundCall(OutboundCallPtr call) {
   const auto& remote = call->conn_id().remote();
-  Reactor *reactor = RemoteToReactor(remote, call->conn_id().idx());
+  // Reactor is picked only by connection id, so all calls with the same id share one connection.
+  const int numa_node = call->conn_id().numa_node();
+  Reactor *reactor = RemoteToReactor(remote, call->conn_id().idx(), numa_node);
+  if (reactor->numa_node() >= 0 && reactor->numa_node() != numa_node) {
+    IncrementCounter(rpc_metrics_->outbound_calls_cross_numa_node);
+  }
 
   if (TEST_ShouldArtificiallyRejectOutgoingCallsTo(remote.address())) {
     VLOG(1) << "TEST: Rejected connection to " << remote;
@@ -544,8 +556,16 @@ void Messenger::RegisterInboundSocket(
     return;
   }
 
+  int numa_node = -1;
+  if (!numa_reactors_.empty()) {
+    // Prefer reactor on the node whose CPU processed packets of this connection.
+    auto incoming_cpu = new_socket->GetIncomingCpu();
+    if (incoming_cpu.ok()) {
+      numa_node = NumaTopology::Instance().NodeOfCpu(*incoming_cpu);
+    }
+  }
   int idx = num_connections_accepted_.fetch_add(1) % num_connections_to_server_;
-  Reactor *reactor = RemoteToReactor(remote, idx);
+  Reactor *reactor = RemoteToReactor(remote, idx, numa_node);
   reactor->RegisterInboundSocket(
       new_socket, remote, factory->Create(*receive_buffer_size), factory->buffer_tracker());
 }
@@ -567,6 +587,13 @@ Messenger::Messenger(const MessengerBuilder &bld)
   VLOG(1) << "Messenger constructor for " << this << " called at:\n" << GetStackTrace();
   for (int i = 0; i < bld.num_reactors_; i++) {
     reactors_.emplace_back(std::make_unique<Reactor>(this, i, bld));
+    auto numa_node = reactors_.back()->numa_node();
+    if (numa_node >= 0) {
+      if (numa_reactors_.size() <= static_cast<size_t>(numa_node)) {
+        numa_reactors_.resize(numa_node + 1);
+      }
+      numa_reactors_[numa_node].push_back(reactors_.back().get());
+    }
   }
 }
 
@@ -590,8 +617,25 @@ size_t Messenger::max_concurrent_requests() const {
   return num_connections_to_server_;
 }
 
-Reactor* Messenger::RemoteToReactor(const Endpoint& remote, uint32_t idx) {
+bool Messenger::HasNumaReactors(int numa_node) const {
+  return numa_node >= 0 && static_cast<size_t>(numa_node) < numa_reactors_.size() &&
+         !numa_reactors_[numa_node].empty();
+}
+
+int Messenger::OutboundNumaNode() const {
+  if (numa_reactors_.empty()) {
+    return -1;
+  }
+  const int numa_node = CachedCurrentNumaNode();
+  return HasNumaReactors(numa_node) ? numa_node : -1;
+}
+
+Reactor* Messenger::RemoteToReactor(const Endpoint& remote, uint32_t idx, int numa_node) {
   uint32_t hashCode = hash_value(remote);
+  if (HasNumaReactors(numa_node)) {
+    const auto& node_reactors = numa_reactors_[numa_node];
+    return node_reactors[(hashCode + idx) % node_reactors.size()];
+  }
   int reactor_idx = (hashCode + idx) % reactors_.size();
   // This is just a static partitioning; where each connection
   // to a remote is assigned to a particular reactor. We could
@@ -615,6 +659,11 @@ Status Messenger::DumpRunningRpcs(const DumpRunningRpcsRequestPB& req,
   for (const auto& reactor : reactors_) {
     RETURN_NOT_OK(reactor->DumpRunningRpcs(req, resp));
   }
+  if (req.include_latency_breakdown()) {
+    for (const auto& p : rpc_services_) {
+      p.second->DumpMethodLatencies(resp);
+    }
+  }
   return Status::OK();
 }
 
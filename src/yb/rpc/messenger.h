@@ -290,6 +290,8 @@ class Messenger : public ProxyContext {
     return num_connections_to_server_;
   }
 
+  int OutboundNumaNode() const override;
+
   // Use specified IP address as base address for outbound connections from messenger.
   void TEST_SetOutboundIpBase(const IpAddress& value) {
     test_outbound_ip_base_ = value;
@@ -304,7 +306,11 @@ class Messenger : public ProxyContext {
 
   explicit Messenger(const MessengerBuilder &bld);
 
-  Reactor* RemoteToReactor(const Endpoint& remote, uint32_t idx = 0);
+  // Picks reactor for connection to remote. When NUMA aware placement is enabled and numa_node
+  // is not negative, reactors of numa_node are preferred.
+  Reactor* RemoteToReactor(const Endpoint& remote, uint32_t idx = 0, int numa_node = -1);
+
+  bool HasNumaReactors(int numa_node) const;
   CHECKED_STATUS Init();
   void UpdateServicesCache(std::lock_guard<percpu_rwlock>* guard);
 
@@ -336,6 +342,9 @@ class Messenger : public ProxyContext {
 
   std::vector<std::unique_ptr<Reactor>> reactors_;
 
+  // Reactors grouped by NUMA node, empty when NUMA aware placement is disabled.
+  std::vector<std::vector<Reactor*>> numa_reactors_;
+
   const scoped_refptr<MetricEntity> metric_entity_;
   const scoped_refptr<Histogram> outgoing_queue_time_;
 
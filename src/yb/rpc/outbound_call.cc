@@ -551,7 +551,8 @@ void OutboundCall::InitHeader(RequestHeader* header) {
 ///
 
 string ConnectionId::ToString() const {
-  return Format("{ remote: $0 idx: $1 protocol: $2 }", remote_, idx_, protocol_);
+  return Format("{ remote: $0 idx: $1 protocol: $2 numa_node: $3 }",
+                remote_, idx_, protocol_, numa_node_);
 }
 
 size_t ConnectionId::HashCode() const {
@@ -559,6 +560,7 @@ size_t ConnectionId::HashCode() const {
   boost::hash_combine(seed, hash_value(remote_));
   boost::hash_combine(seed, idx_);
   boost::hash_combine(seed, protocol_);
+  boost::hash_combine(seed, numa_node_);
   return seed;
 }
 
@@ -84,13 +84,14 @@ class ConnectionId {
   ConnectionId() {}
 
   // Convenience constructor.
-  ConnectionId(const Endpoint& remote, size_t idx, const Protocol* protocol)
-      : remote_(remote), idx_(idx), protocol_(protocol) {}
+  ConnectionId(const Endpoint& remote, size_t idx, const Protocol* protocol, int numa_node = -1)
+      : remote_(remote), idx_(idx), protocol_(protocol), numa_node_(numa_node) {}
 
   // The remote address.
   const Endpoint& remote() const { return remote_; }
   uint8_t idx() const { return idx_; }
   const Protocol* protocol() const { return protocol_; }
+  int numa_node() const { return numa_node_; }
 
   // Returns a string representation of the object, not including the password field.
   std::string ToString() const;
@@ -102,6 +103,8 @@ class ConnectionId {
   Endpoint remote_;
   uint8_t idx_ = 0;  // Connection index, used to support multiple connections to the same server.
   const Protocol* protocol_ = nullptr;
+  // NUMA node whose reactors serve this connection, -1 if connection is not bound to a node.
+  int numa_node_ = -1;
 };
 
 class ConnectionIdHash {
@@ -110,7 +113,8 @@ class ConnectionIdHash {
 };
 
 inline bool operator==(const ConnectionId& lhs, const ConnectionId& rhs) {
-  return lhs.remote() == rhs.remote() && lhs.idx() == rhs.idx() && lhs.protocol() == rhs.protocol();
+  return lhs.remote() == rhs.remote() && lhs.idx() == rhs.idx() &&
+         lhs.protocol() == rhs.protocol() && lhs.numa_node() == rhs.numa_node();
 }
 
 // Container for OutboundCall metrics
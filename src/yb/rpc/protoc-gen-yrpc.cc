@@ -47,6 +47,7 @@
 #include <google/protobuf/compiler/code_generator.h>
 #include <google/protobuf/compiler/plugin.h>
 #include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor.pb.h>
 #include <google/protobuf/io/printer.h>
 #include <google/protobuf/io/zero_copy_stream.h>
 #include <google/protobuf/stubs/common.h>
@@ -371,6 +372,7 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
         "  virtual void Handle(::yb::rpc::InboundCallPtr call);\n"
         "  virtual std::string service_name() const;\n"
         "  static std::string static_service_name();\n"
+        "  virtual void DumpMethodLatencies(::yb::rpc::DumpRunningRpcsResponsePB* resp) const;\n"
         "\n"
         );
 
@@ -474,6 +476,40 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
           "  yb::MetricUnit::kMicroseconds,\n"
           "  \"Microseconds spent handling $rpc_full_name$() RPC requests\",\n"
           "  60000000LU, 2);\n"
+          "\n"
+          "METRIC_DEFINE_histogram(server, rpc_parse_time_$rpc_full_name_plainchars$,\n"
+          "  \"$rpc_full_name$ RPC Parse Time\",\n"
+          "  yb::MetricUnit::kMicroseconds,\n"
+          "  \"Microseconds between reading $rpc_full_name$() RPC requests from the socket \"\n"
+          "  \"and parsing them\",\n"
+          "  60000000LU, 2);\n"
+          "\n"
+          "METRIC_DEFINE_histogram(server, rpc_dispatch_time_$rpc_full_name_plainchars$,\n"
+          "  \"$rpc_full_name$ RPC Dispatch Time\",\n"
+          "  yb::MetricUnit::kMicroseconds,\n"
+          "  \"Microseconds between parsing $rpc_full_name$() RPC requests and putting them \"\n"
+          "  \"into the service queue\",\n"
+          "  60000000LU, 2);\n"
+          "\n"
+          "METRIC_DEFINE_histogram(server, rpc_queue_time_$rpc_full_name_plainchars$,\n"
+          "  \"$rpc_full_name$ RPC Queue Time\",\n"
+          "  yb::MetricUnit::kMicroseconds,\n"
+          "  \"Microseconds $rpc_full_name$() RPC requests spend in the service queue\",\n"
+          "  60000000LU, 2);\n"
+          "\n"
+          "METRIC_DEFINE_histogram(server, rpc_response_serialize_time_$rpc_full_name_plainchars$,\n"
+          "  \"$rpc_full_name$ RPC Response Serialize Time\",\n"
+          "  yb::MetricUnit::kMicroseconds,\n"
+          "  \"Microseconds between handler completion and queueing of serialized \"\n"
+          "  \"$rpc_full_name$() RPC responses\",\n"
+          "  60000000LU, 2);\n"
+          "\n"
+          "METRIC_DEFINE_histogram(server, rpc_response_transfer_time_$rpc_full_name_plainchars$,\n"
+          "  \"$rpc_full_name$ RPC Response Transfer Time\",\n"
+          "  yb::MetricUnit::kMicroseconds,\n"
+          "  \"Microseconds between queueing of $rpc_full_name$() RPC responses and writing \"\n"
+          "  \"them to the socket\",\n"
+          "  60000000LU, 2);\n"
           "\n");
         subs->Pop();
       }
@@ -511,12 +547,23 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
         "    auto rpc_context = yb_call->IsLocalCall() ?\n"
         "        ::yb::rpc::RpcContext(\n"
         "            std::static_pointer_cast<::yb::rpc::LocalYBInboundCall>(yb_call), \n"
-        "            metrics_[$metric_enum_key$]) :\n"
-        "        ::yb::rpc::RpcContext(\n"
-        "            yb_call, \n"
-        "            std::make_shared<$request$>(),\n"
-        "            std::make_shared<$response$>(),\n"
-        "            metrics_[$metric_enum_key$]);\n"
+        "            metrics_[$metric_enum_key$]) :\n");
+        // Messages of protos that enable arenas are allocated on a per call arena.
+        if (method->input_type()->file()->options().cc_enable_arenas() &&
+            method->output_type()->file()->options().cc_enable_arenas()) {
+          Print(printer, *subs,
+          "        ::yb::rpc::RpcContext::CreateWithArena<$request$, $response$>(\n"
+          "            yb_call, \n"
+          "            metrics_[$metric_enum_key$]);\n");
+        } else {
+          Print(printer, *subs,
+          "        ::yb::rpc::RpcContext(\n"
+          "            yb_call, \n"
+          "            std::make_shared<$request$>(),\n"
+          "            std::make_shared<$response$>(),\n"
+          "            metrics_[$metric_enum_key$]);\n");
+        }
+        Print(printer, *subs,
         "    if (!rpc_context.responded()) {\n"
         "      const auto* req = static_cast<const $request$*>(rpc_context.request_pb());\n"
         "      auto* resp = static_cast<$response$*>(rpc_context.response_pb());\n"
@@ -540,6 +587,27 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
         "\n"
       );
 
+      Print(printer, *subs,
+        "void $service_name$If::DumpMethodLatencies(\n"
+        "    ::yb::rpc::DumpRunningRpcsResponsePB* resp) const {\n"
+      );
+      for (int method_idx = 0; method_idx < service->method_count();
+           ++method_idx) {
+        const MethodDescriptor *method = service->method(method_idx);
+        subs->PushMethod(method);
+
+        Print(printer, *subs,
+          "  ::yb::rpc::DumpMethodLatencies(\n"
+          "      \"$full_service_name$\", \"$rpc_name$\", metrics_[$metric_enum_key$], resp);\n"
+        );
+
+        subs->Pop();
+      }
+      Print(printer, *subs,
+        "}\n"
+        "\n"
+      );
+
       Print(printer, *subs,
         "void $service_name$If::InitMetrics(const scoped_refptr<MetricEntity>& entity) {\n"
       );
@@ -552,6 +620,22 @@ class CodeGenerator : public ::google::protobuf::compiler::CodeGenerator {
         Print(printer, *subs,
           "  metrics_[$metric_enum_key$].handler_latency = \n"
           "      METRIC_handler_latency_$rpc_full_name_plainchars$.Instantiate(entity);\n"
+          "  {\n"
+          "    auto stages = std::make_shared<::yb::rpc::RpcCallStageMetrics>();\n"
+          "    stages->parse_time =\n"
+          "        METRIC_rpc_parse_time_$rpc_full_name_plainchars$.Instantiate(entity);\n"
+          "    stages->dispatch_time =\n"
+          "        METRIC_rpc_dispatch_time_$rpc_full_name_plainchars$.Instantiate(entity);\n"
+          "    stages->queue_time =\n"
+          "        METRIC_rpc_queue_time_$rpc_full_name_plainchars$.Instantiate(entity);\n"
+          "    stages->response_serialize_time =\n"
+          "        METRIC_rpc_response_serialize_time_$rpc_full_name_plainchars$.Instantiate(\n"
+          "            entity);\n"
+          "    stages->response_transfer_time =\n"
+          "        METRIC_rpc_response_transfer_time_$rpc_full_name_plainchars$.Instantiate(\n"
+          "            entity);\n"
+          "    metrics_[$metric_enum_key$].stages = std::move(stages);\n"
+          "  }\n"
         );
 
         subs->Pop();
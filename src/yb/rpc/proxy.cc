@@ -42,6 +42,7 @@
 
 #include <glog/logging.h>
 
+#include "yb/rpc/call_pool.h"
 #include "yb/rpc/local_call.h"
 #include "yb/rpc/outbound_call.h"
 #include "yb/rpc/messenger.h"
@@ -146,21 +147,21 @@ void Proxy::DoAsyncRequest(const RemoteMethod* method,
 
   controller->call_ =
       call_local_service_ ?
-      std::make_shared<LocalOutboundCall>(method,
-                                          outbound_call_metrics_,
-                                          resp,
-                                          controller,
-                                          &context_->rpc_metrics(),
-                                          std::move(callback)) :
-      std::make_shared<OutboundCall>(method,
-                                     outbound_call_metrics_,
-                                     resp,
-                                     controller,
-                                     &context_->rpc_metrics(),
-                                     std::move(callback),
-                                     GetCallbackThreadPool(
-                                         force_run_callback_on_reactor,
-                                         controller->invoke_callback_mode()));
+      AllocateCall<LocalOutboundCall>(method,
+                                      outbound_call_metrics_,
+                                      resp,
+                                      controller,
+                                      &context_->rpc_metrics(),
+                                      std::move(callback)) :
+      AllocateCall<OutboundCall>(method,
+                                 outbound_call_metrics_,
+                                 resp,
+                                 controller,
+                                 &context_->rpc_metrics(),
+                                 std::move(callback),
+                                 GetCallbackThreadPool(
+                                     force_run_callback_on_reactor,
+                                     controller->invoke_callback_mode()));
   auto call = controller->call_.get();
   Status s = call->SetRequestParam(req, mem_tracker_);
   if (PREDICT_FALSE(!s.ok())) {
@@ -273,7 +274,7 @@ void Proxy::ResolveDone(
 
 void Proxy::QueueCall(RpcController* controller, const Endpoint& endpoint) {
   uint8_t idx = num_calls_.fetch_add(1) % num_connections_to_server_;
-  ConnectionId conn_id(endpoint, idx, protocol_);
+  ConnectionId conn_id(endpoint, idx, protocol_, context_->OutboundNumaNode());
   controller->call_->SetConnectionId(conn_id, &remote_.host());
   context_->QueueOutboundCall(controller->call_);
 }
@@ -90,6 +90,10 @@ class ProxyContext {
   // Number of connections to create per destination address.
   virtual int num_connections_to_server() const = 0;
 
+  // NUMA node that outbound connections created by the current thread should be bound to,
+  // or -1 if connections are not placed by NUMA node.
+  virtual int OutboundNumaNode() const = 0;
+
   virtual ~ProxyContext() {}
 };
 
@@ -55,6 +55,7 @@
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rpc_introspection.pb.h"
+#include "yb/rpc/tcp_stream.h"
 #include "yb/rpc/yb_rpc.h"
 
 #include "yb/util/countdown_latch.h"
@@ -62,6 +63,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/monotime.h"
+#include "yb/util/numa.h"
 #include "yb/util/thread.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/thread_restrictions.h"
@@ -74,6 +76,7 @@ using namespace std::literals;
 DECLARE_string(local_ip_for_outbound_sockets);
 DECLARE_int32(num_connections_to_server);
 DECLARE_int32(socket_receive_buffer_size);
+DECLARE_bool(rpc_numa_aware_placement);
 
 namespace yb {
 namespace rpc {
@@ -127,11 +130,17 @@ Reactor::Reactor(Messenger* messenger,
       cur_time_(CoarseMonoClock::Now()),
       last_unused_tcp_scan_(cur_time_),
       connection_keepalive_time_(bld.connection_keepalive_time()),
-      coarse_timer_granularity_(bld.coarse_timer_granularity()),
-      num_connections_to_server_(bld.num_connections_to_server()) {
+      coarse_timer_granularity_(bld.coarse_timer_granularity()) {
   static std::once_flag libev_once;
   std::call_once(libev_once, DoInitLibEv);
 
+  if (FLAGS_rpc_numa_aware_placement) {
+    const auto& topology = NumaTopology::Instance();
+    if (topology.num_nodes() > 1) {
+      numa_node_ = topology.nodes()[index % topology.num_nodes()];
+    }
+  }
+
   VLOG_WITH_PREFIX(1) << "Create reactor with keep alive_time: "
                       << yb::ToString(connection_keepalive_time_)
                       << ", coarse timer granularity: " << yb::ToString(coarse_timer_granularity_);
@@ -478,20 +487,25 @@ void Reactor::RunThread() {
   ThreadRestrictions::SetWaitAllowed(false);
   ThreadRestrictions::SetIOAllowed(false);
   DVLOG_WITH_PREFIX(6) << "Calling Reactor::RunThread()...";
+  if (numa_node_ >= 0) {
+    WARN_NOT_OK(BindCurrentThreadToNumaNode(numa_node_), LogPrefix() + "Bind failed");
+  }
   loop_.run(/* flags */ 0);
   VLOG_WITH_PREFIX(1) << "thread exiting.";
 }
 
 namespace {
 
-Result<Socket> CreateClientSocket(const Endpoint& remote) {
+Result<Socket> CreateClientSocket(const Endpoint& remote, bool unix_domain) {
   int flags = Socket::FLAG_NONBLOCKING;
-  if (remote.address().is_v6()) {
+  if (unix_domain) {
+    flags |= Socket::FLAG_UNIX_DOMAIN;
+  } else if (remote.address().is_v6()) {
     flags |= Socket::FLAG_IPV6;
   }
   Socket socket;
   Status status = socket.Init(flags);
-  if (status.ok()) {
+  if (status.ok() && !unix_domain) {
     status = socket.SetNoDelay(true);
   }
   LOG_IF(WARNING, !status.ok()) << "failed to create an "
@@ -534,8 +548,12 @@ Status Reactor::FindOrStartConnection(const ConnectionId &conn_id,
                       << conn_id.ToString();
 
   // Create a new socket and start connecting to the remote.
-  auto sock = VERIFY_RESULT(CreateClientSocket(conn_id.remote()));
-  if (!messenger_->test_outbound_ip_base_.is_unspecified()) {
+  // Server on the same host is reached over Unix domain socket, when it is available.
+  auto unix_socket_path = FindLocalUnixSocketPath(conn_id.remote());
+  auto sock = VERIFY_RESULT(CreateClientSocket(conn_id.remote(), !unix_socket_path.empty()));
+  if (!unix_socket_path.empty()) {
+    VLOG_WITH_PREFIX(2) << "Connecting to " << conn_id.remote() << " via " << unix_socket_path;
+  } else if (!messenger_->test_outbound_ip_base_.is_unspecified()) {
     auto address_bytes(messenger_->test_outbound_ip_base_.to_v4().to_bytes());
     // Use different addresses for public/private endpoints.
     // Private addresses are even, and public are odd.
@@ -568,7 +586,7 @@ Status Reactor::FindOrStartConnection(const ConnectionId &conn_id,
   auto stream = VERIFY_RESULT(CreateStream(
       messenger_->stream_factories_, conn_id.protocol(),
       {conn_id.remote(), hostname, &sock,
-       messenger_->connection_context_factory_->buffer_tracker()}));
+       messenger_->connection_context_factory_->buffer_tracker(), std::move(unix_socket_path)}));
 
   // Register the new connection in our map.
   auto connection = std::make_shared<Connection>(
@@ -634,12 +652,14 @@ void Reactor::DestroyConnection(Connection *conn, const Status &conn_status) {
 
   // Unlink connection from lists.
   if (conn->direction() == ConnectionDirection::CLIENT) {
+    // Connection id also contains NUMA node of the connection, so look it up by value.
     bool erased = false;
-    for (int idx = 0; idx < num_connections_to_server_; idx++) {
-      auto it = client_conns_.find(ConnectionId(conn->remote(), idx, conn->protocol()));
-      if (it != client_conns_.end() && it->second.get() == conn) {
-        client_conns_.erase(it);
+    for (auto it = client_conns_.begin(); it != client_conns_.end();) {
+      if (it->second.get() == conn) {
+        it = client_conns_.erase(it);
         erased = true;
+      } else {
+        ++it;
       }
     }
     if (!erased) {
@@ -316,6 +316,9 @@ class Reactor {
 
   Messenger *messenger() const { return messenger_; }
 
+  // NUMA node this reactor thread is bound to, or -1 if NUMA aware placement is disabled.
+  int numa_node() const { return numa_node_; }
+
   CoarseTimePoint cur_time() const { return cur_time_; }
 
   // Drop all connections with remote address. Used in tests with broken connectivity.
@@ -500,8 +503,7 @@ class Reactor {
   std::vector<ConnectionPtr> processing_connections_;
   ReactorTaskPtr process_outbound_queue_task_;
 
-  // Number of outbound connections to create per each destination server address.
-  int num_connections_to_server_;
+  int numa_node_ = -1;
 };
 
 }  // namespace rpc
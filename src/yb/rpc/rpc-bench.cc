@@ -35,6 +35,7 @@
 
 #include <gtest/gtest.h>
 
+#include "yb/rpc/call_pool.h"
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rtest.proxy.h"
 #include "yb/util/countdown_latch.h"
@@ -42,6 +43,8 @@
 
 using namespace std::literals; // NOLINT
 
+DECLARE_bool(rpc_use_call_pool);
+
 using std::string;
 using std::shared_ptr;
 
@@ -150,6 +153,54 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+// Checks that call pool serves almost all call allocations without going to heap.
+TEST_F(RpcBench, BenchmarkCallAllocations) {
+  StartTestServerWithGeneratedCode(&server_hostport_);
+
+  constexpr int kNumThreads = 4;
+  size_t heap_allocations_per_mode[2];
+  size_t reqs_per_mode[2];
+  for (bool use_call_pool : {false, true}) {
+    FLAGS_rpc_use_call_pool = use_call_pool;
+    should_run_.store(true, std::memory_order_release);
+    auto heap_allocations_before = CallMemoryPool::Instance().heap_allocations();
+
+    std::vector<std::unique_ptr<ClientThread>> threads;
+    for (int i = 0; i < kNumThreads; i++) {
+      auto thr = std::make_unique<ClientThread>(this);
+      thr->Start();
+      threads.push_back(std::move(thr));
+    }
+
+    std::this_thread::sleep_for(5s);
+    should_run_.store(false, std::memory_order_release);
+
+    int total_reqs = 0;
+    for (const auto& thr : threads) {
+      thr->Join();
+      total_reqs += thr->request_count_;
+    }
+
+    auto heap_allocations =
+        CallMemoryPool::Instance().heap_allocations() - heap_allocations_before;
+    LOG(INFO) << "Use call pool:          " << use_call_pool;
+    LOG(INFO) << "Calls:                  " << total_reqs;
+    LOG(INFO) << "Call heap allocations:  " << heap_allocations;
+    LOG(INFO) << "Heap allocations / req: " << static_cast<double>(heap_allocations) / total_reqs;
+    heap_allocations_per_mode[use_call_pool] = heap_allocations;
+    reqs_per_mode[use_call_pool] = total_reqs;
+  }
+
+  // Without pool every call takes at least one block from heap.
+  ASSERT_GT(reqs_per_mode[false], 0U);
+  ASSERT_GE(heap_allocations_per_mode[false], reqs_per_mode[false]);
+
+  // With pool heap is hit only while pools are warming up, or when a block is released on a CPU
+  // whose pool is already full.
+  ASSERT_GT(reqs_per_mode[true], 0U);
+  ASSERT_LT(heap_allocations_per_mode[true] * 10, reqs_per_mode[true]);
+}
+
 } // namespace rpc
 } // namespace yb
 
@@ -32,6 +32,8 @@
 
 #include "yb/rpc/rpc-test-base.h"
 
+#include <unistd.h>
+
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -44,14 +46,19 @@
 
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/join.h"
+#include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/serialization.h"
+#include "yb/rpc/tcp_stream.h"
 #include "yb/rpc/yb_rpc.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/env.h"
+#include "yb/util/numa.h"
 #include "yb/util/test_util.h"
 
 METRIC_DECLARE_histogram(handler_latency_yb_rpc_test_CalculatorService_Sleep);
 METRIC_DECLARE_histogram(rpc_incoming_queue_time);
+METRIC_DECLARE_histogram(rpc_queue_time_yb_rpc_test_CalculatorService_Sleep);
+METRIC_DECLARE_histogram(rpc_response_transfer_time_yb_rpc_test_CalculatorService_Sleep);
 
 DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -59,6 +66,9 @@ DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
 DECLARE_uint64(rpc_connection_timeout_ms);
 DECLARE_int32(num_connections_to_server);
 DECLARE_bool(enable_rpc_keepalive);
+DECLARE_string(rpc_unix_socket_dir);
+DECLARE_bool(rpc_numa_aware_placement);
+DECLARE_bool(rpc_use_protobuf_arena);
 
 using namespace std::chrono_literals;
 using std::string;
@@ -171,6 +181,97 @@ TEST_F(TestRpc, TestCall) {
   }
 }
 
+// Test that client connects to the server on the same host over Unix domain socket.
+TEST_F(TestRpc, TestCallOverUnixDomainSocket) {
+  FLAGS_rpc_unix_socket_dir = "/tmp";
+
+  Endpoint server_endpoint;
+  StartTestServer(&server_endpoint);
+  const auto server_addr = HostPort::FromBoundEndpoint(server_endpoint);
+
+  std::unique_ptr<Messenger> client_messenger = CreateMessenger("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  for (int i = 0; i < 10; i++) {
+    ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+  }
+
+  // Peer of the connection accepted over Unix domain socket is reported with the address of
+  // the server endpoint, since it is on the same host.
+  DumpRunningRpcsRequestPB dump_req;
+  DumpRunningRpcsResponsePB dump_resp;
+  ASSERT_OK(server_messenger()->DumpRunningRpcs(dump_req, &dump_resp));
+  ASSERT_EQ(1, dump_resp.inbound_connections().size());
+  ASSERT_EQ(yb::ToString(server_endpoint), dump_resp.inbound_connections(0).remote_ip());
+}
+
+// Test that client falls back to TCP when Unix domain socket of the server is stale.
+TEST_F(TestRpc, TestCallWithStaleUnixDomainSocket) {
+  Endpoint server_endpoint;
+  StartTestServer(&server_endpoint);
+  const auto server_addr = HostPort::FromBoundEndpoint(server_endpoint);
+
+  FLAGS_rpc_unix_socket_dir = "/tmp";
+  const auto path = UnixSocketPathForEndpoint(server_endpoint);
+  {
+    // Socket file stays after the socket is closed, but nobody listens on it.
+    Socket stale_socket;
+    ASSERT_OK(stale_socket.Init(Socket::FLAG_UNIX_DOMAIN));
+    ASSERT_OK(stale_socket.BindUnixDomain(path));
+  }
+  ASSERT_FALSE(FindLocalUnixSocketPath(server_endpoint).empty());
+
+  std::unique_ptr<Messenger> client_messenger = CreateMessenger("Client");
+  Proxy p(client_messenger.get(), server_addr);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+  }
+
+  ASSERT_EQ(0, unlink(path.c_str()));
+}
+
+// Test that outbound calls are queued to a reactor on the NUMA node of the calling thread.
+TEST_F(TestRpc, TestNumaAwarePlacement) {
+  FLAGS_rpc_numa_aware_placement = true;
+
+  const auto& topology = NumaTopology::Instance();
+  if (topology.num_nodes() < 2) {
+    LOG(INFO) << "Skipping test, there is a single NUMA node: " << topology.ToString();
+    return;
+  }
+
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+
+  // At least one reactor per node.
+  auto client_options = kDefaultClientMessengerOptions;
+  client_options.n_reactors = topology.num_nodes();
+  client_options.num_connections_to_server = 1;
+  std::unique_ptr<Messenger> client_messenger = CreateMessenger("Client", client_options);
+  Proxy p(client_messenger.get(), server_addr);
+
+  constexpr int kCallsPerNode = 10;
+  for (int node : topology.nodes()) {
+    std::thread thread([this, &p, node] {
+      ASSERT_OK(BindCurrentThreadToNumaNode(node));
+      for (int i = 0; i < kCallsPerNode; i++) {
+        ASSERT_OK(DoTestSyncCall(&p, CalculatorServiceMethods::AddMethod()));
+      }
+    });
+    thread.join();
+  }
+
+  auto& metrics = client_messenger->rpc_metrics();
+  ASSERT_GE(metrics.outbound_calls_created->value(), kCallsPerNode * topology.num_nodes());
+  ASSERT_EQ(0, metrics.outbound_calls_cross_numa_node->value());
+
+  // Calls from each node use their own connection, since node is part of connection id.
+  DumpRunningRpcsRequestPB dump_req;
+  DumpRunningRpcsResponsePB dump_resp;
+  ASSERT_OK(client_messenger->DumpRunningRpcs(dump_req, &dump_resp));
+  ASSERT_EQ(topology.num_nodes(), static_cast<size_t>(dump_resp.outbound_connections_size()));
+}
+
 // Test that connecting to an invalid server properly throws an error.
 TEST_F(TestRpc, TestCallToBadServer) {
   std::unique_ptr<Messenger> client_messenger = CreateMessenger("Client");
@@ -585,6 +686,67 @@ TEST_F(TestRpc, TestRpcHandlerLatencyMetric) {
   YB_ASSERT_TRUE(FindOrDie(metric_map, &METRIC_rpc_incoming_queue_time));
 }
 
+// Test that generated service handles calls with messages allocated on an arena and on the heap.
+TEST_F(TestRpc, TestProtobufArenaMessages) {
+  HostPort server_addr;
+  StartTestServerWithGeneratedCode(&server_addr);
+
+  std::unique_ptr<Messenger> client_messenger = CreateMessenger("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  for (bool use_arena : {true, false}) {
+    FLAGS_rpc_use_protobuf_arena = use_arena;
+    for (size_t size : {0, 100, 10000, 100000}) {
+      RpcController controller;
+      rpc_test::EchoRequestPB req;
+      req.set_data(RandomHumanReadableString(size));
+      rpc_test::EchoResponsePB resp;
+      ASSERT_OK(p.SyncRequest(CalculatorServiceMethods::EchoMethod(), req, &resp, &controller));
+      ASSERT_EQ(req.data(), resp.data());
+      ASSERT_EQ(use_arena, resp.on_arena());
+    }
+  }
+}
+
+// Test per method latency breakdown of inbound call stages.
+TEST_F(TestRpc, TestRpcStageLatencyMetrics) {
+  HostPort server_addr;
+  StartTestServerWithGeneratedCode(&server_addr);
+
+  std::unique_ptr<Messenger> client_messenger = CreateMessenger("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  RpcController controller;
+  rpc_test::SleepRequestPB req;
+  req.set_sleep_micros(1000);
+  rpc_test::SleepResponsePB resp;
+  ASSERT_OK(p.SyncRequest(CalculatorServiceMethods::SleepMethod(), req, &resp, &controller));
+
+  const auto metric_map = server_messenger()->metric_entity()->UnsafeMetricsMapForTests();
+  auto queue_time = down_cast<Histogram*>(FindOrDie(
+      metric_map, &METRIC_rpc_queue_time_yb_rpc_test_CalculatorService_Sleep).get());
+  auto transfer_time = down_cast<Histogram*>(FindOrDie(
+      metric_map, &METRIC_rpc_response_transfer_time_yb_rpc_test_CalculatorService_Sleep).get());
+
+  // Transfer notification could arrive after the client has already received the response.
+  ASSERT_OK(WaitFor([transfer_time] { return transfer_time->TotalCount() == 1; },
+                    10s, "Response transferred"));
+  ASSERT_EQ(1, queue_time->TotalCount());
+
+  DumpRunningRpcsRequestPB dump_req;
+  dump_req.set_include_latency_breakdown(true);
+  DumpRunningRpcsResponsePB dump_resp;
+  ASSERT_OK(server_messenger()->DumpRunningRpcs(dump_req, &dump_resp));
+  bool found = false;
+  for (const auto& method_latency : dump_resp.method_latencies()) {
+    if (method_latency.method_name() == "Sleep") {
+      ASSERT_EQ(6, method_latency.stages().size());
+      found = true;
+    }
+  }
+  ASSERT_TRUE(found);
+}
+
 TEST_F(TestRpc, TestRpcCallbackDestroysMessenger) {
   std::unique_ptr<Messenger> client_messenger = CreateMessenger("Client");
   HostPort bad_addr;
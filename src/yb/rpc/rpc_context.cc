@@ -33,6 +33,7 @@
 #include "yb/rpc/rpc_context.h"
 
 #include <ostream>
+#include <algorithm>
 #include <sstream>
 
 #include <boost/core/null_deleter.hpp>
@@ -49,12 +50,22 @@
 #include "yb/util/metrics.h"
 #include "yb/util/trace.h"
 #include "yb/util/debug/trace_event.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/jsonwriter.h"
 #include "yb/util/pb_util.h"
 
 using google::protobuf::Message;
 DECLARE_int32(rpc_max_message_size);
 
+DEFINE_bool(rpc_use_protobuf_arena, true,
+            "Allocate request and response of inbound calls on a per call protobuf arena, "
+            "for services whose protos enable arenas.");
+TAG_FLAG(rpc_use_protobuf_arena, runtime);
+
+DEFINE_int32(rpc_protobuf_arena_start_block_size, 4096,
+             "Size of the first block of a per call protobuf arena.");
+TAG_FLAG(rpc_protobuf_arena_start_block_size, advanced);
+
 namespace yb {
 namespace rpc {
 
@@ -91,6 +102,16 @@ scoped_refptr<debug::ConvertableToTraceFormat> TracePb(const Message& msg) {
 }
 }  // anonymous namespace
 
+std::shared_ptr<google::protobuf::Arena> CreateRpcArena() {
+  if (!FLAGS_rpc_use_protobuf_arena) {
+    return nullptr;
+  }
+  google::protobuf::ArenaOptions options;
+  options.start_block_size = FLAGS_rpc_protobuf_arena_start_block_size;
+  options.max_block_size = std::max<size_t>(options.max_block_size, options.start_block_size);
+  return std::make_shared<google::protobuf::Arena>(options);
+}
+
 RpcContext::~RpcContext() {
   if (call_ && !responded_) {
     LOG(DFATAL) << "RpcContext is destroyed, but response has not been sent, for call: "
@@ -106,6 +127,7 @@ RpcContext::RpcContext(std::shared_ptr<YBInboundCall> call,
       request_pb_(request_pb),
       response_pb_(std::move(response_pb)),
       metrics_(metrics) {
+  call_->SetStageMetrics(metrics_.stages);
   const Status s = call_->ParseParam(request_pb.get());
   if (PREDICT_FALSE(!s.ok())) {
     RespondRpcFailure(ErrorStatusPB::ERROR_INVALID_REQUEST, s);
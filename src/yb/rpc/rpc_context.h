@@ -34,6 +34,8 @@
 
 #include <string>
 
+#include <google/protobuf/arena.h>
+
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/rpc/rpc_header.pb.h"
 #include "yb/rpc/service_if.h"
@@ -60,6 +62,9 @@ namespace rpc {
 
 class YBInboundCall;
 
+// Returns arena for messages of an inbound call, or nullptr when arenas are disabled.
+std::shared_ptr<google::protobuf::Arena> CreateRpcArena();
+
 // The context provided to a generated ServiceIf. This provides
 // methods to respond to the RPC. In the future, this will also
 // include methods to access information about the caller: e.g
@@ -77,6 +82,24 @@ class RpcContext {
   RpcContext(std::shared_ptr<LocalYBInboundCall> call,
              RpcMethodMetrics metrics);
 
+  // Create an RpcContext whose request and response are allocated on a per call arena, that is
+  // released when both of them are destroyed. Used by generated code for protos that enable arenas.
+  template <class Req, class Resp>
+  static RpcContext CreateWithArena(std::shared_ptr<YBInboundCall> call,
+                                    RpcMethodMetrics metrics) {
+    auto arena = CreateRpcArena();
+    if (!arena) {
+      return RpcContext(std::move(call), std::make_shared<Req>(), std::make_shared<Resp>(),
+                        std::move(metrics));
+    }
+    auto* request = google::protobuf::Arena::CreateMessage<Req>(arena.get());
+    auto* response = google::protobuf::Arena::CreateMessage<Resp>(arena.get());
+    return RpcContext(std::move(call),
+                      std::shared_ptr<Req>(arena, request),
+                      std::shared_ptr<Resp>(std::move(arena), response),
+                      std::move(metrics));
+  }
+
   RpcContext(RpcContext&& rhs)
       : call_(std::move(rhs.call_)),
         request_pb_(std::move(rhs.request_pb_)),
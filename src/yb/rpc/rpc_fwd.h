@@ -69,6 +69,7 @@ class LocalYBInboundCall;
 
 struct CallData;
 struct ProcessDataResult;
+struct RpcCallStageMetrics;
 struct RpcMethodMetrics;
 struct RpcMetrics;
 
@@ -97,6 +98,8 @@ typedef std::shared_ptr<ServerEventList> ServerEventListPtr;
 class ServiceIf;
 typedef std::shared_ptr<ServiceIf> ServiceIfPtr;
 
+class DumpRunningRpcsRequestPB;
+class DumpRunningRpcsResponsePB;
 class ErrorStatusPB;
 
 typedef boost::asio::io_service IoService;
@@ -43,6 +43,18 @@ METRIC_DEFINE_counter(server, rpc_outbound_calls_created,
                       yb::MetricUnit::kRequests,
                       "Number of created RPC outbound calls.");
 
+METRIC_DEFINE_counter(server, rpc_inbound_calls_cross_numa_node,
+                      "Number of RPC inbound calls handled on another NUMA node.",
+                      yb::MetricUnit::kRequests,
+                      "Number of RPC inbound calls that were handled by a worker running on a "
+                      "different NUMA node than the reactor that received them.");
+
+METRIC_DEFINE_counter(server, rpc_outbound_calls_cross_numa_node,
+                      "Number of RPC outbound calls sent from another NUMA node.",
+                      yb::MetricUnit::kRequests,
+                      "Number of RPC outbound calls that were queued to a reactor running on a "
+                      "different NUMA node than the caller.");
+
 namespace yb {
 namespace rpc {
 
@@ -54,6 +66,10 @@ RpcMetrics::RpcMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
     inbound_calls_created = METRIC_rpc_inbound_calls_created.Instantiate(metric_entity);
     outbound_calls_alive = METRIC_rpc_outbound_calls_alive.Instantiate(metric_entity, 0);
     outbound_calls_created = METRIC_rpc_outbound_calls_created.Instantiate(metric_entity);
+    inbound_calls_cross_numa_node =
+        METRIC_rpc_inbound_calls_cross_numa_node.Instantiate(metric_entity);
+    outbound_calls_cross_numa_node =
+        METRIC_rpc_outbound_calls_cross_numa_node.Instantiate(metric_entity);
   }
 }
 
@@ -28,6 +28,8 @@ struct RpcMetrics {
   scoped_refptr<Counter> inbound_calls_created;
   scoped_refptr<AtomicGauge<int64_t>> outbound_calls_alive;
   scoped_refptr<Counter> outbound_calls_created;
+  scoped_refptr<Counter> inbound_calls_cross_numa_node;
+  scoped_refptr<Counter> outbound_calls_cross_numa_node;
 };
 
 } // namespace rpc
@@ -49,6 +49,9 @@ class RpcService : public RefCountedThreadSafe<RpcService> {
   // Handle a call directly.
   virtual void Handle(InboundCallPtr call) = 0;
 
+  // Appends per method latency breakdown of this service to resp.
+  virtual void DumpMethodLatencies(DumpRunningRpcsResponsePB* resp) const {}
+
   // Initiate RPC service shutdown.
   // Two phase shutdown is required to prevent shutdown deadlock of 2 dependent resources.
   virtual void StartShutdown() = 0;
@@ -39,6 +39,7 @@
 #include "yb/rpc/connection.h"
 #include "yb/rpc/inbound_call.h"
 #include "yb/rpc/rpc_header.pb.h"
+#include "yb/rpc/rpc_introspection.pb.h"
 
 using std::string;
 using strings::Substitute;
@@ -59,5 +60,41 @@ ServiceIf::~ServiceIf() {
 void ServiceIf::Shutdown() {
 }
 
+namespace {
+
+void AddStageLatency(const scoped_refptr<Histogram>& histogram, RpcMethodLatencyPB* out) {
+  if (!histogram) {
+    return;
+  }
+  MetricJsonOptions opts;
+  opts.include_schema_info = true;
+  WARN_NOT_OK(histogram->GetHistogramSnapshotPB(out->add_stages(), opts),
+              "Failed to get histogram snapshot");
+}
+
+} // namespace
+
+void DumpMethodLatencies(
+    const std::string& service_name, const std::string& method_name,
+    const RpcMethodMetrics& metrics, DumpRunningRpcsResponsePB* resp) {
+  if (!metrics.handler_latency || metrics.handler_latency->TotalCount() == 0) {
+    return;
+  }
+  auto* out = resp->add_method_latencies();
+  out->set_service_name(service_name);
+  out->set_method_name(method_name);
+  const auto* stages = metrics.stages.get();
+  if (stages) {
+    AddStageLatency(stages->parse_time, out);
+    AddStageLatency(stages->dispatch_time, out);
+    AddStageLatency(stages->queue_time, out);
+  }
+  AddStageLatency(metrics.handler_latency, out);
+  if (stages) {
+    AddStageLatency(stages->response_serialize_time, out);
+    AddStageLatency(stages->response_transfer_time, out);
+  }
+}
+
 } // namespace rpc
 } // namespace yb
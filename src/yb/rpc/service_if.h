@@ -32,6 +32,7 @@
 #ifndef YB_RPC_SERVICE_IF_H_
 #define YB_RPC_SERVICE_IF_H_
 
+#include <memory>
 #include <string>
 
 #include "yb/gutil/macros.h"
@@ -52,14 +53,37 @@ class Histogram;
 
 namespace rpc {
 
+// Latency of the stages that an inbound call passes through outside of its handler,
+// see InboundCallTiming.
+struct RpcCallStageMetrics {
+  // Time between reading the last chunk of the request from the socket and parsing the call.
+  scoped_refptr<Histogram> parse_time;
+  // Time between parsing the call and putting it into the service queue.
+  scoped_refptr<Histogram> dispatch_time;
+  // Time spent in the service queue.
+  scoped_refptr<Histogram> queue_time;
+  // Time between handler completion and queueing of the serialized response.
+  scoped_refptr<Histogram> response_serialize_time;
+  // Time between queueing of the response and writing it to the socket.
+  scoped_refptr<Histogram> response_transfer_time;
+};
+
 struct RpcMethodMetrics {
   RpcMethodMetrics();
   explicit RpcMethodMetrics(scoped_refptr<Histogram> handler_latency);
   ~RpcMethodMetrics();
 
   scoped_refptr<Histogram> handler_latency;
+
+  // Shared between calls, so copying RpcMethodMetrics for each call stays cheap.
+  std::shared_ptr<const RpcCallStageMetrics> stages;
 };
 
+// Appends latency breakdown of the specified method to resp, when method was called at least once.
+void DumpMethodLatencies(
+    const std::string& service_name, const std::string& method_name,
+    const RpcMethodMetrics& metrics, DumpRunningRpcsResponsePB* resp);
+
 // Handles incoming messages that initiate an RPC.
 class ServiceIf {
  public:
@@ -68,6 +92,9 @@ class ServiceIf {
 
   virtual void Shutdown();
   virtual std::string service_name() const = 0;
+
+  // Appends per method latency breakdown of this service to resp.
+  virtual void DumpMethodLatencies(DumpRunningRpcsResponsePB* resp) const {}
 };
 
 }  // namespace rpc
@@ -168,6 +168,7 @@ class ServicePoolImpl final : public InboundCallHandler {
 
   void Enqueue(const InboundCallPtr& call) {
     TRACE_TO(call->trace(), "Inserting onto call queue");
+    call->RecordQueued();
 
     auto task = call->BindTask(this);
     if (!task) {
@@ -197,6 +198,10 @@ class ServicePoolImpl final : public InboundCallHandler {
     return service_->service_name();
   }
 
+  void DumpMethodLatencies(DumpRunningRpcsResponsePB* resp) const {
+    service_->DumpMethodLatencies(resp);
+  }
+
   void Overflow(const InboundCallPtr& call, const char* type, size_t limit) {
     const auto err_msg =
         Substitute("$0 request on $1 from $2 dropped due to backpressure. "
@@ -472,5 +477,9 @@ std::string ServicePool::service_name() const {
   return impl_->service_name();
 }
 
+void ServicePool::DumpMethodLatencies(DumpRunningRpcsResponsePB* resp) const {
+  impl_->DumpMethodLatencies(resp);
+}
+
 } // namespace rpc
 } // namespace yb
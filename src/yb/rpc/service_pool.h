@@ -71,6 +71,7 @@ class ServicePool : public RpcService {
 
   void QueueInboundCall(InboundCallPtr call) override;
   void Handle(InboundCallPtr call) override;
+  void DumpMethodLatencies(DumpRunningRpcsResponsePB* resp) const override;
   const Counter* RpcsTimedOutInQueueMetricForTests() const;
   const Counter* RpcsQueueOverflowMetric() const;
   std::string service_name() const;
@@ -143,6 +143,9 @@ struct StreamCreateData {
   const std::string& remote_hostname;
   Socket* socket;
   std::shared_ptr<MemTracker> mem_tracker;
+  // When not empty, socket is a Unix domain socket that should be connected to this path,
+  // instead of remote.
+  std::string unix_socket_path;
 };
 
 class StreamFactory {
@@ -13,17 +13,28 @@
 
 #include "yb/rpc/tcp_stream.h"
 
+#include <sys/stat.h>
+
+#include <algorithm>
+
 #include "yb/rpc/outbound_data.h"
 
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/path_util.h"
 #include "yb/util/string_util.h"
+#include "yb/util/net/net_util.h"
 
 using namespace std::literals;
 
 DECLARE_uint64(rpc_connection_timeout_ms);
 DEFINE_test_flag(int32, TEST_delay_connect_ms, 0,
                  "Delay connect in tests for specified amount of milliseconds.");
+DEFINE_string(rpc_unix_socket_dir, "",
+              "When not empty, RPC servers also accept connections on Unix domain sockets in this "
+              "directory, and clients connect to servers on the same host over those sockets, "
+              "bypassing the TCP stack. Should be set to the same value for servers and clients.");
+TAG_FLAG(rpc_unix_socket_dir, advanced);
 
 namespace yb {
 namespace rpc {
@@ -32,11 +43,54 @@ namespace {
 
 const size_t kMaxIov = 16;
 
+bool UnixSocketExists(const std::string& path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode);
+}
+
+bool IsLocalAddress(const IpAddress& address) {
+  if (address.is_loopback()) {
+    return true;
+  }
+  static const std::vector<IpAddress> local_addresses = [] {
+    std::vector<IpAddress> result;
+    WARN_NOT_OK(GetLocalAddresses(&result, AddressFilter::ANY), "Failed to get local addresses");
+    return result;
+  }();
+  return std::find(local_addresses.begin(), local_addresses.end(), address) !=
+         local_addresses.end();
+}
+
+}
+
+std::string UnixSocketPathForEndpoint(const Endpoint& endpoint) {
+  if (FLAGS_rpc_unix_socket_dir.empty()) {
+    return std::string();
+  }
+  return JoinPathSegments(FLAGS_rpc_unix_socket_dir, Format(".yb.rpc.$0", endpoint));
+}
+
+std::string FindLocalUnixSocketPath(const Endpoint& remote) {
+  auto result = UnixSocketPathForEndpoint(remote);
+  if (result.empty() || UnixSocketExists(result)) {
+    return result;
+  }
+  // Server listening on all addresses creates socket for the wildcard address, but we should
+  // use it only when remote is actually this host.
+  if (!IsLocalAddress(remote.address())) {
+    return std::string();
+  }
+  auto wildcard = remote.address().is_v6() ? IpAddress(boost::asio::ip::address_v6::any())
+                                           : IpAddress(boost::asio::ip::address_v4::any());
+  result = UnixSocketPathForEndpoint(Endpoint(wildcard, remote.port()));
+  return UnixSocketExists(result) ? result : std::string();
 }
 
 TcpStream::TcpStream(const StreamCreateData& data)
     : socket_(std::move(*data.socket)),
-      remote_(data.remote) {
+      remote_(data.remote),
+      unix_socket_path_(data.unix_socket_path),
+      unix_domain_(!unix_socket_path_.empty() || socket_.IsUnixDomain()) {
   if (data.mem_tracker) {
     mem_tracker_ = MemTracker::FindOrCreateTracker("Sending", data.mem_tracker);
   }
@@ -57,10 +111,7 @@ Status TcpStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context
   context_ = context;
   connected_ = !connect;
 
-  RETURN_NOT_OK(socket_.SetNoDelay(true));
-  // These timeouts don't affect non-blocking sockets:
-  RETURN_NOT_OK(socket_.SetSendTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
-  RETURN_NOT_OK(socket_.SetRecvTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
+  RETURN_NOT_OK(SetSocketOptions());
 
   if (connect && FLAGS_TEST_delay_connect_ms) {
     connect_delayer_.set(*loop);
@@ -73,16 +124,48 @@ Status TcpStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context
   return DoStart(loop, connect);
 }
 
+Status TcpStream::SetSocketOptions() {
+  if (!unix_domain_) {
+    RETURN_NOT_OK(socket_.SetNoDelay(true));
+  }
+  // These timeouts don't affect non-blocking sockets:
+  RETURN_NOT_OK(socket_.SetSendTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
+  RETURN_NOT_OK(socket_.SetRecvTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
+  return Status::OK();
+}
+
+Status TcpStream::ResetToTcpSocket() {
+  RETURN_NOT_OK(socket_.Close());
+  RETURN_NOT_OK(socket_.Init(
+      Socket::FLAG_NONBLOCKING | (remote_.address().is_v6() ? Socket::FLAG_IPV6 : 0)));
+  unix_socket_path_.clear();
+  unix_domain_ = false;
+  return SetSocketOptions();
+}
+
 Status TcpStream::DoStart(ev::loop_ref* loop, bool connect) {
   if (connect) {
-    auto status = socket_.Connect(remote_);
+    auto status = unix_socket_path_.empty() ? socket_.Connect(remote_)
+                                            : socket_.ConnectUnixDomain(unix_socket_path_);
+    if (!status.ok() && !unix_socket_path_.empty() && !Socket::IsTemporarySocketError(status)) {
+      // Socket file could be left by a server that is not running anymore, or is not accessible.
+      LOG_WITH_PREFIX(INFO) << "Connect via " << unix_socket_path_ << " failed: " << status
+                            << ", falling back to TCP";
+      status = ResetToTcpSocket();
+      if (status.ok()) {
+        status = socket_.Connect(remote_);
+      }
+    }
     if (!status.ok() && !Socket::IsTemporarySocketError(status)) {
       LOG_WITH_PREFIX(WARNING) << "Connect failed: " << status;
       return status;
     }
   }
 
-  RETURN_NOT_OK(socket_.GetSocketAddress(&local_));
+  // Unix domain socket does not have IP address, so local_ is left unspecified for it.
+  if (!unix_domain_) {
+    RETURN_NOT_OK(socket_.GetSocketAddress(&local_));
+  }
   log_prefix_.clear();
 
   io_.set(*loop);
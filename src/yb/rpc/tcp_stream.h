@@ -25,6 +25,16 @@
 namespace yb {
 namespace rpc {
 
+// Returns path of Unix domain socket that local server listening on endpoint accepts connections
+// on. Returns empty string when Unix domain sockets are disabled.
+std::string UnixSocketPathForEndpoint(const Endpoint& endpoint);
+
+// Returns path of Unix domain socket of the local server listening on remote, or empty string
+// if there is no such server.
+std::string FindLocalUnixSocketPath(const Endpoint& remote);
+
+// Stream over a TCP socket, or over a Unix domain socket connected to a server on the same host.
+// Both kinds of sockets are handled identically after the connection is established.
 class TcpStream : public Stream {
  public:
   explicit TcpStream(const StreamCreateData& data);
@@ -86,6 +96,12 @@ class TcpStream : public Stream {
 
   CHECKED_STATUS DoStart(ev::loop_ref* loop, bool connect);
 
+  // Replaces Unix domain socket with a TCP socket, used when connect to the local socket failed.
+  CHECKED_STATUS ResetToTcpSocket();
+
+  // Applies socket options that should be set before connect.
+  CHECKED_STATUS SetSocketOptions();
+
   StreamReadBuffer& ReadBuffer() {
     return context_->ReadBuffer();
   }
@@ -101,6 +117,12 @@ class TcpStream : public Stream {
   // The remote address we're talking to.
   const Endpoint remote_;
 
+  // Path to connect to, when socket_ is a client Unix domain socket.
+  std::string unix_socket_path_;
+
+  // Whether socket_ is a Unix domain socket.
+  bool unix_domain_ = false;
+
   StreamContext* context_;
 
   // Notifies us when our socket is readable or writable.
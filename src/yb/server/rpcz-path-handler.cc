@@ -62,6 +62,8 @@ void RpczPathHandler(Messenger* messenger,
 
   string arg = FindWithDefault(req.parsed_args, "include_traces", "false");
   dump_req.set_include_traces(ParseLeadingBoolValue(arg.c_str(), false));
+  arg = FindWithDefault(req.parsed_args, "include_latency_breakdown", "false");
+  dump_req.set_include_latency_breakdown(ParseLeadingBoolValue(arg.c_str(), false));
 
   WARN_NOT_OK(messenger->DumpRunningRpcs(dump_req, &dump_resp),
              "DumpRunningRpcs failed");
@@ -0,0 +1,112 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/conflict_history.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "yb/docdb/doc_key.h"
+
+#include "yb/gutil/walltime.h"
+
+#include "yb/tablet/tablet_metrics.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/metrics.h"
+
+DEFINE_int32(transaction_conflict_history_size, 256,
+             "Max number of recent transaction conflicts kept per tablet for diagnostics. "
+             "0 to disable.");
+TAG_FLAG(transaction_conflict_history_size, runtime);
+
+DEFINE_int32(transaction_conflict_history_sampling_interval, 1,
+             "Only every n-th transaction conflict is stored in the conflict history.");
+TAG_FLAG(transaction_conflict_history_sampling_interval, runtime);
+
+namespace yb {
+namespace tablet {
+
+ConflictHistory::ConflictHistory(TabletMetrics* metrics) : metrics_(metrics) {}
+
+void ConflictHistory::ConflictDetected(const docdb::ConflictInfo& info) {
+  if (metrics_) {
+    switch (info.outcome) {
+      case docdb::ConflictOutcome::kCommitted:
+        metrics_->transaction_conflicts_committed->Increment();
+        break;
+      case docdb::ConflictOutcome::kHigherPriority:
+        metrics_->transaction_conflicts_higher_priority->Increment();
+        break;
+      case docdb::ConflictOutcome::kValueOverwrite:
+        metrics_->transaction_conflicts_value_overwrite->Increment();
+        break;
+      case docdb::ConflictOutcome::kAbortedOther:
+        metrics_->transaction_conflicts_aborted_others->Increment();
+        break;
+    }
+  }
+
+  const auto max_size = FLAGS_transaction_conflict_history_size;
+  if (max_size <= 0) {
+    return;
+  }
+  const auto sampling_interval = std::max(FLAGS_transaction_conflict_history_sampling_interval, 1);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (num_conflicts_++ % sampling_interval != 0) {
+    return;
+  }
+  ConflictHistoryEntry entry{info, GetCurrentTimeMicros()};
+  if (next_entry_ != 0 && entries_.size() != static_cast<size_t>(max_size)) {
+    // Size was changed at runtime after the buffer wrapped, so it should be linearized to keep
+    // entries ordered. When size was decreased, keep the newest entries.
+    auto ordered = EntriesUnlocked();
+    auto start = ordered.size() > static_cast<size_t>(max_size) ? ordered.end() - max_size
+                                                               : ordered.begin();
+    entries_.assign(std::make_move_iterator(start), std::make_move_iterator(ordered.end()));
+    next_entry_ = 0;
+  } else if (entries_.size() > static_cast<size_t>(max_size)) {
+    entries_.erase(entries_.begin(), entries_.end() - max_size);
+  }
+  if (entries_.size() < static_cast<size_t>(max_size)) {
+    entries_.push_back(std::move(entry));
+  } else {
+    entries_[next_entry_] = std::move(entry);
+    next_entry_ = (next_entry_ + 1) % entries_.size();
+  }
+}
+
+std::vector<ConflictHistoryEntry> ConflictHistory::Entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return EntriesUnlocked();
+}
+
+std::vector<ConflictHistoryEntry> ConflictHistory::EntriesUnlocked() const {
+  std::vector<ConflictHistoryEntry> result;
+  result.reserve(entries_.size());
+  result.insert(result.end(), entries_.begin() + next_entry_, entries_.end());
+  result.insert(result.end(), entries_.begin(), entries_.begin() + next_entry_);
+  return result;
+}
+
+Slice ConflictKeyPrefix(Slice key) {
+  auto size = docdb::DocKey::EncodedSize(key, docdb::DocKeyPart::WHOLE_DOC_KEY);
+  if (!size.ok()) {
+    return key;
+  }
+  return Slice(key.data(), *size);
+}
+
+} // namespace tablet
+} // namespace yb
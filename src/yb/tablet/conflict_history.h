@@ -0,0 +1,65 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_CONFLICT_HISTORY_H
+#define YB_TABLET_CONFLICT_HISTORY_H
+
+#include <mutex>
+#include <vector>
+
+#include "yb/docdb/conflict_resolution.h"
+
+namespace yb {
+namespace tablet {
+
+struct TabletMetrics;
+
+struct ConflictHistoryEntry {
+  docdb::ConflictInfo info;
+  // Wall clock time when conflict was detected, in microseconds since epoch.
+  int64_t time_us;
+};
+
+// Updates contention metrics of a tablet and keeps a sampled ring buffer of recent conflicts
+// detected on this tablet, used to find hot keys.
+class ConflictHistory : public docdb::ConflictObserver {
+ public:
+  // metrics could be null, in this case only conflict history is maintained.
+  explicit ConflictHistory(TabletMetrics* metrics);
+
+  void ConflictDetected(const docdb::ConflictInfo& info) override;
+
+  // Returns recorded conflicts, from oldest to newest.
+  std::vector<ConflictHistoryEntry> Entries() const;
+
+ private:
+  std::vector<ConflictHistoryEntry> EntriesUnlocked() const;
+
+  TabletMetrics* const metrics_;
+
+  mutable std::mutex mutex_;
+  // Number of conflicts reported, used for sampling.
+  size_t num_conflicts_ = 0;
+  std::vector<ConflictHistoryEntry> entries_;
+  // Position in entries_ where the next entry should be stored, when it is full.
+  size_t next_entry_ = 0;
+};
+
+// Returns prefix of the conflict key used to group conflicts, i.e. encoded DocKey of the row.
+// Keys that do not contain full DocKey are returned as is.
+Slice ConflictKeyPrefix(Slice key);
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_CONFLICT_HISTORY_H
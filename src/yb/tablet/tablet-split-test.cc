@@ -191,5 +191,91 @@ TEST_F(TabletSplitTest,  v) {
 // This test would be possible as an integration test when upper layers of tablet splitting are
 // implemented.
 
+TEST_F(TabletSplitTest, MiddleSplitKey) {
+  constexpr auto kNumRows = 5000;
+  constexpr auto kRowsPerFlush = kNumRows / 5;
+
+  const auto value_format = RandomHumanReadableString(256) + "_$0";
+  docdb::DocKeyHash min_hash_code = std::numeric_limits<docdb::DocKeyHash>::max();
+  docdb::DocKeyHash max_hash_code = std::numeric_limits<docdb::DocKeyHash>::min();
+  LocalTabletWriter::Batch batch;
+  for (auto i = 1; i <= kNumRows; ++i) {
+    const auto hash_code = InsertRow(i, Format(value_format, i), &batch);
+    min_hash_code = std::min(min_hash_code, hash_code);
+    max_hash_code = std::max(max_hash_code, hash_code);
+    if (i % kRowsPerFlush == 0) {
+      ASSERT_OK(writer_->WriteBatch(&batch));
+      batch.Clear();
+      ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+    }
+  }
+
+  std::string encoded_split_key, partition_split_key;
+  ASSERT_OK(tablet()->GetEncodedMiddleSplitKey(&encoded_split_key, &partition_split_key));
+
+  const auto split_hash_code = PartitionSchema::DecodeMultiColumnHashValue(partition_split_key);
+  LOG(INFO) << "Split hash code: " << split_hash_code;
+  ASSERT_GT(split_hash_code, min_hash_code);
+  ASSERT_LE(split_hash_code, max_hash_code);
+
+  docdb::KeyBytes expected_encoded_key;
+  docdb::DocKeyEncoderAfterCotableIdStep(&expected_encoded_key).Hash(
+      split_hash_code, std::vector<docdb::PrimitiveValue>());
+  ASSERT_EQ(expected_encoded_key.data(), encoded_split_key);
+}
+
+class TabletRangeSplitTest : public YBTabletTest {
+ public:
+  TabletRangeSplitTest() : YBTabletTest(Schema({ ColumnSchema("key", INT32, false, false),
+                                                 ColumnSchema("val", STRING) },
+                                               1)) {}
+
+  void SetUp() override {
+    FLAGS_db_write_buffer_size = 1_MB;
+    FLAGS_rocksdb_level0_file_num_compaction_trigger = -1;
+    YBTabletTest::SetUp();
+    writer_.reset(new LocalTabletWriter(tablet().get()));
+  }
+
+ protected:
+  void InsertRow(int key, const std::string& val, LocalTabletWriter::Batch* batch) {
+    QLWriteRequestPB* req = batch->Add();
+    req->set_type(QLWriteRequestPB::QL_STMT_INSERT);
+    QLAddInt32RangeValue(req, key);
+    QLAddStringColumnValue(req, kFirstColumnId + 1, val);
+  }
+
+  std::unique_ptr<LocalTabletWriter> writer_;
+};
+
+TEST_F(TabletRangeSplitTest, MiddleSplitKey) {
+  constexpr auto kNumRows = 5000;
+  constexpr auto kRowsPerFlush = kNumRows / 5;
+
+  const auto value_format = RandomHumanReadableString(256) + "_$0";
+  LocalTabletWriter::Batch batch;
+  for (auto i = 1; i <= kNumRows; ++i) {
+    InsertRow(i, Format(value_format, i), &batch);
+    if (i % kRowsPerFlush == 0) {
+      ASSERT_OK(writer_->WriteBatch(&batch));
+      batch.Clear();
+      ASSERT_OK(tablet()->Flush(FlushMode::kSync));
+    }
+  }
+
+  std::string encoded_split_key, partition_split_key;
+  ASSERT_OK(tablet()->GetEncodedMiddleSplitKey(&encoded_split_key, &partition_split_key));
+  ASSERT_EQ(encoded_split_key, partition_split_key);
+
+  // Split key should be a complete doc key of one of the rows, strictly inside the key range.
+  docdb::DocKey split_doc_key;
+  ASSERT_OK(split_doc_key.FullyDecodeFrom(encoded_split_key));
+  ASSERT_EQ(split_doc_key.range_group().size(), 1);
+  const auto split_value = split_doc_key.range_group()[0].GetInt32();
+  LOG(INFO) << "Split key: " << split_doc_key.ToString();
+  ASSERT_GT(split_value, 1);
+  ASSERT_LT(split_value, kNumRows);
+}
+
 } // namespace tablet
 } // namespace yb
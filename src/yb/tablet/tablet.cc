@@ -95,6 +95,7 @@
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/tablet/conflict_history.h"
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_retention_policy.h"
@@ -114,6 +115,7 @@
 #include "yb/util/locks.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
+#include "yb/util/protobuf_util.h"
 #include "yb/util/slice.h"
 #include "yb/util/stopwatch.h"
 #include "yb/util/trace.h"
@@ -151,6 +153,22 @@ DEFINE_int32(intents_flush_max_delay_ms, 2000,
              "Max time to wait for regular db to flush during flush of intents. "
              "After this time flush of regular db will be forced.");
 
+DEFINE_bool(enable_transaction_wait_queues, false,
+            "Whether write of distributed transaction that conflicts with pending transaction of "
+            "higher priority should wait for its completion instead of failing immediately.");
+TAG_FLAG(enable_transaction_wait_queues, runtime);
+
+DEFINE_int32(transaction_wait_queue_poll_interval_ms, 100,
+             "Max time to wait for completion of conflicting transaction before conflicts are "
+             "resolved again. Bounds the wait when transaction completes without being removed "
+             "from participant, e.g. when its intents were not cleaned yet.");
+TAG_FLAG(transaction_wait_queue_poll_interval_ms, advanced);
+
+DEFINE_uint64(txn_max_apply_batch_records, 100000,
+              "Max number of intents applied to regular DB in a single batch. Intents of bigger "
+              "transactions are applied in several batches in background.");
+TAG_FLAG(txn_max_apply_batch_records, advanced);
+
 DEFINE_test_flag(
     bool, tablet_verify_flushed_frontier_after_modifying, false,
     "After modifying the flushed frontier in RocksDB, verify that the restored value of it "
@@ -369,6 +387,8 @@ Tablet::Tablet(
     mem_tracker_->SetMetricEntity(metric_entity_);
   }
 
+  conflict_history_ = std::make_unique<ConflictHistory>(metrics_.get());
+
   if (transaction_participant_context && metadata->schema().table_properties().is_transactional()) {
     transaction_participant_ = std::make_unique<TransactionParticipant>(
         transaction_participant_context, this, metric_entity_);
@@ -514,10 +534,27 @@ Status Tablet::OpenKeyValueTablet() {
       make_shared<TabletRetentionPolicy>(this), &key_bounds_);
 
   rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
-    if (mem_table_flush_filter_factory_) {
-      return mem_table_flush_filter_factory_();
+    auto filter = mem_table_flush_filter_factory_ ? mem_table_flush_filter_factory_()
+                                                  : rocksdb::MemTableFilter();
+    auto min_apply_index = transaction_participant_
+        ? transaction_participant_->MinRunningApplyOpIndex()
+        : std::numeric_limits<int64_t>::max();
+    if (min_apply_index == std::numeric_limits<int64_t>::max()) {
+      return filter;
     }
-    return rocksdb::MemTableFilter();
+    // Records written after start of background apply should not be flushed until it completes.
+    // Otherwise apply operation would not be replayed during bootstrap, and partially applied
+    // transaction would be lost.
+    return rocksdb::MemTableFilter(
+        [filter, min_apply_index](const rocksdb::MemTable& memtable) -> Result<bool> {
+      auto frontiers = memtable.Frontiers();
+      if (frontiers &&
+          down_cast<const docdb::ConsensusFrontier&>(frontiers->Largest()).op_id().index >=
+              min_apply_index) {
+        return false;
+      }
+      return filter ? filter(memtable) : true;
+    });
   });
 
   rocksdb_options.disable_auto_compactions = true;
@@ -554,6 +591,8 @@ Status Tablet::OpenKeyValueTablet() {
     rocksdb_options.block_based_table_mem_tracker = MemTracker::FindOrCreateTracker(
       Format("$0-$1", kIntentsDB, tablet_id()), block_based_table_mem_tracker_);
 
+    docdb::InitRocksDBOptionsForIntentsDB(&rocksdb_options);
+
     rocksdb::DB* intents_db = nullptr;
     rocksdb_options.in_memory_erase = true;
     RETURN_NOT_OK(rocksdb::DB::Open(rocksdb_options, db_dir + kIntentsDBSuffix, &intents_db));
@@ -773,7 +812,9 @@ void Tablet::PrepareTransactionWriteBatch(
                             << ", don't write intents for it";
     }
   }
-  auto metadata_with_write_id = transaction_participant()->MetadataWithWriteId(transaction_id);
+  docdb::WrittenWeakIntentsPtr written_weak_intents;
+  auto metadata_with_write_id = transaction_participant()->MetadataWithWriteId(
+      transaction_id, &written_weak_intents);
   if (!metadata_with_write_id) {
     // If metadata is missing it could be caused by aborted and removed transaction.
     // In this case we should not add new intents for it.
@@ -784,10 +825,13 @@ void Tablet::PrepareTransactionWriteBatch(
 
   auto isolation_level = metadata_with_write_id->first.isolation;
   auto write_id = metadata_with_write_id->second;
+  if (!written_weak_intents) {
+    written_weak_intents = std::make_unique<docdb::WrittenWeakIntents>();
+  }
   yb::docdb::PrepareTransactionWriteBatch(
       put_batch, hybrid_time, rocksdb_write_batch, transaction_id, isolation_level,
-      UsePartialRangeKeyIntents(metadata_.get()), &write_id);
-  transaction_participant()->UpdateLastWriteId(transaction_id, write_id);
+      UsePartialRangeKeyIntents(metadata_.get()), &write_id, written_weak_intents.get());
+  transaction_participant()->UpdateLastWriteId(transaction_id, write_id, &written_weak_intents);
 }
 
 void Tablet::ApplyKeyValueRowOperations(const KeyValueWriteBatchPB& put_batch,
@@ -858,9 +902,12 @@ void SetupKeyValueBatch(WriteRequestPB* write_request, WriteRequestPB* batch_req
 
 //--------------------------------------------------------------------------------------------------
 // Redis Request Processing.
-Status Tablet::KeyValueBatchFromRedisWriteBatch(WriteOperation* operation) {
+void Tablet::KeyValueBatchFromRedisWriteBatch(std::unique_ptr<WriteOperation> operation) {
   ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
-  RETURN_NOT_OK(scoped_read_operation);
+  if (!scoped_read_operation.ok()) {
+    WriteOperation::StartSynchronization(std::move(operation), MoveStatus(scoped_read_operation));
+    return;
+  }
   docdb::DocOperations& doc_ops = operation->doc_ops();
   // Since we take exclusive locks, it's okay to use Now as the read TS for writes.
   WriteRequestPB batch_request;
@@ -871,17 +918,23 @@ Status Tablet::KeyValueBatchFromRedisWriteBatch(WriteOperation* operation) {
   for (size_t i = 0; i < redis_write_batch->size(); i++) {
     doc_ops.emplace_back(new RedisWriteOperation(redis_write_batch->Mutable(i)));
   }
-  RETURN_NOT_OK(StartDocWriteOperation(operation));
-  if (operation->restart_read_ht().is_valid()) {
-    return Status::OK();
-  }
-  auto* response = operation->response();
-  for (size_t i = 0; i < doc_ops.size(); i++) {
-    auto* redis_write_operation = down_cast<RedisWriteOperation*>(doc_ops[i].get());
-    response->add_redis_response_batch()->Swap(&redis_write_operation->response());
+  StartDocWriteOperation(std::move(operation), std::bind(
+      &Tablet::CompleteRedisWriteBatch, this, _1, _2));
+}
+
+void Tablet::CompleteRedisWriteBatch(
+    std::unique_ptr<WriteOperation> operation, const Status& status) {
+  if (status.ok() && !operation->restart_read_ht().is_valid()) {
+    auto& doc_ops = operation->doc_ops();
+    auto* response = operation->response();
+    for (size_t i = 0; i < doc_ops.size(); i++) {
+      auto* redis_write_operation = down_cast<RedisWriteOperation*>(doc_ops[i].get());
+      MoveToRepeatedField(&redis_write_operation->response(),
+                          response->mutable_redis_response_batch());
+    }
   }
 
-  return Status::OK();
+  WriteOperation::StartSynchronization(std::move(operation), status);
 }
 
 Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
@@ -1011,7 +1064,11 @@ void Tablet::KeyValueBatchFromQLWriteBatch(std::unique_ptr<WriteOperation> opera
     return;
   }
 
-  auto status = StartDocWriteOperation(operation.get());
+  StartDocWriteOperation(std::move(operation), std::bind(
+      &Tablet::QLWriteBatchStarted, this, _1, _2));
+}
+
+void Tablet::QLWriteBatchStarted(std::unique_ptr<WriteOperation> operation, const Status& status) {
   if (operation->restart_read_ht().is_valid()) {
     WriteOperation::StartSynchronization(std::move(operation), Status::OK());
     return;
@@ -1233,9 +1290,25 @@ CHECKED_STATUS Tablet::CreatePagingStateForRead(const PgsqlReadRequestPB& pgsql_
   return Status::OK();
 }
 
-Status Tablet::KeyValueBatchFromPgsqlWriteBatch(WriteOperation* operation) {
+void Tablet::KeyValueBatchFromPgsqlWriteBatch(std::unique_ptr<WriteOperation> operation) {
   ScopedPendingOperation scoped_read_operation(&pending_op_counter_);
-  RETURN_NOT_OK(scoped_read_operation);
+  if (!scoped_read_operation.ok()) {
+    WriteOperation::StartSynchronization(std::move(operation), MoveStatus(scoped_read_operation));
+    return;
+  }
+
+  auto status = PreparePgsqlWriteOperations(operation.get());
+  // Empty doc ops means that all operations have wrong schema version.
+  if (!status.ok() || operation->doc_ops().empty()) {
+    WriteOperation::StartSynchronization(std::move(operation), status);
+    return;
+  }
+
+  StartDocWriteOperation(std::move(operation), std::bind(
+      &Tablet::CompletePgsqlWriteBatch, this, _1, _2));
+}
+
+Status Tablet::PreparePgsqlWriteOperations(WriteOperation* operation) {
   docdb::DocOperations& doc_ops = operation->doc_ops();
   WriteRequestPB batch_request;
 
@@ -1260,24 +1333,23 @@ Status Tablet::KeyValueBatchFromPgsqlWriteBatch(WriteOperation* operation) {
     }
   }
 
-  // All operations have wrong schema version.
-  if (doc_ops.empty()) {
-    return Status::OK();
-  }
+  return Status::OK();
+}
 
-  RETURN_NOT_OK(StartDocWriteOperation(operation));
-  if (operation->restart_read_ht().is_valid()) {
-    return Status::OK();
-  }
-  for (size_t i = 0; i < doc_ops.size(); i++) {
-    PgsqlWriteOperation* pgsql_write_op = down_cast<PgsqlWriteOperation*>(doc_ops[i].get());
-    // We'll need to return the number of rows inserted, updated, or deleted by each operation.
-    doc_ops[i].release();
-    operation->state()->pgsql_write_ops()
-                      ->emplace_back(unique_ptr<PgsqlWriteOperation>(pgsql_write_op));
+void Tablet::CompletePgsqlWriteBatch(
+    std::unique_ptr<WriteOperation> operation, const Status& status) {
+  if (status.ok() && !operation->restart_read_ht().is_valid()) {
+    auto& doc_ops = operation->doc_ops();
+    for (size_t i = 0; i < doc_ops.size(); i++) {
+      PgsqlWriteOperation* pgsql_write_op = down_cast<PgsqlWriteOperation*>(doc_ops[i].get());
+      // We'll need to return the number of rows inserted, updated, or deleted by each operation.
+      doc_ops[i].release();
+      operation->state()->pgsql_write_ops()
+                        ->emplace_back(unique_ptr<PgsqlWriteOperation>(pgsql_write_op));
+    }
   }
 
-  return Status::OK();
+  WriteOperation::StartSynchronization(std::move(operation), status);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1292,8 +1364,7 @@ void Tablet::AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation>
   const WriteRequestPB* key_value_write_request = operation->state()->request();
 
   if (!key_value_write_request->redis_write_batch().empty()) {
-    auto status = KeyValueBatchFromRedisWriteBatch(operation.get());
-    WriteOperation::StartSynchronization(std::move(operation), status);
+    KeyValueBatchFromRedisWriteBatch(std::move(operation));
     return;
   }
 
@@ -1303,14 +1374,12 @@ void Tablet::AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation>
   }
 
   if (!key_value_write_request->pgsql_write_batch().empty()) {
-    auto status = KeyValueBatchFromPgsqlWriteBatch(operation.get());
-    WriteOperation::StartSynchronization(std::move(operation), status);
+    KeyValueBatchFromPgsqlWriteBatch(std::move(operation));
     return;
   }
 
   if (key_value_write_request->has_write_batch()) {
-    auto status = StartDocWriteOperation(operation.get());
-    WriteOperation::StartSynchronization(std::move(operation), status);
+    StartDocWriteOperation(std::move(operation), &WriteOperation::StartSynchronization);
     return;
   }
 
@@ -1367,7 +1436,31 @@ Status Tablet::WaitForFlush() {
 
 Status Tablet::ImportData(const std::string& source_dir) {
   // We import only regular records, so don't have to deal with intents here.
-  return regular_db_->Import(source_dir);
+  return regular_db_->Import(source_dir, [this](const Slice& smallest, const Slice& largest) {
+    RETURN_NOT_OK(CheckImportedKey(smallest));
+    return CheckImportedKey(largest);
+  });
+}
+
+Status Tablet::CheckImportedKey(const Slice& key) const {
+  if (!key_bounds_.IsWithinBounds(key)) {
+    return STATUS_FORMAT(InvalidArgument, "Imported key $0 is out of tablet bounds $1",
+                         key.ToDebugHexString(), key_bounds_);
+  }
+  const auto& partition = metadata_->partition();
+  std::string partition_key;
+  if (metadata_->partition_schema().IsHashPartitioning()) {
+    auto hash = VERIFY_RESULT(docdb::DocKey::DecodeHash(key));
+    partition_key = PartitionSchema::EncodeMultiColumnHashValue(hash);
+  } else {
+    partition_key = key.ToBuffer();
+  }
+  if (!partition.ContainsKey(partition_key)) {
+    return STATUS_FORMAT(InvalidArgument, "Imported key $0 does not belong to tablet partition $1",
+                         key.ToDebugHexString(),
+                         metadata_->partition_schema().PartitionDebugString(partition, *schema()));
+  }
+  return Status::OK();
 }
 
 template <class Data>
@@ -1376,22 +1469,30 @@ void InitFrontiers(const Data& data, docdb::ConsensusFrontiers* frontiers) {
   set_hybrid_time(data.log_ht, frontiers);
 }
 
-// We apply intents by iterating over whole transaction reverse index.
+// We apply intents by iterating over transaction reverse index.
 // Using value of reverse index record we find original intent record and apply it.
-// After that we delete both intent record and reverse index record.
-// TODO(dtxn) use multiple batches when applying really big transaction.
-Status Tablet::ApplyIntents(const TransactionApplyData& data) {
+// Big transactions are applied in several batches, starting from data.apply_state.
+// Intents are deleted later, after the whole transaction was applied.
+Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApplyData& data) {
+  // Continuation of apply is performed in background, so it should not race with shutdown.
+  boost::optional<ScopedPendingOperation> scoped_operation;
+  if (data.apply_state) {
+    scoped_operation.emplace(&pending_op_counter_);
+    RETURN_NOT_OK(*scoped_operation);
+  }
+
   rocksdb::WriteBatch regular_write_batch;
-  RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
-      data.transaction_id, data.commit_ht, &key_bounds_,
-      &regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */));
+  auto apply_state = VERIFY_RESULT(docdb::PrepareApplyIntentsBatch(
+      data.transaction_id, data.commit_ht, &key_bounds_, data.apply_state,
+      FLAGS_txn_max_apply_batch_records, &regular_write_batch, intents_db_.get(),
+      nullptr /* intents_write_batch */));
 
   // data.hybrid_time contains transaction commit time.
   // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
   docdb::ConsensusFrontiers frontiers;
   InitFrontiers(data, &frontiers);
   WriteBatch(&frontiers, &regular_write_batch, regular_db_.get());
-  return Status::OK();
+  return apply_state;
 }
 
 template <class Ids>
@@ -1399,8 +1500,9 @@ CHECKED_STATUS Tablet::RemoveIntentsImpl(const RemoveIntentsData& data, const Id
   rocksdb::WriteBatch intents_write_batch;
   for (const auto& id : ids) {
     RETURN_NOT_OK(docdb::PrepareApplyIntentsBatch(
-        id, HybridTime() /* commit_ht */, &key_bounds_, nullptr /* regular_write_batch */,
-        intents_db_.get(), &intents_write_batch));
+        id, HybridTime() /* commit_ht */, &key_bounds_, nullptr /* apply_state */,
+        0 /* max_records */, nullptr /* regular_write_batch */, intents_db_.get(),
+        &intents_write_batch));
   }
 
   docdb::ConsensusFrontiers frontiers;
@@ -1770,7 +1872,74 @@ Status Tablet::TEST_SwitchMemtable() {
   return Status::OK();
 }
 
-Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
+struct Tablet::ConflictWait {
+  CoarseTimePoint start;
+  // Conflicting transactions that were already reported to conflict history, so each of them is
+  // reported once per operation, instead of once per retry.
+  TransactionIdSet reported;
+};
+
+void Tablet::StartDocWriteOperation(
+    std::unique_ptr<WriteOperation> operation, DocWriteOperationCallback callback) {
+  ResumeDocWriteOperation(std::move(operation), nullptr, std::move(callback));
+}
+
+void Tablet::ResumeDocWriteOperation(
+    std::unique_ptr<WriteOperation> operation, std::shared_ptr<ConflictWait> wait,
+    DocWriteOperationCallback callback) {
+  std::vector<docdb::ConflictInfo> wait_for;
+  auto status = DoStartDocWriteOperation(operation.get(), &wait_for);
+  if (wait_for.empty()) {
+    if (wait) {
+      metrics_->transaction_conflict_wait_time->Increment(
+          ToMicroseconds(CoarseMonoClock::now() - wait->start));
+    }
+    callback(std::move(operation), status);
+    return;
+  }
+
+  // Participant resumes operation on behalf of this tablet, so it should not be shut down while
+  // operation waits.
+  auto scoped_operation = std::make_shared<ScopedPendingOperation>(&pending_op_counter_);
+  if (!scoped_operation->ok()) {
+    callback(std::move(operation), status);
+    return;
+  }
+
+  VLOG_WITH_PREFIX(2) << "Waiting for " << yb::ToString(wait_for) << ": " << status;
+  auto now = CoarseMonoClock::now();
+  if (!wait) {
+    wait = std::make_shared<ConflictWait>();
+    wait->start = now;
+    metrics_->transaction_conflict_waits->Increment();
+  }
+  std::vector<TransactionId> wait_for_ids;
+  wait_for_ids.reserve(wait_for.size());
+  for (const auto& conflict : wait_for) {
+    if (wait->reported.insert(conflict.conflicting_id).second) {
+      conflict_history_->ConflictDetected(conflict);
+    }
+    wait_for_ids.push_back(conflict.conflicting_id);
+  }
+  auto deadline = std::min<CoarseTimePoint>(
+      operation->deadline(), now + FLAGS_transaction_wait_queue_poll_interval_ms * 1ms);
+  transaction_participant_->WaitForAnyCompleted(
+      wait_for_ids, deadline,
+      [this, op = operation.release(), callback = std::move(callback), scoped_operation,
+       wait](const Status& status) {
+    std::unique_ptr<WriteOperation> operation(op);
+    if (!status.ok()) {
+      metrics_->transaction_conflict_wait_time->Increment(
+          ToMicroseconds(CoarseMonoClock::now() - wait->start));
+      callback(std::move(operation), status);
+      return;
+    }
+    ResumeDocWriteOperation(std::move(operation), wait, callback);
+  });
+}
+
+Status Tablet::DoStartDocWriteOperation(
+    WriteOperation* operation, std::vector<docdb::ConflictInfo>* wait_for) {
   auto write_batch = operation->request()->mutable_write_batch();
   auto isolation_level = VERIFY_RESULT(GetIsolationLevelFromPB(*write_batch));
 
@@ -1798,6 +1967,7 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
         clock_->Update(result);
       }
     } else {
+      const int num_read_pairs = write_batch->read_pairs_size();
       if (isolation_level == IsolationLevel::SERIALIZABLE_ISOLATION &&
           prepare_result.need_read_snapshot) {
         boost::container::small_vector<RefCntPrefix, 16> paths;
@@ -1817,10 +1987,26 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
         }
       }
 
-      RETURN_NOT_OK(docdb::ResolveTransactionConflicts(
+      auto status = docdb::ResolveTransactionConflicts(
           operation->doc_ops(), *write_batch, clock_->Now(),
           read_time ? read_time.read : HybridTime::kMax, doc_db(), partial_range_key_intents,
-          transaction_participant_.get(), metrics_->transaction_conflicts.get()));
+          transaction_participant_.get(), metrics_->transaction_conflicts.get(),
+          FLAGS_enable_transaction_wait_queues ? wait_for : nullptr, conflict_history_.get());
+      if (!status.ok() && !wait_for->empty()) {
+        if (CoarseMonoClock::now() < operation->deadline()) {
+          // Locks and request scope are released on return, so conflicting transactions could
+          // be applied or cleaned while caller waits for them. Read pairs are added again on
+          // retry.
+          write_batch->mutable_read_pairs()->DeleteSubrange(
+              num_read_pairs, write_batch->read_pairs_size() - num_read_pairs);
+          return status;
+        }
+        // Conflicts that could be waited for are not counted by conflict resolution, and the
+        // operation cannot wait anymore.
+        metrics_->transaction_conflicts->Increment();
+      }
+      wait_for->clear();
+      RETURN_NOT_OK(status);
 
       if (!read_time) {
         auto safe_time = SafeTime(RequireLease::kTrue);
@@ -2261,6 +2447,38 @@ Status Tablet::CreateSubtablet(
   return CreateCheckpoint(metadata->rocksdb_dir());
 }
 
+Status Tablet::GetEncodedMiddleSplitKey(
+    std::string* encoded_split_key, std::string* partition_split_key) const {
+  if (!regular_db_) {
+    return STATUS(IllegalState, "Tablet does not have RocksDB");
+  }
+  const auto middle_key = VERIFY_RESULT(regular_db_->GetMiddleKey());
+  if (metadata_->schema().num_hash_key_columns() > 0) {
+    // Rows with the same hash should stay in the same tablet, so split by hash only.
+    const auto hash = VERIFY_RESULT(docdb::DocKey::DecodeHash(middle_key));
+    docdb::KeyBytes encoded_key;
+    docdb::DocKeyEncoderAfterCotableIdStep(&encoded_key).Hash(
+        hash, std::vector<docdb::PrimitiveValue>());
+    *encoded_split_key = encoded_key.data();
+    *partition_split_key = PartitionSchema::EncodeMultiColumnHashValue(hash);
+  } else {
+    const auto doc_key_size = VERIFY_RESULT(
+        docdb::DocKey::EncodedSize(middle_key, docdb::DocKeyPart::WHOLE_DOC_KEY));
+    *encoded_split_key = middle_key.substr(0, doc_key_size);
+    *partition_split_key = *encoded_split_key;
+  }
+
+  // Both halves should be non empty.
+  const auto& partition = metadata_->partition();
+  if (!partition.ContainsKey(*partition_split_key) ||
+      *partition_split_key == partition.partition_key_start()) {
+    return STATUS_FORMAT(
+        IllegalState, "Middle key $0 of tablet $1 is at the tablet partition bound",
+        Slice(middle_key).ToDebugHexString(), tablet_id());
+  }
+  return Status::OK();
+}
+
 // ------------------------------------------------------------------------------------------------
 
 Result<ScopedReadOperation> ScopedReadOperation::Create(
@@ -96,6 +96,7 @@ class RowChangeList;
 
 namespace docdb {
 class ConsensusFrontier;
+struct ConflictInfo;
 }
 
 namespace log {
@@ -113,6 +114,7 @@ class MaintenanceOpStats;
 namespace tablet {
 
 class ChangeMetadataOperationState;
+class ConflictHistory;
 class ScopedReadOperation;
 struct TabletMetrics;
 struct TransactionApplyData;
@@ -212,9 +214,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   void Shutdown();
 
+  // Imports data of DocDB located in source_dir, bypassing Raft. Fails if any imported file
+  // contains keys that do not belong to this tablet. Importing empty DocDB does nothing.
   CHECKED_STATUS ImportData(const std::string& source_dir);
 
-  CHECKED_STATUS ApplyIntents(const TransactionApplyData& data) override;
+  Result<docdb::ApplyTransactionState> ApplyIntents(const TransactionApplyData& data) override;
 
   CHECKED_STATUS RemoveIntents(const RemoveIntentsData& data, const TransactionId& id) override;
 
@@ -275,7 +279,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // operations to same/conflicting part of the key/sub-key space. The locks acquired are returned
   // via the 'keys_locked' vector, so that they may be unlocked later when the operation has been
   // committed.
-  CHECKED_STATUS KeyValueBatchFromRedisWriteBatch(WriteOperation* operation);
+  void KeyValueBatchFromRedisWriteBatch(std::unique_ptr<WriteOperation> operation);
 
   CHECKED_STATUS HandleRedisReadRequest(
       CoarseTimePoint deadline,
@@ -312,7 +316,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       const PgsqlReadRequestPB& pgsql_read_request, const size_t row_count,
       PgsqlResponsePB* response) const override;
 
-  CHECKED_STATUS KeyValueBatchFromPgsqlWriteBatch(WriteOperation* operation);
+  void KeyValueBatchFromPgsqlWriteBatch(std::unique_ptr<WriteOperation> operation);
 
   //------------------------------------------------------------------------------------------------
   // Create a RocksDB checkpoint in the provided directory. Only used when table_type_ ==
@@ -390,6 +394,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // May be NULL in unit tests, etc.
   TabletMetrics* metrics() { return metrics_.get(); }
 
+  // Return recent transaction conflicts detected on this tablet.
+  const ConflictHistory& conflict_history() const { return *conflict_history_; }
+
   // Return handle to the metric entity of this tablet.
   const scoped_refptr<MetricEntity>& GetMetricEntity() const { return metric_entity_; }
 
@@ -542,13 +549,39 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       const TabletId& tablet_id, const Partition& partition,
       const docdb::KeyBounds& key_bounds);
 
+  // Picks a key that splits data of this tablet into two parts of roughly equal size, using the
+  // index of the largest SST file. Fills encoded DocKey to be used as the key bound of sub tablets
+  // and the corresponding partition key.
+  CHECKED_STATUS GetEncodedMiddleSplitKey(
+      std::string* encoded_split_key, std::string* partition_split_key) const;
+
  protected:
   friend class Iterator;
   friend class TabletPeerTest;
   friend class ScopedReadOperation;
   FRIEND_TEST(TestTablet, TestGetLogRetentionSizeForIndex);
 
-  CHECKED_STATUS StartDocWriteOperation(WriteOperation* operation);
+  // Invoked when write operation is prepared, possibly asynchronously after it waited for
+  // conflicting transactions.
+  typedef std::function<void(std::unique_ptr<WriteOperation>, const Status&)>
+      DocWriteOperationCallback;
+
+  void StartDocWriteOperation(
+      std::unique_ptr<WriteOperation> operation, DocWriteOperationCallback callback);
+
+  // State of write operation that waits for conflicting transactions.
+  struct ConflictWait;
+
+  // Starts operation again after it waited for conflicting transactions, wait is null on the
+  // first attempt.
+  void ResumeDocWriteOperation(
+      std::unique_ptr<WriteOperation> operation, std::shared_ptr<ConflictWait> wait,
+      DocWriteOperationCallback callback);
+
+  // When operation should wait for conflicting transactions, conflicts with them are stored to
+  // wait_for and locks are released before return.
+  CHECKED_STATUS DoStartDocWriteOperation(
+      WriteOperation* operation, std::vector<docdb::ConflictInfo>* wait_for);
 
   CHECKED_STATUS OpenKeyValueTablet();
   virtual CHECKED_STATUS CreateTabletDirectories(const string& db_dir, FsManager* fs);
@@ -621,6 +654,7 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   MetricEntityPtr metric_entity_;
   gscoped_ptr<TabletMetrics> metrics_;
+  std::unique_ptr<ConflictHistory> conflict_history_;
   FunctionGaugeDetacher metric_detacher_;
 
   // A pointer to the server's clock.
@@ -711,14 +745,23 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   HybridTime DoGetSafeTime(
       RequireLease require_lease, HybridTime min_allowed, CoarseTimePoint deadline) const override;
 
+  void CompleteRedisWriteBatch(std::unique_ptr<WriteOperation> operation, const Status& status);
+
+  void QLWriteBatchStarted(std::unique_ptr<WriteOperation> operation, const Status& status);
   void UpdateQLIndexes(std::unique_ptr<WriteOperation> operation);
   void CompleteQLWriteBatch(std::unique_ptr<WriteOperation> operation, const Status& status);
 
+  CHECKED_STATUS PreparePgsqlWriteOperations(WriteOperation* operation);
+  void CompletePgsqlWriteBatch(std::unique_ptr<WriteOperation> operation, const Status& status);
+
   Result<bool> IntentsDbFlushFilter(const rocksdb::MemTable& memtable);
 
   template <class Ids>
   CHECKED_STATUS RemoveIntentsImpl(const RemoveIntentsData& data, const Ids& ids);
 
+  // Checks that imported key belongs to this tablet.
+  CHECKED_STATUS CheckImportedKey(const Slice& key) const;
+
   std::function<rocksdb::MemTableFilter()> mem_table_flush_filter_factory_;
 
   client::LocalTabletFilter local_tablet_filter_;
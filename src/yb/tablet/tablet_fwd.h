@@ -41,6 +41,7 @@ typedef std::shared_ptr<TabletPeer> TabletPeerPtr;
 
 class TabletStatusPB;
 class TabletStatusListener;
+class TransactionStatusResolver;
 class WriteOperationState;
 
 using TabletClass = enterprise::Tablet;
@@ -119,6 +119,12 @@ METRIC_DEFINE_counter(tablet, transaction_conflicts,
   yb::MetricUnit::kRequests,
   "Number of conflicts detected among uncommitted distributed transactions.");
 
+METRIC_DEFINE_counter(tablet, transaction_conflict_waits,
+  "Distributed Transaction Conflict Waits",
+  yb::MetricUnit::kRequests,
+  "Number of times a distributed transaction write waited for completion of a conflicting "
+  "transaction with higher priority.");
+
 METRIC_DEFINE_counter(tablet, expired_transactions,
   "Expired Distributed Transactions",
   yb::MetricUnit::kRequests,
@@ -129,6 +135,34 @@ METRIC_DEFINE_counter(tablet, restart_read_requests,
   yb::MetricUnit::kRequests,
   "Number of read requests that require restart.");
 
+METRIC_DEFINE_counter(tablet, transaction_conflicts_committed,
+  "Transaction Conflicts With Committed Transactions",
+  yb::MetricUnit::kRequests,
+  "Number of transaction writes that failed because of conflict with transaction committed after "
+  "their read time.");
+
+METRIC_DEFINE_counter(tablet, transaction_conflicts_higher_priority,
+  "Transaction Conflicts With Higher Priority Transactions",
+  yb::MetricUnit::kRequests,
+  "Number of transaction writes that failed or waited because of conflict with pending "
+  "transaction with higher priority.");
+
+METRIC_DEFINE_counter(tablet, transaction_conflicts_value_overwrite,
+  "Transaction Conflicts With Values Written After Read Time",
+  yb::MetricUnit::kRequests,
+  "Number of transaction writes that failed because value was written after their read time.");
+
+METRIC_DEFINE_counter(tablet, transaction_conflicts_aborted_others,
+  "Transactions Aborted By Conflict Resolution",
+  yb::MetricUnit::kRequests,
+  "Number of conflicting transactions with lower priority aborted during conflict resolution.");
+
+METRIC_DEFINE_histogram(tablet, transaction_conflict_wait_time,
+  "Transaction Conflict Wait Time",
+  yb::MetricUnit::kMicroseconds,
+  "Time spent by transaction writes waiting for completion of conflicting transactions.",
+  60000000LU, 2);
+
 using strings::Substitute;
 
 namespace yb {
@@ -144,8 +178,14 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(not_leader_rejections),
     MINIT(leader_memory_pressure_rejections),
     MINIT(transaction_conflicts),
+    MINIT(transaction_conflict_waits),
     MINIT(expired_transactions),
-    MINIT(restart_read_requests) {
+    MINIT(restart_read_requests),
+    MINIT(transaction_conflicts_committed),
+    MINIT(transaction_conflicts_higher_priority),
+    MINIT(transaction_conflicts_value_overwrite),
+    MINIT(transaction_conflicts_aborted_others),
+    MINIT(transaction_conflict_wait_time) {
 }
 #undef MINIT
 
@@ -63,8 +63,16 @@ struct TabletMetrics {
   scoped_refptr<Counter> not_leader_rejections;
   scoped_refptr<Counter> leader_memory_pressure_rejections;
   scoped_refptr<Counter> transaction_conflicts;
+  scoped_refptr<Counter> transaction_conflict_waits;
   scoped_refptr<Counter> expired_transactions;
   scoped_refptr<Counter> restart_read_requests;
+
+  // Contention metrics, by outcome of the detected conflict.
+  scoped_refptr<Counter> transaction_conflicts_committed;
+  scoped_refptr<Counter> transaction_conflicts_higher_priority;
+  scoped_refptr<Counter> transaction_conflicts_value_overwrite;
+  scoped_refptr<Counter> transaction_conflicts_aborted_others;
+  scoped_refptr<Histogram> transaction_conflict_wait_time;
 };
 
 class ScopedTabletMetricsTracker {
@@ -285,6 +285,15 @@ class TabletPeer : public consensus::ReplicaOperationFactory,
     return client_future_;
   }
 
+  TransactionStatusResolver* status_resolver() const override {
+    return status_resolver_;
+  }
+
+  // Should be invoked before tablet is started.
+  void SetTransactionStatusResolver(TransactionStatusResolver* status_resolver) {
+    status_resolver_ = status_resolver;
+  }
+
   int64_t LeaderTerm() const override;
   consensus::LeaderStatus LeaderStatus() const;
 
@@ -427,6 +436,8 @@ class TabletPeer : public consensus::ReplicaOperationFactory,
 
   std::shared_future<client::YBClient*> client_future_;
 
+  TransactionStatusResolver* status_resolver_ = nullptr;
+
   DISALLOW_COPY_AND_ASSIGN(TabletPeer);
 };
 
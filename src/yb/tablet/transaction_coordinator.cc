@@ -32,6 +32,7 @@
 
 #include "yb/common/entity_ids.h"
 #include "yb/common/transaction.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/consensus/opid_util.h"
 
@@ -48,6 +49,7 @@
 #include "yb/tserver/tserver_service.pb.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/kernel_stack_watchdog.h"
 #include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
@@ -64,6 +66,9 @@ DEFINE_double(transaction_max_missed_heartbeat_periods, 10.0 * yb::kTimeMultipli
 DEFINE_uint64(transaction_check_interval_usec, 500000, "Transaction check interval in usec.");
 DEFINE_uint64(transaction_resend_applying_interval_usec, 5000000,
               "Transaction resend applying interval in usec.");
+DEFINE_test_flag(bool, transaction_omit_unknown_status_time_in_tests, false,
+                 "Do not set status time when reporting unknown transaction as aborted, like "
+                 "coordinators of older versions do.");
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -128,7 +133,8 @@ class TransactionState {
       : context_(*context),
         id_(id),
         log_prefix_(BuildLogPrefix(parent_log_prefix, id)),
-        last_touch_(last_touch) {
+        last_touch_(last_touch),
+        replicated_touch_(last_touch) {
   }
 
   ~TransactionState() {
@@ -249,13 +255,14 @@ class TransactionState {
   CHECKED_STATUS GetStatus(tserver::GetTransactionStatusResponsePB* response) const {
     if (status_ == TransactionStatus::COMMITTED ||
         status_ == TransactionStatus::APPLIED_IN_ALL_INVOLVED_TABLETS) {
-      response->set_status(TransactionStatus::COMMITTED);
-      response->set_status_hybrid_time(commit_time_.ToUint64());
+      response->add_status(TransactionStatus::COMMITTED);
+      response->add_status_hybrid_time(commit_time_.ToUint64());
     } else if (status_ == TransactionStatus::ABORTED) {
-      response->set_status(TransactionStatus::ABORTED);
+      response->add_status(TransactionStatus::ABORTED);
+      response->add_status_hybrid_time(HybridTime::kMax.ToUint64());
     } else {
       CHECK_EQ(TransactionStatus::PENDING, status_);
-      response->set_status(TransactionStatus::PENDING);
+      response->add_status(TransactionStatus::PENDING);
       HybridTime status_ht = context_.coordinator_context().clock().Now();
       if (replicating_) {
         auto replicating_status = replicating_->request()->status();
@@ -268,7 +275,7 @@ class TransactionState {
         }
       }
       status_ht = std::min(status_ht, context_.coordinator_context().HtLeaseExpiration());
-      response->set_status_hybrid_time(status_ht.Decremented().ToUint64());
+      response->add_status_hybrid_time(status_ht.Decremented().ToUint64());
     }
     return Status::OK();
   }
@@ -302,6 +309,40 @@ class TransactionState {
     DoHandle(std::move(request));
   }
 
+  // Handles heartbeat that is not submitted to Raft by itself.
+  CHECKED_STATUS Touch(HybridTime now) {
+    if (ShouldBeAborted()) {
+      return STATUS(Aborted, "Transaction aborted");
+    }
+    if (status_ != TransactionStatus::PENDING) {
+      return STATUS_FORMAT(IllegalState, "Transaction in wrong state during heartbeat: $0",
+                           TransactionStatus_Name(status_));
+    }
+    if (ExpiredAt(now)) {
+      Abort();
+      return STATUS(Expired, "Transaction expired");
+    }
+    last_touch_ = now;
+    // Heartbeat is replicated from time to time, so followers do not keep too old last touch.
+    // New leader does not rely on it, see ResetLastTouch.
+    const auto since_replicated = std::chrono::microseconds(
+        now.GetPhysicalValueMicros() - replicated_touch_.GetPhysicalValueMicros());
+    if (!replicating_ && request_queue_.empty() &&
+        since_replicated > GetTransactionTimeout() / 2) {
+      SubmitUpdateStatus(TransactionStatus::PENDING);
+    }
+    return Status::OK();
+  }
+
+  // Heartbeats that were handled by previous leader are not replicated, so last touch could be
+  // up to half of the transaction timeout behind. New leader gives running transactions full
+  // timeout to send heartbeat to it.
+  void ResetLastTouch(HybridTime now) {
+    if (status_ == TransactionStatus::PENDING) {
+      last_touch_ = std::max(last_touch_, now);
+    }
+  }
+
   // Aborts this transaction.
   void Abort() {
     if (ShouldBeCommitted()) {
@@ -542,7 +583,9 @@ class TransactionState {
                               << TransactionStatus_Name(status_);
       return Status::OK();
     }
-    last_touch_ = data.hybrid_time;
+    // Heartbeats that were not replicated could touch transaction after this operation.
+    last_touch_ = std::max(last_touch_, data.hybrid_time);
+    replicated_touch_ = data.hybrid_time;
     first_entry_raft_index_ = data.op_id.index();
     return Status::OK();
   }
@@ -575,6 +618,8 @@ class TransactionState {
   const std::string log_prefix_;
   TransactionStatus status_ = TransactionStatus::PENDING;
   HybridTime last_touch_;
+  // Time of the last replicated touch, i.e. last_touch_ known to followers.
+  HybridTime replicated_touch_;
   // It should match last_touch_, but it is possible that because of some code errors it
   // would not be so. To add stability we introduce a separate field for it.
   HybridTime commit_time_;
@@ -656,20 +701,58 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
     rpcs_.Shutdown();
   }
 
-  CHECKED_STATUS GetStatus(const std::string& transaction_id,
+  CHECKED_STATUS GetStatus(const google::protobuf::RepeatedPtrField<std::string>& transaction_ids,
                            tserver::GetTransactionStatusResponsePB* response) {
-    auto id = FullyDecodeTransactionId(transaction_id);
-    if (!id.ok()) {
-      return std::move(id.status());
+    std::lock_guard<std::mutex> lock(managed_mutex_);
+    for (const auto& transaction_id : transaction_ids) {
+      auto id = VERIFY_RESULT(FullyDecodeTransactionId(transaction_id));
+
+      auto it = managed_transactions_.find(id);
+      if (it == managed_transactions_.end()) {
+        response->add_status(TransactionStatus::ABORTED);
+        if (!FLAGS_transaction_omit_unknown_status_time_in_tests) {
+          response->add_status_hybrid_time(HybridTime::kMax.ToUint64());
+        }
+        continue;
+      }
+      RETURN_NOT_OK(it->GetStatus(response));
     }
+    return Status::OK();
+  }
 
-    std::lock_guard<std::mutex> lock(managed_mutex_);
-    auto it = managed_transactions_.find(*id);
-    if (it == managed_transactions_.end()) {
-      response->set_status(TransactionStatus::ABORTED);
-      return Status::OK();
+  CHECKED_STATUS Heartbeat(
+      const google::protobuf::RepeatedPtrField<std::string>& transaction_ids, int64_t term,
+      tserver::HeartbeatTransactionsResponsePB* response) {
+    std::vector<TransactionId> ids;
+    ids.reserve(transaction_ids.size());
+    for (const auto& transaction_id : transaction_ids) {
+      ids.push_back(VERIFY_RESULT(FullyDecodeTransactionId(transaction_id)));
     }
-    return it->GetStatus(response);
+
+    auto now = context_.clock().Now();
+    PostponedLeaderActions actions;
+    {
+      std::lock_guard<std::mutex> lock(managed_mutex_);
+      postponed_leader_actions_.leader_term = term;
+      CheckLeaderChangedUnlocked(term, now);
+      for (const auto& id : ids) {
+        Status status;
+        auto it = managed_transactions_.find(id);
+        if (it == managed_transactions_.end()) {
+          status = STATUS(Expired, "Transaction expired");
+        } else {
+          // Touch changes last touch, so index should be updated.
+          managed_transactions_.modify(it, [now, &status](TransactionState& state) {
+            status = state.Touch(now);
+          });
+        }
+        StatusToPB(status, response->add_status());
+      }
+      actions.Swap(&postponed_leader_actions_);
+    }
+    ExecutePostponedLeaderActions(&actions);
+
+    return Status::OK();
   }
 
   void Abort(const std::string& transaction_id, int64_t term, TransactionAbortCallback callback) {
@@ -717,6 +800,7 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
     {
       std::lock_guard<std::mutex> lock(managed_mutex_);
       postponed_leader_actions_.leader_term = data.leader_term;
+      CheckLeaderChangedUnlocked(data.leader_term, context_.clock().Now());
       auto it = GetTransaction(*id, data.state.status(), data.hybrid_time);
       if (it == managed_transactions_.end()) {
         return Status::OK();
@@ -781,6 +865,7 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
     {
       std::unique_lock<std::mutex> lock(managed_mutex_);
       postponed_leader_actions_.leader_term = term;
+      CheckLeaderChangedUnlocked(term, context_.clock().Now());
       auto it = managed_transactions_.find(*id);
       if (it == managed_transactions_.end()) {
         if (state.status() == TransactionStatus::CREATED) {
@@ -968,6 +1053,7 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
         return;
       }
       postponed_leader_actions_.leader_term = leader_term;
+      CheckLeaderChangedUnlocked(leader_term, now);
 
       auto& index = managed_transactions_.get<LastTouchTag>();
 
@@ -995,6 +1081,22 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
     ExecutePostponedLeaderActions(&actions);
   }
 
+  // Resets last touch of all transactions when this peer becomes leader in a new term.
+  void CheckLeaderChangedUnlocked(int64_t term, HybridTime now) {
+    if (term == OpId::kUnknownTerm || term == last_leader_term_) {
+      return;
+    }
+    LOG_WITH_PREFIX(INFO) << "Became leader in term " << term << ", resetting last touch of "
+                          << managed_transactions_.size() << " transactions";
+    last_leader_term_ = term;
+    for (auto it = managed_transactions_.begin(); it != managed_transactions_.end(); ++it) {
+      // Last touch is indexed, so it should be modified via container.
+      managed_transactions_.modify(it, [now](TransactionState& state) {
+        state.ResetLastTouch(now);
+      });
+    }
+  }
+
   void CheckCompleted(ManagedTransactions::iterator it) {
     if (it->Completed()) {
       auto status = STATUS_FORMAT(Aborted, "Transaction completed: $0", *it);
@@ -1014,6 +1116,9 @@ class TransactionCoordinator::Impl : public TransactionStateContext {
   // Actions that should be executed after mutex is unlocked.
   PostponedLeaderActions postponed_leader_actions_;
 
+  // Last term when this peer was leader, protected by managed_mutex_.
+  int64_t last_leader_term_ = OpId::kUnknownTerm;
+
   bool closing_ = false;
   rpc::ScheduledTaskId poll_task_id_ = rpc::kUninitializedScheduledTaskId;
   std::atomic<int64_t> running_polls_{0};
@@ -1060,9 +1165,16 @@ void TransactionCoordinator::Shutdown() {
   impl_->Shutdown();
 }
 
-Status TransactionCoordinator::GetStatus(const std::string& transaction_id,
-                                         tserver::GetTransactionStatusResponsePB* response) {
-  return impl_->GetStatus(transaction_id, response);
+Status TransactionCoordinator::GetStatus(
+    const google::protobuf::RepeatedPtrField<std::string>& transaction_ids,
+    tserver::GetTransactionStatusResponsePB* response) {
+  return impl_->GetStatus(transaction_ids, response);
+}
+
+Status TransactionCoordinator::Heartbeat(
+    const google::protobuf::RepeatedPtrField<std::string>& transaction_ids, int64_t term,
+    tserver::HeartbeatTransactionsResponsePB* response) {
+  return impl_->Heartbeat(transaction_ids, term, response);
 }
 
 void TransactionCoordinator::Abort(const std::string& transaction_id,
@@ -19,6 +19,8 @@
 #include <future>
 #include <memory>
 
+#include <google/protobuf/repeated_field.h>
+
 #include "yb/client/client_fwd.h"
 
 #include "yb/common/hybrid_time.h"
@@ -48,6 +50,7 @@ namespace tserver {
 
 class AbortTransactionResponsePB;
 class GetTransactionStatusResponsePB;
+class HeartbeatTransactionsResponsePB;
 class TransactionStatePB;
 
 }
@@ -130,11 +133,19 @@ class TransactionCoordinator {
   // And like most of other Shutdowns in our codebase it wait until shutdown completes.
   void Shutdown();
 
-  CHECKED_STATUS GetStatus(const std::string& transaction_id,
+  // Fills response with statuses of specified transactions, in the same order.
+  CHECKED_STATUS GetStatus(const google::protobuf::RepeatedPtrField<std::string>& transaction_ids,
                            tserver::GetTransactionStatusResponsePB* response);
 
   void Abort(const std::string& transaction_id, int64_t term, TransactionAbortCallback callback);
 
+  // Extends lifetime of specified running transactions, filling result for each of them in
+  // response, in the same order.
+  // Such heartbeat is replicated only when transaction was not touched via Raft for a while.
+  CHECKED_STATUS Heartbeat(
+      const google::protobuf::RepeatedPtrField<std::string>& transaction_ids, int64_t term,
+      tserver::HeartbeatTransactionsResponsePB* response);
+
   // Returns count of managed transactions. Used in tests.
   size_t test_count_transactions() const;
 
@@ -15,6 +15,7 @@
 
 #include "yb/tablet/transaction_participant.h"
 
+#include <limits>
 #include <mutex>
 #include <queue>
 
@@ -29,19 +30,23 @@
 
 #include "yb/rocksdb/write_batch.h"
 
+#include "yb/client/client.h"
 #include "yb/client/transaction_rpc.h"
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb.h"
 
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc.h"
 #include "yb/rpc/thread_pool.h"
 
 #include "yb/tablet/operations/update_txn_operation.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/transaction_status_resolver.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
 #include "yb/util/random_util.h"
@@ -56,6 +61,12 @@ DEFINE_uint64(transaction_delay_status_reply_usec_in_tests, 0,
               "For tests only. Delay handling status reply by specified amount of usec.");
 DEFINE_double(transaction_ignore_applying_probability_in_tests, 0,
               "Probability to ignore APPLYING update in tests.");
+DEFINE_int32(txn_apply_retry_initial_delay_ms, 100,
+             "Initial delay before retry of failed background apply of transaction intents.");
+TAG_FLAG(txn_apply_retry_initial_delay_ms, advanced);
+DEFINE_int32(txn_apply_retry_max_delay_ms, 5000,
+             "Max delay between retries of failed background apply of transaction intents.");
+TAG_FLAG(txn_apply_retry_max_delay_ms, advanced);
 
 METRIC_DEFINE_simple_counter(
     tablet, transaction_load_attempts,
@@ -166,15 +177,69 @@ class RunningTransactionContext {
     return delayer_;
   }
 
+  // Requests status of transaction using status resolver, transaction is kept alive until
+  // status is received.
+  void ResolveStatus(const RunningTransactionPtr& transaction, int64_t serial_no);
+
  protected:
   friend class RunningTransaction;
 
+  // Tracks status resolver callbacks, so they are not invoked after context is destroyed.
+  class ResolverCallbacks {
+   public:
+    explicit ResolverCallbacks(RunningTransactionContext* context) : context_(context) {}
+
+    template <class F>
+    void Invoke(const F& f) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!context_) {
+          return;
+        }
+        ++running_;
+      }
+      f(context_);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--running_ == 0) {
+        cond_.notify_all();
+      }
+    }
+
+    // Waits for running callbacks, callbacks invoked after this call are ignored.
+    void Shutdown() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      context_ = nullptr;
+      cond_.wait(lock, [this] { return running_ == 0; });
+    }
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    RunningTransactionContext* context_;
+    size_t running_ = 0;
+  };
+
+  void StatusResolved(
+      const TransactionId& id, int64_t serial_no, const Result<TransactionStatusResult>& result);
+
+  // Stops receiving statuses from resolver and fails status requests of resolving transactions.
+  void ShutdownStatusResolution();
+
   rpc::Rpcs rpcs_;
   TransactionParticipantContext& participant_context_;
   TransactionIntentApplier& applier_;
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
+  // Resolver that is used to request transaction statuses, could point to own_status_resolver_.
+  TransactionStatusResolver* status_resolver_ = nullptr;
+  std::unique_ptr<TransactionStatusResolver> own_status_resolver_;
+  std::shared_ptr<ResolverCallbacks> resolver_callbacks_ =
+      std::make_shared<ResolverCallbacks>(this);
+  // Transactions waiting for status from resolver.
+  std::unordered_map<TransactionId, RunningTransactionPtr, TransactionIdHash>
+      resolving_transactions_;
+
   // Used only in tests.
   Delayer delayer_;
 };
@@ -395,6 +460,69 @@ class CleanupIntentsTask : public rpc::ThreadPoolTask {
   std::shared_ptr<CleanupIntentsTask> retain_self_;
 };
 
+// Resumes write operation blocked by conflicting transactions, when any of them completes or
+// wait deadline passes, whichever happens first.
+class CompletionWaiter : public rpc::ThreadPoolTask,
+                         public std::enable_shared_from_this<CompletionWaiter> {
+ public:
+  CompletionWaiter(
+      TransactionParticipantContext* participant_context, std::vector<TransactionId> ids,
+      std::function<void(CompletionWaiter*)> unregister, StatusFunctor callback)
+      : participant_context_(*participant_context), ids_(std::move(ids)),
+        unregister_(std::move(unregister)), callback_(std::move(callback)) {}
+
+  const std::vector<TransactionId>& ids() const {
+    return ids_;
+  }
+
+  void SetTimer(rpc::Scheduler* scheduler, rpc::ScheduledTaskId timer_task_id) {
+    scheduler_ = scheduler;
+    timer_task_id_.store(timer_task_id, std::memory_order_release);
+  }
+
+  // Enqueues this waiter to thread pool. Only first invocation has effect.
+  void Trigger() {
+    if (triggered_.exchange(true, std::memory_order_acq_rel)) {
+      return;
+    }
+    retain_self_ = shared_from_this();
+    participant_context_.Enqueue(this);
+  }
+
+  void Run() override {
+    auto timer_task_id = timer_task_id_.load(std::memory_order_acquire);
+    if (timer_task_id != rpc::kUninitializedScheduledTaskId) {
+      scheduler_->Abort(timer_task_id);
+    }
+    unregister_(this);
+    auto callback = std::move(callback_);
+    callback_ = StatusFunctor();
+    callback(Status::OK());
+  }
+
+  void Done(const Status& status) override {
+    // Thread pool rejected this task, so resume operation with error.
+    // We could be invoked under participant mutex, so it is not unregistered here. Stale entries
+    // are dropped when the transaction they wait for is removed.
+    if (!status.ok() && callback_) {
+      callback_(status);
+    }
+    retain_self_.reset();
+  }
+
+  virtual ~CompletionWaiter() {}
+
+ private:
+  TransactionParticipantContext& participant_context_;
+  const std::vector<TransactionId> ids_;
+  std::function<void(CompletionWaiter*)> unregister_;
+  StatusFunctor callback_;
+  std::atomic<bool> triggered_{false};
+  rpc::Scheduler* scheduler_ = nullptr;
+  std::atomic<rpc::ScheduledTaskId> timer_task_id_{rpc::kUninitializedScheduledTaskId};
+  std::shared_ptr<CompletionWaiter> retain_self_;
+};
+
 class RunningTransaction : public std::enable_shared_from_this<RunningTransaction> {
  public:
   RunningTransaction(TransactionMetadata metadata,
@@ -405,12 +533,11 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
         context_(*context),
         remove_intents_task_(&context->applier_, &context->participant_context_,
                              metadata_.transaction_id),
-        get_status_handle_(context->rpcs_.InvalidHandle()),
         abort_handle_(context->rpcs_.InvalidHandle()) {
   }
 
   ~RunningTransaction() {
-    context_.rpcs_.Abort({&get_status_handle_, &abort_handle_});
+    context_.rpcs_.Abort({&abort_handle_});
   }
 
   const TransactionId& id() const {
@@ -429,6 +556,10 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
     last_write_id_ = value;
   }
 
+  docdb::WrittenWeakIntentsPtr& written_weak_intents() {
+    return written_weak_intents_;
+  }
+
   HybridTime local_commit_time() const {
     return local_commit_time_;
   }
@@ -437,8 +568,7 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
     local_commit_time_ = time;
   }
 
-  void RequestStatusAt(client::YBClient* client,
-                       const StatusRequest& request,
+  void RequestStatusAt(const StatusRequest& request,
                        std::unique_lock<std::mutex>* lock) {
     DCHECK_LT(request.global_limit_ht, HybridTime::kMax);
     DCHECK_LE(request.read_ht, request.global_limit_ht);
@@ -468,7 +598,7 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
         last_known_status_, last_known_status_hybrid_time_, request, request_id);
 
     lock->unlock();
-    SendStatusRequest(client, request_id, shared_self);
+    SendStatusRequest(request_id, shared_self);
   }
 
   void Abort(client::YBClient* client,
@@ -506,6 +636,8 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
   }
 
  private:
+  friend class RunningTransactionContext;
+
   static boost::optional<TransactionStatus> GetStatusAt(
       HybridTime time,
       HybridTime last_known_status_hybrid_time,
@@ -527,74 +659,47 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
     }
   }
 
-  void SendStatusRequest(
-      client::YBClient* client, int64_t serial_no, const RunningTransactionPtr& shared_self) {
-    tserver::GetTransactionStatusRequestPB req;
-    req.set_tablet_id(metadata_.status_tablet);
-    req.set_transaction_id(metadata_.transaction_id.begin(), metadata_.transaction_id.size());
-    req.set_propagated_hybrid_time(context_.participant_context_.Now().ToUint64());
-    context_.rpcs_.RegisterAndStart(
-        client::GetTransactionStatus(
-            TransactionRpcDeadline(),
-            nullptr /* tablet */,
-            client,
-            &req,
-            std::bind(&RunningTransaction::StatusReceived, this, client, _1, _2, serial_no,
-                      shared_self)),
-        &get_status_handle_);
+  void SendStatusRequest(int64_t serial_no, const RunningTransactionPtr& shared_self) {
+    context_.ResolveStatus(shared_self, serial_no);
   }
 
-  void StatusReceived(client::YBClient* client,
-                      const Status& status,
-                      const tserver::GetTransactionStatusResponsePB& response,
+  void StatusReceived(const Result<TransactionStatusResult>& result,
                       int64_t serial_no,
                       const RunningTransactionPtr& shared_self) {
     auto delay_usec = FLAGS_transaction_delay_status_reply_usec_in_tests;
     if (delay_usec > 0) {
       context_.delayer().Delay(
           MonoTime::Now() + MonoDelta::FromMicroseconds(delay_usec),
-          std::bind(&RunningTransaction::DoStatusReceived, this, client, status, response,
-                    serial_no, shared_self));
+          std::bind(&RunningTransaction::DoStatusReceived, this, result, serial_no, shared_self));
     } else {
-      DoStatusReceived(client, status, response, serial_no, shared_self);
+      DoStatusReceived(result, serial_no, shared_self);
     }
   }
 
-  void DoStatusReceived(client::YBClient* client,
-                        const Status& status,
-                        const tserver::GetTransactionStatusResponsePB& response,
+  void DoStatusReceived(const Result<TransactionStatusResult>& result,
                         int64_t serial_no,
                         const RunningTransactionPtr& shared_self) {
-    if (response.has_propagated_hybrid_time()) {
-      context_.participant_context_.UpdateClock(HybridTime(response.propagated_hybrid_time()));
-    }
-
-    context_.rpcs_.Unregister(&get_status_handle_);
     decltype(status_waiters_) status_waiters;
     HybridTime time_of_status;
     TransactionStatus transaction_status;
-    const bool ok = status.ok();
     int64_t new_request_id = -1;
     {
       std::unique_lock<std::mutex> lock(context_.mutex_);
-      if (!ok) {
+      if (!result.ok()) {
         status_waiters_.swap(status_waiters);
         lock.unlock();
         for (const auto& waiter : status_waiters) {
-          waiter.callback(status);
+          waiter.callback(result.status());
         }
         return;
       }
 
-      DCHECK(response.has_status_hybrid_time() ||
-             response.status() == TransactionStatus::ABORTED);
-      time_of_status = response.has_status_hybrid_time()
-          ? HybridTime(response.status_hybrid_time())
-          : HybridTime::kMax;
+      DCHECK(result->status_time.is_valid() || result->status == TransactionStatus::ABORTED);
+      time_of_status = result->status_time.is_valid() ? result->status_time : HybridTime::kMax;
       if (last_known_status_hybrid_time_ <= time_of_status) {
         last_known_status_hybrid_time_ = time_of_status;
-        last_known_status_ = response.status();
-        if (response.status() == TransactionStatus::ABORTED &&
+        last_known_status_ = result->status;
+        if (result->status == TransactionStatus::ABORTED &&
             ThreadRestrictions::IsWaitAllowed() && // Required by IsLeader
             context_.participant_context_.IsLeader()) {
           context_.RemoveUnlocked(id(), "aborted"s);
@@ -611,7 +716,7 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
       }
     }
     if (new_request_id >= 0) {
-      SendStatusRequest(client, new_request_id, shared_self);
+      SendStatusRequest(new_request_id, shared_self);
     }
     NotifyWaiters(serial_no, time_of_status, transaction_status, status_waiters);
   }
@@ -712,6 +817,7 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
 
   TransactionMetadata metadata_;
   IntraTxnWriteId last_write_id_ = 0;
+  docdb::WrittenWeakIntentsPtr written_weak_intents_;
   RunningTransactionContext& context_;
   RemoveIntentsTask remove_intents_task_;
   HybridTime local_commit_time_ = HybridTime::kInvalid;
@@ -719,11 +825,70 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
   TransactionStatus last_known_status_ = TransactionStatus::CREATED;
   HybridTime last_known_status_hybrid_time_ = HybridTime::kMin;
   std::vector<StatusRequest> status_waiters_;
-  rpc::Rpcs::Handle get_status_handle_;
   rpc::Rpcs::Handle abort_handle_;
   std::vector<TransactionStatusCallback> abort_waiters_;
 };
 
+void RunningTransactionContext::ResolveStatus(
+    const RunningTransactionPtr& transaction, int64_t serial_no) {
+  TransactionStatusResolver* resolver;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!status_resolver_) {
+      // Participant context is not ready to provide client when participant is created,
+      // so resolver is picked on first use.
+      status_resolver_ = participant_context_.status_resolver();
+      if (!status_resolver_) {
+        own_status_resolver_ = std::make_unique<TransactionStatusResolver>(
+            participant_context_.client_future(), participant_context_.clock_ptr());
+        status_resolver_ = own_status_resolver_.get();
+      }
+    }
+    resolver = status_resolver_;
+    resolving_transactions_[transaction->id()] = transaction;
+  }
+  auto id = transaction->id();
+  resolver->Resolve(
+      transaction->metadata().status_tablet, id,
+      [callbacks = resolver_callbacks_, id, serial_no](
+          const Result<TransactionStatusResult>& result) {
+        callbacks->Invoke([&id, serial_no, &result](RunningTransactionContext* context) {
+          context->StatusResolved(id, serial_no, result);
+        });
+      });
+}
+
+void RunningTransactionContext::StatusResolved(
+    const TransactionId& id, int64_t serial_no, const Result<TransactionStatusResult>& result) {
+  RunningTransactionPtr transaction;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = resolving_transactions_.find(id);
+    if (it == resolving_transactions_.end()) {
+      return;
+    }
+    transaction = std::move(it->second);
+    resolving_transactions_.erase(it);
+  }
+  transaction->StatusReceived(result, serial_no, transaction);
+}
+
+void RunningTransactionContext::ShutdownStatusResolution() {
+  resolver_callbacks_->Shutdown();
+  decltype(resolving_transactions_) resolving_transactions;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    resolving_transactions.swap(resolving_transactions_);
+  }
+  auto status = STATUS(Aborted, "Transaction participant is shutting down");
+  for (const auto& id_and_transaction : resolving_transactions) {
+    id_and_transaction.second->DoStatusReceived(status, 0, id_and_transaction.second);
+  }
+  if (own_status_resolver_) {
+    own_status_resolver_->Shutdown();
+  }
+}
+
 } // namespace
 
 std::string TransactionApplyData::ToString() const {
@@ -745,6 +910,15 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   }
 
   ~Impl() {
+    ShutdownStatusResolution();
+    {
+      // Tasks of background apply always complete, because thread pool invokes Done for them.
+      // Tasks that are retrying failed apply are interrupted.
+      std::unique_lock<std::mutex> lock(apply_mutex_);
+      closing_ = true;
+      apply_cond_.notify_all();
+      apply_cond_.wait(lock, [this] { return running_applies_.empty(); });
+    }
     transactions_.clear();
     TransactionsModifiedUnlocked();
     rpcs_.Shutdown();
@@ -838,7 +1012,7 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   }
 
   boost::optional<std::pair<TransactionMetadata, IntraTxnWriteId>> MetadataWithWriteId(
-      const TransactionId& id) {
+      const TransactionId& id, docdb::WrittenWeakIntentsPtr* written_weak_intents) {
     // We are not trying to cleanup intents here because we don't know whether this transaction
     // has intents of not.
     auto lock_and_iterator = LockAndFindOrLoad(
@@ -847,10 +1021,14 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       return boost::none;
     }
     auto& transaction = lock_and_iterator.transaction();
+    if (written_weak_intents) {
+      *written_weak_intents = std::move(transaction.written_weak_intents());
+    }
     return std::make_pair(transaction.metadata(), transaction.last_write_id());
   }
 
-  void UpdateLastWriteId(const TransactionId& id, IntraTxnWriteId value) {
+  void UpdateLastWriteId(const TransactionId& id, IntraTxnWriteId value,
+                         docdb::WrittenWeakIntentsPtr* written_weak_intents) {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = transactions_.find(id);
     if (it == transactions_.end()) {
@@ -859,6 +1037,9 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       return;
     }
     (**it).UpdateLastWriteId(value);
+    if (written_weak_intents) {
+      (**it).written_weak_intents() = std::move(*written_weak_intents);
+    }
   }
 
   void RequestStatusAt(const StatusRequest& request) {
@@ -868,7 +1049,7 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
           STATUS_FORMAT(NotFound, "Request status of unknown transaction: $0", *request.id));
       return;
     }
-    lock_and_iterator.transaction().RequestStatusAt(client(), request, &lock_and_iterator.lock);
+    lock_and_iterator.transaction().RequestStatusAt(request, &lock_and_iterator.lock);
   }
 
   // Registers request, giving him newly allocated id and returning this id.
@@ -994,6 +1175,15 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   }
 
   CHECKED_STATUS ProcessApply(const TransactionApplyData& data) {
+    {
+      std::lock_guard<std::mutex> lock(apply_mutex_);
+      if (running_applies_.count(data.transaction_id)) {
+        // Coordinator resends APPLYING while we are applying intents in background.
+        VLOG_WITH_PREFIX(2) << "Apply is already running: " << data;
+        return Status::OK();
+      }
+    }
+
     {
       // It is our last chance to load transaction metadata, if missing.
       // Because it will be deleted when intents are applied.
@@ -1013,8 +1203,39 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
       lock_and_iterator.transaction().SetLocalCommitTime(data.commit_ht);
     }
 
-    CHECK_OK(applier_.ApplyIntents(data));
+    auto apply_state = applier_.ApplyIntents(data);
+    CHECK_OK(apply_state);
+
+    if (apply_state->active()) {
+      // Transaction is too big to be applied in a single batch. The rest of intents is applied
+      // in background, meanwhile transaction stays running with local commit time, so readers
+      // still see its intents as committed.
+      VLOG_WITH_PREFIX(2) << "Continue apply of " << data << " in background from "
+                          << apply_state->ToString();
+      {
+        std::lock_guard<std::mutex> lock(apply_mutex_);
+        running_applies_.emplace(data.transaction_id, data.op_id.index());
+      }
+      auto task = std::make_shared<ApplyIntentsTask>(this, data, std::move(*apply_state));
+      task->Prepare(task);
+      participant_context_.Enqueue(task.get());
+      return Status::OK();
+    }
 
+    FinishApply(data);
+    return Status::OK();
+  }
+
+  int64_t MinRunningApplyOpIndex() const {
+    std::lock_guard<std::mutex> lock(apply_mutex_);
+    auto result = std::numeric_limits<int64_t>::max();
+    for (const auto& id_and_index : running_applies_) {
+      result = std::min(result, id_and_index.second);
+    }
+    return result;
+  }
+
+  void FinishApply(const TransactionApplyData& data) {
     {
       // We are not trying to cleanup intents here because we don't know whether this transaction
       // has intents or not.
@@ -1026,7 +1247,45 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     }
 
     NotifyApplied(data);
-    return Status::OK();
+  }
+
+  // Applies the rest of intents of transaction, starting from apply state referenced by data.
+  // Coordinator already got reply for APPLYING, so failed batches are retried until they succeed.
+  // Meanwhile apply stays in running_applies_, so its APPLY operation is not flushed and will be
+  // replayed by bootstrap if tablet restarts.
+  void ApplyRemainingIntents(TransactionApplyData* data, docdb::ApplyTransactionState* state) {
+    auto backoff = std::chrono::milliseconds(FLAGS_txn_apply_retry_initial_delay_ms);
+    while (state->active()) {
+      auto next_state = applier_.ApplyIntents(*data);
+      if (next_state.ok()) {
+        *state = std::move(*next_state);
+        continue;
+      }
+      LOG_WITH_PREFIX(WARNING) << "Failed to apply intents of " << data->transaction_id
+                               << ", will retry in " << backoff.count() << "ms: "
+                               << next_state.status();
+      std::unique_lock<std::mutex> lock(apply_mutex_);
+      if (apply_cond_.wait_for(lock, backoff, [this] { return closing_; })) {
+        // Participant is destroyed, so the tablet is already shut down. Intents and APPLY
+        // operation in WAL are kept, so apply is completed by bootstrap.
+        LOG_WITH_PREFIX(WARNING) << "Apply of " << data->transaction_id
+                                 << " interrupted by shutdown";
+        running_applies_.erase(data->transaction_id);
+        lock.unlock();
+        apply_cond_.notify_all();
+        return;
+      }
+      backoff = std::min(backoff * 2, std::chrono::milliseconds(
+          FLAGS_txn_apply_retry_max_delay_ms));
+    }
+
+    FinishApply(*data);
+
+    {
+      std::lock_guard<std::mutex> lock(apply_mutex_);
+      running_applies_.erase(data->transaction_id);
+    }
+    apply_cond_.notify_all();
   }
 
   void NotifyApplied(const TransactionApplyData& data) {
@@ -1090,6 +1349,39 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     return &participant_context_;
   }
 
+  void WaitForAnyCompleted(
+      const std::vector<TransactionId>& ids, CoarseTimePoint deadline, StatusFunctor callback) {
+    std::vector<TransactionId> running_ids;
+    std::shared_ptr<CompletionWaiter> waiter;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& id : ids) {
+        if (transactions_.find(id) != transactions_.end()) {
+          running_ids.push_back(id);
+        }
+      }
+      waiter = std::make_shared<CompletionWaiter>(
+          &participant_context_, std::move(running_ids),
+          std::bind(&Impl::UnregisterCompletionWaiter, this, _1), std::move(callback));
+      for (const auto& id : waiter->ids()) {
+        completion_waiters_[id].push_back(waiter);
+      }
+    }
+
+    // None of transactions is running here, so operation could be retried right away.
+    // The same when client is not ready yet, since we should not block waiting for it.
+    auto* scheduler = ClientScheduler();
+    if (waiter->ids().empty() || !scheduler) {
+      waiter->Trigger();
+      return;
+    }
+
+    auto timer_task_id = scheduler->Schedule(
+        [waiter](const Status& status) { waiter->Trigger(); },
+        std::chrono::steady_clock::now() + (deadline - CoarseMonoClock::now()));
+    waiter->SetTimer(scheduler, timer_task_id);
+  }
+
   size_t TEST_GetNumRunningTransactions() {
     std::lock_guard<std::mutex> lock(mutex_);
     VLOG_WITH_PREFIX(4) << "Transactions: " << yb::ToString(transactions_);
@@ -1267,6 +1559,15 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     return participant_context_.client_future().get();
   }
 
+  // Returns scheduler of client messenger, or null when client is not resolved yet.
+  rpc::Scheduler* ClientScheduler() const {
+    const auto& client_future = participant_context_.client_future();
+    if (client_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return nullptr;
+    }
+    return &client_future.get()->messenger()->scheduler();
+  }
+
   const std::string& LogPrefix() const override {
     return log_prefix_;
   }
@@ -1278,10 +1579,40 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     recently_removed_transactions_cleanup_queue_.push_back({transaction.id(), now + 5s});
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
+    NotifyCompletionWaitersUnlocked(transaction.id());
     transactions_.erase(it);
     TransactionsModifiedUnlocked();
   }
 
+  void NotifyCompletionWaitersUnlocked(const TransactionId& id) {
+    auto it = completion_waiters_.find(id);
+    if (it == completion_waiters_.end()) {
+      return;
+    }
+    for (const auto& waiter : it->second) {
+      waiter->Trigger();
+    }
+    completion_waiters_.erase(it);
+  }
+
+  void UnregisterCompletionWaiter(CompletionWaiter* waiter) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& id : waiter->ids()) {
+      auto it = completion_waiters_.find(id);
+      if (it == completion_waiters_.end()) {
+        continue;
+      }
+      auto& waiters = it->second;
+      waiters.erase(
+          std::remove_if(waiters.begin(), waiters.end(),
+                         [waiter](const auto& entry) { return entry.get() == waiter; }),
+          waiters.end());
+      if (waiters.empty()) {
+        completion_waiters_.erase(it);
+      }
+    }
+  }
+
   void CleanupRecentlyRemovedTransactions(CoarseTimePoint now) {
     while (!recently_removed_transactions_cleanup_queue_.empty() &&
            recently_removed_transactions_cleanup_queue_.front().time <= now) {
@@ -1300,6 +1631,42 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
     TransactionId transaction_id;
   };
 
+  // Applies intents of big transaction in background, batch by batch.
+  class ApplyIntentsTask : public rpc::ThreadPoolTask {
+   public:
+    ApplyIntentsTask(Impl* impl, const TransactionApplyData& data,
+                     docdb::ApplyTransactionState state)
+        : impl_(*impl), data_(data), state_(std::move(state)) {
+      data_.apply_state = &state_;
+    }
+
+    void Prepare(std::shared_ptr<ApplyIntentsTask> self) {
+      retain_self_ = std::move(self);
+    }
+
+    void Run() override {
+      executed_ = true;
+      impl_.ApplyRemainingIntents(&data_, &state_);
+    }
+
+    void Done(const Status& status) override {
+      if (!executed_) {
+        // Thread pool is not available, for instance during bootstrap, so apply in place.
+        Run();
+      }
+      retain_self_.reset();
+    }
+
+    virtual ~ApplyIntentsTask() {}
+
+   private:
+    Impl& impl_;
+    TransactionApplyData data_;
+    docdb::ApplyTransactionState state_;
+    bool executed_ = false;
+    std::shared_ptr<ApplyIntentsTask> retain_self_;
+  };
+
   std::string log_prefix_;
 
   rocksdb::DB* db_ = nullptr;
@@ -1323,9 +1690,22 @@ class TransactionParticipant::Impl : public RunningTransactionContext {
   };
   std::deque<RecentlyRemovedTransaction> recently_removed_transactions_cleanup_queue_;
 
+  // Requests that wait for completion of the transaction, i.e. for its removal from this
+  // participant after it was applied or aborted.
+  std::unordered_map<TransactionId, std::vector<std::shared_ptr<CompletionWaiter>>,
+                     TransactionIdHash> completion_waiters_;
+
   scoped_refptr<AtomicGauge<uint64_t>> metric_transactions_running_;
   scoped_refptr<Counter> metric_transaction_load_attempts_;
   scoped_refptr<Counter> metric_transaction_not_found_;
+
+  mutable std::mutex apply_mutex_;
+  std::condition_variable apply_cond_;
+  // Transactions whose intents are being applied in background, mapped to op index of their
+  // apply operation.
+  std::unordered_map<TransactionId, int64_t, TransactionIdHash> running_applies_;
+  // Set when participant is destroyed, protected by apply_mutex_.
+  bool closing_ = false;
 };
 
 TransactionParticipant::TransactionParticipant(
@@ -1348,12 +1728,14 @@ boost::optional<TransactionMetadata> TransactionParticipant::Metadata(const Tran
 
 boost::optional<std::pair<TransactionMetadata, IntraTxnWriteId>>
     TransactionParticipant::MetadataWithWriteId(
-    const TransactionId& id) {
-  return impl_->MetadataWithWriteId(id);
+    const TransactionId& id, docdb::WrittenWeakIntentsPtr* written_weak_intents) {
+  return impl_->MetadataWithWriteId(id, written_weak_intents);
 }
 
-void TransactionParticipant::UpdateLastWriteId(const TransactionId& id, IntraTxnWriteId value) {
-  return impl_->UpdateLastWriteId(id, value);
+void TransactionParticipant::UpdateLastWriteId(
+    const TransactionId& id, IntraTxnWriteId value,
+    docdb::WrittenWeakIntentsPtr* written_weak_intents) {
+  return impl_->UpdateLastWriteId(id, value, written_weak_intents);
 }
 
 HybridTime TransactionParticipant::LocalCommitTime(const TransactionId& id) {
@@ -1398,6 +1780,10 @@ Status TransactionParticipant::ProcessReplicated(const ReplicatedData& data) {
   return impl_->ProcessReplicated(data);
 }
 
+int64_t TransactionParticipant::MinRunningApplyOpIndex() const {
+  return impl_->MinRunningApplyOpIndex();
+}
+
 void TransactionParticipant::SetDB(rocksdb::DB* db, const docdb::KeyBounds* key_bounds) {
   impl_->SetDB(db, key_bounds);
 }
@@ -1406,6 +1792,11 @@ TransactionParticipantContext* TransactionParticipant::context() const {
   return impl_->participant_context();
 }
 
+void TransactionParticipant::WaitForAnyCompleted(
+    const std::vector<TransactionId>& ids, CoarseTimePoint deadline, StatusFunctor callback) {
+  impl_->WaitForAnyCompleted(ids, deadline, std::move(callback));
+}
+
 size_t TransactionParticipant::TEST_GetNumRunningTransactions() const {
   return impl_->TEST_GetNumRunningTransactions();
 }
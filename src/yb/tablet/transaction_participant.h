@@ -31,12 +31,14 @@
 #include "yb/consensus/opid_util.h"
 
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb_fwd.h"
 
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/server/server_fwd.h"
 
 #include "yb/util/async_util.h"
+#include "yb/util/monotime.h"
 #include "yb/util/opid.pb.h"
 #include "yb/util/result.h"
 
@@ -61,6 +63,7 @@ class TransactionStatePB;
 namespace tablet {
 
 class TransactionIntentApplier;
+class TransactionStatusResolver;
 class UpdateTxnOperationState;
 
 struct TransactionApplyData {
@@ -70,6 +73,8 @@ struct TransactionApplyData {
   HybridTime commit_ht;
   HybridTime log_ht;
   TabletId status_tablet;
+  // State to continue partial apply from, null when apply is started.
+  const docdb::ApplyTransactionState* apply_state = nullptr;
 
   std::string ToString() const;
 };
@@ -82,7 +87,8 @@ struct RemoveIntentsData {
 // Interface to object that should apply intents in RocksDB when transaction is applying.
 class TransactionIntentApplier {
  public:
-  virtual CHECKED_STATUS ApplyIntents(const TransactionApplyData& data) = 0;
+  // Applies next batch of intents. Returns active state when not all intents were applied.
+  virtual Result<docdb::ApplyTransactionState> ApplyIntents(const TransactionApplyData& data) = 0;
   virtual CHECKED_STATUS RemoveIntents(
       const RemoveIntentsData& data, const TransactionId& transaction_id) = 0;
   virtual CHECKED_STATUS RemoveIntents(
@@ -100,6 +106,9 @@ class TransactionParticipantContext {
   virtual const std::shared_future<client::YBClient*>& client_future() const = 0;
   virtual const server::ClockPtr& clock_ptr() const = 0;
 
+  // Resolver shared by tablets of the server, participant uses its own resolver when it is null.
+  virtual TransactionStatusResolver* status_resolver() const = 0;
+
   // Fills RemoveIntentsData with information about replicated state.
   virtual void GetLastReplicatedData(RemoveIntentsData* data) = 0;
 
@@ -130,10 +139,14 @@ class TransactionParticipant : public TransactionStatusManager {
 
   boost::optional<TransactionMetadata> Metadata(const TransactionId& id) override;
 
+  // When written_weak_intents is specified, weak intents already written by the transaction are
+  // moved to it. They should be returned back with UpdateLastWriteId.
   boost::optional<std::pair<TransactionMetadata, IntraTxnWriteId>> MetadataWithWriteId(
-      const TransactionId& id);
+      const TransactionId& id, docdb::WrittenWeakIntentsPtr* written_weak_intents = nullptr);
 
-  void UpdateLastWriteId(const TransactionId& id, IntraTxnWriteId value);
+  void UpdateLastWriteId(
+      const TransactionId& id, IntraTxnWriteId value,
+      docdb::WrittenWeakIntentsPtr* written_weak_intents = nullptr);
 
   HybridTime LocalCommitTime(const TransactionId& id) override;
 
@@ -158,6 +171,16 @@ class TransactionParticipant : public TransactionStatusManager {
 
   CHECKED_STATUS ProcessReplicated(const ReplicatedData& data);
 
+  // Returns min op index of apply operations whose intents are being applied in background,
+  // or max int64 when there are no such operations.
+  int64_t MinRunningApplyOpIndex() const;
+
+  // Invokes callback in thread pool when any of specified transactions is applied or aborted on
+  // this tablet, or deadline passes. Callback is scheduled right away if none of them is running
+  // here. It receives non OK status only if it could not be scheduled to thread pool.
+  void WaitForAnyCompleted(
+      const std::vector<TransactionId>& ids, CoarseTimePoint deadline, StatusFunctor callback);
+
   void SetDB(rocksdb::DB* db, const docdb::KeyBounds* key_bounds);
 
   TransactionParticipantContext* context() const;
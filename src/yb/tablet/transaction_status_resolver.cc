@@ -0,0 +1,367 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_status_resolver.h"
+
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "yb/client/transaction_rpc.h"
+
+#include "yb/gutil/casts.h"
+
+#include "yb/rpc/rpc.h"
+
+#include "yb/server/clock.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/result.h"
+
+using namespace std::placeholders;
+
+DEFINE_int32(transaction_status_resolver_max_batch_size, 1000,
+             "Max number of transactions whose status is requested from status tablet in a single "
+             "RPC.");
+TAG_FLAG(transaction_status_resolver_max_batch_size, advanced);
+
+DEFINE_bool(transaction_status_resolver_batch_requests, true,
+            "Whether to request status of multiple transactions in a single RPC. Should be "
+            "disabled while the cluster has tablet servers that do not support batched requests.");
+TAG_FLAG(transaction_status_resolver_batch_requests, advanced);
+TAG_FLAG(transaction_status_resolver_batch_requests, runtime);
+
+DEFINE_int32(transaction_status_cache_ttl_ms, 5000,
+             "Time to keep commit time of committed transaction in the status resolver cache.");
+TAG_FLAG(transaction_status_cache_ttl_ms, advanced);
+
+DEFINE_int32(transaction_status_cache_max_size, 100000,
+             "Max number of transaction statuses kept in the status resolver cache.");
+TAG_FLAG(transaction_status_cache_max_size, advanced);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+Result<TransactionStatusResult> StatusFromResponse(
+    const tserver::GetTransactionStatusResponsePB& response, size_t idx) {
+  auto status = response.status(idx);
+  if (response.status_hybrid_time().size() == response.status().size()) {
+    return TransactionStatusResult(status, HybridTime(response.status_hybrid_time(idx)));
+  }
+  // Coordinator of older version does not set status time for aborted transactions.
+  if (response.status_hybrid_time().empty() && status == TransactionStatus::ABORTED) {
+    return TransactionStatusResult(status, HybridTime::kMax);
+  }
+  return STATUS_FORMAT(
+      IllegalState, "Missing status time for $0 transaction: $1",
+      TransactionStatus_Name(status), response.ShortDebugString());
+}
+
+} // namespace
+
+class TransactionStatusResolver::Impl {
+ public:
+  Impl(const std::shared_future<client::YBClient*>& client_future, const server::ClockPtr& clock)
+      : client_future_(client_future), clock_(clock) {}
+
+  ~Impl() {
+    Shutdown();
+  }
+
+  void Shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closing_) {
+        return;
+      }
+      closing_ = true;
+    }
+    // Callbacks of in flight batches are invoked with abort status by Rpcs::Shutdown.
+    rpcs_.Shutdown();
+
+    decltype(status_tablets_) status_tablets;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      status_tablets.swap(status_tablets_);
+    }
+    auto status = STATUS(Aborted, "Transaction status resolver is shutting down");
+    for (auto& tablet_and_data : status_tablets) {
+      for (auto& id_and_callbacks : tablet_and_data.second.pending) {
+        for (const auto& callback : id_and_callbacks.second) {
+          callback(status);
+        }
+      }
+    }
+  }
+
+  void Resolve(const TabletId& status_tablet, const TransactionId& transaction_id,
+               TransactionStatusCallback callback) {
+    BatchPtr batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (closing_) {
+        lock.unlock();
+        callback(STATUS(Aborted, "Transaction status resolver is shutting down"));
+        return;
+      }
+      auto it = cache_.find(transaction_id);
+      if (it != cache_.end()) {
+        auto result = it->second;
+        lock.unlock();
+        callback(result);
+        return;
+      }
+      auto& data = status_tablets_[status_tablet];
+      data.pending[transaction_id].push_back(std::move(callback));
+      batch = PrepareBatchUnlocked(status_tablet, &data);
+    }
+    Send(batch);
+  }
+
+  size_t TEST_CacheSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.size();
+  }
+
+ private:
+  struct StatusTabletData {
+    // Transactions whose status should be requested by the next batch, with their callbacks.
+    std::unordered_map<
+        TransactionId, std::vector<TransactionStatusCallback>, TransactionIdHash> pending;
+    // Whether there is a batch in flight to this status tablet.
+    bool in_flight = false;
+  };
+
+  struct Batch {
+    TabletId status_tablet;
+    std::vector<TransactionId> ids;
+    std::vector<std::vector<TransactionStatusCallback>> callbacks;
+    rpc::Rpcs::Handle handle;
+  };
+
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  struct CacheQueueEntry {
+    TransactionId id;
+    CoarseTimePoint expiration;
+  };
+
+  // Takes pending requests of status tablet, when there is no batch in flight to this tablet.
+  BatchPtr PrepareBatchUnlocked(const TabletId& status_tablet, StatusTabletData* data) {
+    if (data->in_flight || data->pending.empty()) {
+      return nullptr;
+    }
+    auto batch = std::make_shared<Batch>();
+    batch->status_tablet = status_tablet;
+    const size_t max_batch_size =
+        FLAGS_transaction_status_resolver_batch_requests &&
+            !single_id_status_tablets_.count(status_tablet)
+        ? std::max(FLAGS_transaction_status_resolver_max_batch_size, 1) : 1;
+    for (auto it = data->pending.begin();
+         it != data->pending.end() && batch->ids.size() < max_batch_size;) {
+      batch->ids.push_back(it->first);
+      batch->callbacks.push_back(std::move(it->second));
+      it = data->pending.erase(it);
+    }
+    data->in_flight = true;
+    batch->handle = rpcs_.Prepare();
+    return batch;
+  }
+
+  void Send(const BatchPtr& batch) {
+    if (!batch) {
+      return;
+    }
+    if (batch->handle == rpcs_.InvalidHandle()) {
+      Complete(batch, STATUS(Aborted, "Transaction status resolver is shutting down"),
+               tserver::GetTransactionStatusResponsePB());
+      return;
+    }
+
+    VLOG(4) << "Request status of " << batch->ids.size() << " transactions from "
+            << batch->status_tablet;
+
+    tserver::GetTransactionStatusRequestPB req;
+    req.set_tablet_id(batch->status_tablet);
+    for (const auto& id : batch->ids) {
+      req.add_transaction_id(id.data, id.size());
+    }
+    req.set_propagated_hybrid_time(clock_->Now().ToUint64());
+    *batch->handle = client::GetTransactionStatus(
+        TransactionRpcDeadline(),
+        nullptr /* tablet */,
+        client_future_.get(),
+        &req,
+        std::bind(&Impl::StatusReceived, this, _1, _2, batch));
+    (**batch->handle).SendRpc();
+  }
+
+  void StatusReceived(const Status& status,
+                      const tserver::GetTransactionStatusResponsePB& response,
+                      const BatchPtr& batch) {
+    if (response.has_propagated_hybrid_time()) {
+      clock_->Update(HybridTime(response.propagated_hybrid_time()));
+    }
+    rpcs_.Unregister(&batch->handle);
+
+    // Coordinator that does not support batched requests reads only one of requested ids,
+    // so request them one by one.
+    if (status.ok() && batch->ids.size() > 1 && response.status().size() == 1) {
+      RetryAsSingleIdRequests(batch);
+      return;
+    }
+
+    Status batch_status = status;
+    if (batch_status.ok() &&
+        implicit_cast<size_t>(response.status().size()) != batch->ids.size()) {
+      batch_status = STATUS_FORMAT(
+          IllegalState, "Wrong number of statuses for $0 transactions: $1",
+          batch->ids.size(), response.ShortDebugString());
+    }
+    Complete(batch, batch_status, response);
+  }
+
+  void RetryAsSingleIdRequests(const BatchPtr& batch) {
+    BatchPtr next_batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (single_id_status_tablets_.insert(batch->status_tablet).second) {
+        LOG(INFO) << "Status tablet " << batch->status_tablet
+                  << " does not support batched status requests, requesting one by one";
+      }
+      auto& data = status_tablets_[batch->status_tablet];
+      data.in_flight = false;
+      for (size_t i = 0; i != batch->ids.size(); ++i) {
+        auto& callbacks = data.pending[batch->ids[i]];
+        std::move(batch->callbacks[i].begin(), batch->callbacks[i].end(),
+                  std::back_inserter(callbacks));
+      }
+      if (!closing_) {
+        next_batch = PrepareBatchUnlocked(batch->status_tablet, &data);
+      }
+    }
+    Send(next_batch);
+  }
+
+  // Notifies callbacks of the batch and sends next batch to the same status tablet.
+  void Complete(const BatchPtr& batch, const Status& status,
+                const tserver::GetTransactionStatusResponsePB& response) {
+    std::vector<Result<TransactionStatusResult>> results;
+    results.reserve(batch->ids.size());
+    for (size_t i = 0; i != batch->ids.size(); ++i) {
+      if (status.ok()) {
+        results.push_back(StatusFromResponse(response, i));
+      } else {
+        results.push_back(status);
+      }
+    }
+
+    BatchPtr next_batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (status.ok()) {
+        auto now = CoarseMonoClock::now();
+        CleanupCacheUnlocked(now);
+        for (size_t i = 0; i != batch->ids.size(); ++i) {
+          // Aborted is not cached, because coordinator also reports it for transactions it does
+          // not know about, for instance when the status tablet leader has just changed.
+          if (results[i].ok() && results[i]->status == TransactionStatus::COMMITTED) {
+            AddToCacheUnlocked(batch->ids[i], *results[i], now);
+          }
+        }
+      }
+      auto it = status_tablets_.find(batch->status_tablet);
+      if (it != status_tablets_.end()) {
+        it->second.in_flight = false;
+        if (!closing_) {
+          next_batch = PrepareBatchUnlocked(batch->status_tablet, &it->second);
+        }
+        if (!next_batch && it->second.pending.empty()) {
+          status_tablets_.erase(it);
+        }
+      }
+    }
+
+    for (size_t i = 0; i != batch->ids.size(); ++i) {
+      for (const auto& callback : batch->callbacks[i]) {
+        callback(results[i]);
+      }
+    }
+
+    Send(next_batch);
+  }
+
+  void AddToCacheUnlocked(
+      const TransactionId& id, const TransactionStatusResult& result, CoarseTimePoint now) {
+    if (cache_.size() >= implicit_cast<size_t>(FLAGS_transaction_status_cache_max_size)) {
+      return;
+    }
+    if (cache_.emplace(id, result).second) {
+      cache_queue_.push_back(
+          {id, now + std::chrono::milliseconds(FLAGS_transaction_status_cache_ttl_ms)});
+    }
+  }
+
+  void CleanupCacheUnlocked(CoarseTimePoint now) {
+    while (!cache_queue_.empty() && cache_queue_.front().expiration <= now) {
+      cache_.erase(cache_queue_.front().id);
+      cache_queue_.pop_front();
+    }
+  }
+
+  const std::shared_future<client::YBClient*> client_future_;
+  const server::ClockPtr clock_;
+  rpc::Rpcs rpcs_;
+
+  mutable std::mutex mutex_;
+  bool closing_ = false;
+  std::unordered_map<TabletId, StatusTabletData> status_tablets_;
+  // Status tablets whose leader does not support batched requests.
+  std::unordered_set<TabletId> single_id_status_tablets_;
+  std::unordered_map<TransactionId, TransactionStatusResult, TransactionIdHash> cache_;
+  // Cached transactions ordered by expiration time.
+  std::deque<CacheQueueEntry> cache_queue_;
+};
+
+TransactionStatusResolver::TransactionStatusResolver(
+    const std::shared_future<client::YBClient*>& client_future, const server::ClockPtr& clock)
+    : impl_(new Impl(client_future, clock)) {
+}
+
+TransactionStatusResolver::~TransactionStatusResolver() {
+}
+
+void TransactionStatusResolver::Shutdown() {
+  impl_->Shutdown();
+}
+
+void TransactionStatusResolver::Resolve(
+    const TabletId& status_tablet, const TransactionId& transaction_id,
+    TransactionStatusCallback callback) {
+  impl_->Resolve(status_tablet, transaction_id, std::move(callback));
+}
+
+size_t TransactionStatusResolver::TEST_CacheSize() const {
+  return impl_->TEST_CacheSize();
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,65 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TRANSACTION_STATUS_RESOLVER_H
+#define YB_TABLET_TRANSACTION_STATUS_RESOLVER_H
+
+#include <future>
+#include <memory>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/entity_ids.h"
+#include "yb/common/transaction.h"
+
+#include "yb/server/server_fwd.h"
+
+namespace yb {
+namespace tablet {
+
+// Resolves status of transactions by requesting it from their status tablets.
+// Status requests for the same status tablet that are issued while a request to this tablet is
+// in flight are coalesced and sent as a single batched RPC.
+// Commit times of committed transactions are cached for a while, so requests from different
+// tablets of this server do not query status tablet again. Aborted status is not cached, because
+// it is also reported for transactions unknown to the coordinator.
+// Falls back to requesting one transaction per RPC from status tablets that do not support
+// batched requests.
+//
+// Single instance is shared by all tablets of tablet server.
+class TransactionStatusResolver {
+ public:
+  TransactionStatusResolver(const std::shared_future<client::YBClient*>& client_future,
+                            const server::ClockPtr& clock);
+  ~TransactionStatusResolver();
+
+  // Aborts all in flight requests, callbacks of pending requests are invoked with Aborted status.
+  void Shutdown();
+
+  // Requests status of transaction managed by specified status tablet.
+  // Callback is invoked with status result or with error. For aborted transactions status time
+  // is HybridTime::kMax.
+  void Resolve(const TabletId& status_tablet, const TransactionId& transaction_id,
+               TransactionStatusCallback callback);
+
+  size_t TEST_CacheSize() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TRANSACTION_STATUS_RESOLVER_H
@@ -32,9 +32,13 @@
 
 #include "yb/tserver/heartbeater.h"
 
+#include <sys/resource.h>
+
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <unordered_map>
 
 #include <gflags/gflags.h>
 #include <glog/logging.h>
@@ -42,12 +46,14 @@
 #include "yb/common/wire_protocol.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/sysinfo.h"
 #include "yb/master/master.h"
 #include "yb/master/master.proxy.h"
 #include "yb/master/master_rpc.h"
 #include "yb/server/server_base.proxy.h"
 #include "yb/server/webserver.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tablet_server_options.h"
 #include "yb/tserver/ts_tablet_manager.h"
@@ -125,6 +131,8 @@ class Heartbeater::Thread {
   void SetupCommonField(master::TSToMasterCommonPB* common);
   bool IsCurrentThread() const;
   uint64_t CalculateUptime();
+  // Fills per tablet loads and CPU usage of the process, that are used by the load balancer.
+  void FillLoadMetrics(double interval_sec, master::TServerMetricsPB* metrics);
 
   const std::string& LogPrefix() const {
     return log_prefix_;
@@ -190,6 +198,10 @@ class Heartbeater::Thread {
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
 
+  // Read and write ops per tablet and process CPU time, at the previous metrics submission.
+  std::unordered_map<TabletId, std::pair<uint64_t, uint64_t>> prev_tablet_ops_;
+  uint64_t prev_cpu_usec_ = 0;
+
   MonoTime start_time_;
 
   rpc::Rpcs rpcs_;
@@ -342,6 +354,48 @@ int Heartbeater::Thread::GetMillisUntilNextHeartbeat() const {
   return FLAGS_heartbeat_interval_ms;
 }
 
+void Heartbeater::Thread::FillLoadMetrics(
+    double interval_sec, master::TServerMetricsPB* metrics) {
+  std::vector<std::shared_ptr<tablet::TabletPeer>> tablet_peers;
+  server_->tablet_manager()->GetTabletPeers(&tablet_peers);
+  decltype(prev_tablet_ops_) tablet_ops;
+  for (const auto& tablet_peer : tablet_peers) {
+    auto tablet = tablet_peer ? tablet_peer->shared_tablet() : nullptr;
+    if (!tablet || !tablet->metrics()) {
+      continue;
+    }
+    auto* tablet_metrics = tablet->metrics();
+    uint64_t reads = tablet_metrics->ql_read_latency->TotalCount() +
+                     tablet_metrics->redis_read_latency->TotalCount();
+    uint64_t writes = tablet_metrics->write_op_duration_client_propagated_consistency->TotalCount();
+    auto* load = metrics->add_tablet_loads();
+    load->set_tablet_id(tablet_peer->tablet_id());
+    load->set_sst_file_size(tablet->GetCurrentVersionSstFilesSize());
+    // Rates are reported only for tablets that were seen during the previous submission.
+    // Counters are reset when tablet is reopened, so sample is skipped when they decrease.
+    auto it = prev_tablet_ops_.find(tablet_peer->tablet_id());
+    if (interval_sec > 0 && it != prev_tablet_ops_.end() &&
+        reads >= it->second.first && writes >= it->second.second) {
+      load->set_read_ops_per_sec((reads - it->second.first) / interval_sec);
+      load->set_write_ops_per_sec((writes - it->second.second) / interval_sec);
+    }
+    tablet_ops.emplace(tablet_peer->tablet_id(), std::make_pair(reads, writes));
+  }
+  prev_tablet_ops_ = std::move(tablet_ops);
+
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    uint64_t cpu_usec =
+        (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ULL +
+        usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    if (interval_sec > 0 && prev_cpu_usec_ != 0) {
+      metrics->set_cpu_usage(std::min(
+          1.0, (cpu_usec - prev_cpu_usec_) / (interval_sec * 1e6 * base::NumCPUs())));
+    }
+    prev_cpu_usec_ = cpu_usec;
+  }
+}
+
 // Calculate Uptime
 uint64_t Heartbeater::Thread::CalculateUptime() {
   MonoDelta delta = MonoTime::Now().GetDeltaSince(start_time_);
@@ -422,6 +476,7 @@ Status Heartbeater::Thread::TryHeartbeat() {
     prev_writes_ = num_writes;
     req.mutable_metrics()->set_read_ops_per_sec(rops_per_sec);
     req.mutable_metrics()->set_write_ops_per_sec(wops_per_sec);
+    FillLoadMetrics(div, req.mutable_metrics());
     uint64_t uptime_seconds = CalculateUptime();
 
     req.mutable_metrics()->set_uptime_seconds(uptime_seconds);
@@ -493,7 +548,8 @@ Status Heartbeater::Thread::TryHeartbeat() {
   }
 
   // TODO: Handle TSHeartbeatResponsePB (e.g. deleted tablets and schema changes)
-  server_->tablet_manager()->MarkTabletReportAcknowledged(req.tablet_report());
+  server_->tablet_manager()->MarkTabletReportAcknowledged(
+      req.tablet_report(), &last_hb_response_.tablet_report());
 
   // Update the master's YSQL catalog version (i.e. if there were schema changes for YSQL objects).
   if (last_hb_response_.has_ysql_catalog_version()) {
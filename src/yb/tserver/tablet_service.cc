@@ -37,8 +37,6 @@
 #include <string>
 #include <vector>
 
-#include <boost/scope_exit.hpp>
-
 #include "yb/common/schema.h"
 #include "yb/common/wire_protocol.h"
 #include "yb/consensus/consensus.h"
@@ -76,6 +74,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/monotime.h"
+#include "yb/util/protobuf_util.h"
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status.h"
@@ -124,6 +123,17 @@ DEFINE_int32(max_wait_for_safe_time_ms, 5000,
 
 DEFINE_test_flag(bool, tserver_noop_read_write, false, "Respond NOOP to read/write.");
 
+DEFINE_test_flag(bool, reject_heartbeat_transactions_as_unknown_method, false,
+                 "Respond to HeartbeatTransactions like a tablet server of older version, that does "
+                 "not have this method.");
+
+DEFINE_test_flag(int32, inject_read_latency_ms, 0,
+                 "Delay reads served by the tablet server specified by "
+                 "inject_read_latency_tserver_uuid.");
+
+DEFINE_test_flag(string, inject_read_latency_tserver_uuid, "",
+                 "UUID of the tablet server that delays reads by inject_read_latency_ms.");
+
 DEFINE_int32(max_stale_read_bound_time_ms, 0, "If we are allowed to read from followers, "
              "specify the maximum time a follower can be behind by using the last message received "
              "from the leader. If set to zero, a read can be served by a follower regardless of "
@@ -512,6 +522,37 @@ void TabletServiceImpl::GetTransactionStatus(const GetTransactionStatusRequestPB
   }
 }
 
+void TabletServiceImpl::HeartbeatTransactions(const HeartbeatTransactionsRequestPB* req,
+                                              HeartbeatTransactionsResponsePB* resp,
+                                              rpc::RpcContext context) {
+  TRACE("HeartbeatTransactions");
+
+  if (FLAGS_reject_heartbeat_transactions_as_unknown_method) {
+    context.RespondRpcFailure(
+        rpc::ErrorStatusPB::ERROR_NO_SUCH_METHOD,
+        STATUS(InvalidArgument, "Unknown method HeartbeatTransactions"));
+    return;
+  }
+
+  UpdateClock(*req, server_->Clock());
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  auto status = tablet.peer->tablet()->transaction_coordinator()->Heartbeat(
+      req->transaction_id(), tablet.leader_term, resp);
+  resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+  if (status.ok()) {
+    context.RespondSuccess();
+  } else {
+    SetupErrorAndRespond(
+        resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR, &context);
+  }
+}
+
 void TabletServiceImpl::AbortTransaction(const AbortTransactionRequestPB* req,
                                          AbortTransactionResponsePB* resp,
                                          rpc::RpcContext context) {
@@ -1058,6 +1099,10 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
     context.RespondSuccess();
     return;
   }
+  if (PREDICT_FALSE(FLAGS_inject_read_latency_ms > 0) &&
+      server_->permanent_uuid() == FLAGS_inject_read_latency_tserver_uuid) {
+    SleepFor(MonoDelta::FromMilliseconds(FLAGS_inject_read_latency_ms));
+  }
   TRACE("Start Read");
   TRACE_EVENT1("tserver", "TabletServiceImpl::Read",
       "tablet_id", req->tablet_id());
@@ -1347,13 +1392,10 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
     DCHECK_EQ(read_context->tablet->table_type(), TableType::YQL_TABLE_TYPE);
     ReadRequestPB* mutable_req = const_cast<ReadRequestPB*>(read_context->req);
     for (QLReadRequestPB& ql_read_req : *mutable_req->mutable_ql_batch()) {
-      // Update the remote endpoint.
-      ql_read_req.set_allocated_remote_endpoint(read_context->host_port_pb);
-      ql_read_req.set_allocated_proxy_uuid(mutable_req->mutable_proxy_uuid());
-      BOOST_SCOPE_EXIT(&ql_read_req) {
-        ql_read_req.release_remote_endpoint();
-        ql_read_req.release_proxy_uuid();
-      } BOOST_SCOPE_EXIT_END;
+      // Update the remote endpoint. Copy instead of lending ownership via set_allocated/release,
+      // since the request could be allocated on an arena, that would take ownership of them.
+      *ql_read_req.mutable_remote_endpoint() = *read_context->host_port_pb;
+      ql_read_req.set_proxy_uuid(mutable_req->proxy_uuid());
 
       tablet::QLReadRequestResult result;
       TRACE("Start HandleQLReadRequest");
@@ -1373,7 +1415,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
       RETURN_NOT_OK(read_context->context->AddRpcSidecar(
           RefCntBuffer(result.rows_data), &rows_data_sidecar_idx));
       result.response.set_rows_data_sidecar(rows_data_sidecar_idx);
-      read_context->resp->add_ql_batch()->Swap(&result.response);
+      MoveToRepeatedField(&result.response, read_context->resp->mutable_ql_batch());
     }
     return ReadHybridTime();
   }
@@ -1397,7 +1439,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoRead(ReadContext* read_context) {
       RETURN_NOT_OK(read_context->context->AddRpcSidecar(
           RefCntBuffer(result.rows_data), &rows_data_sidecar_idx));
       result.response.set_rows_data_sidecar(rows_data_sidecar_idx);
-      read_context->resp->add_pgsql_batch()->Swap(&result.response);
+      MoveToRepeatedField(&result.response, read_context->resp->mutable_pgsql_batch());
     }
     return ReadHybridTime();
   }
@@ -112,6 +112,10 @@ class TabletServiceImpl : public TabletServerServiceIf {
                         AbortTransactionResponsePB* resp,
                         rpc::RpcContext context) override;
 
+  void HeartbeatTransactions(const HeartbeatTransactionsRequestPB* req,
+                             HeartbeatTransactionsResponsePB* resp,
+                             rpc::RpcContext context) override;
+
   void Truncate(const TruncateRequestPB* req,
                 TruncateResponsePB* resp,
                 rpc::RpcContext context) override;
@@ -319,5 +319,39 @@ TEST_F(TsTabletManagerTest, TestTabletReports) {
   ASSERT_MONOTONIC_REPORT_SEQNO(&seqno, report);
 }
 
+TEST_F(TsTabletManagerTest, TestIncrementalReportOmitsUnchangedConsensusState) {
+  TabletReportPB report;
+  tablet_manager_->GenerateFullTabletReport(&report);
+  tablet_manager_->MarkTabletReportAcknowledged(report);
+
+  ASSERT_OK(CreateNewTablet("tablet-1", schema_, nullptr));
+  ASSERT_OK(WaitFor([this, &report]() -> Result<bool> {
+    tablet_manager_->GenerateIncrementalTabletReport(&report);
+    return report.updated_tablets_size() == 1 &&
+           report.updated_tablets(0).state() == tablet::RUNNING &&
+           report.updated_tablets(0).committed_consensus_state().has_leader_uuid();
+  }, MonoDelta::FromSeconds(10), "Tablet reported with leader"));
+  tablet_manager_->MarkTabletReportAcknowledged(report);
+
+  // Consensus state is not reported again when it did not change.
+  tablet_manager_->MarkTabletDirty(
+      "tablet-1", std::make_shared<consensus::StateChangeContext>(
+          consensus::StateChangeReason::TABLET_PEER_STARTED));
+  tablet_manager_->GenerateIncrementalTabletReport(&report);
+  ASSERT_EQ(1, report.updated_tablets_size());
+  ASSERT_EQ(tablet::RUNNING, report.updated_tablets(0).state());
+  ASSERT_FALSE(report.updated_tablets(0).has_committed_consensus_state());
+
+  // Unless master asks for it.
+  master::TabletReportUpdatesPB updates;
+  auto* tablet_update = updates.add_tablets();
+  tablet_update->set_tablet_id("tablet-1");
+  tablet_update->set_needs_consensus_state(true);
+  tablet_manager_->MarkTabletReportAcknowledged(report, &updates);
+  tablet_manager_->GenerateIncrementalTabletReport(&report);
+  ASSERT_EQ(1, report.updated_tablets_size());
+  ASSERT_REPORT_HAS_UPDATED_TABLET(report, "tablet-1");
+}
+
 } // namespace tserver
 } // namespace yb
@@ -74,6 +74,7 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_options.h"
+#include "yb/tablet/transaction_status_resolver.h"
 
 #include "yb/tserver/heartbeater.h"
 #include "yb/tserver/remote_bootstrap_client.h"
@@ -242,6 +243,7 @@ using consensus::StartRemoteBootstrapRequestPB;
 using log::Log;
 using master::ReportedTabletPB;
 using master::TabletReportPB;
+using master::TabletReportUpdatesPB;
 using std::shared_ptr;
 using std::string;
 using std::vector;
@@ -424,6 +426,8 @@ Status TSTabletManager::Init() {
       FLAGS_tserver_yb_client_default_timeout_ms / 1000, "" /* tserver_uuid */,
       &server_->options(), server_->metric_entity(), server_->mem_tracker(),
       server_->messenger());
+  status_resolver_ = std::make_unique<tablet::TransactionStatusResolver>(
+      async_client_init_->get_client_future(), scoped_refptr<server::Clock>(server_->clock()));
 
   tablet_options_.env = server_->GetEnv();
   tablet_options_.rocksdb_env = server_->GetRocksDBEnv();
@@ -851,6 +855,7 @@ Result<TabletPeerPtr> TSTabletManager::CreateAndRegisterTabletPeer(
   TabletPeerPtr tablet_peer(new tablet::TabletPeer(
       meta, local_peer_pb_, scoped_refptr<server::Clock>(server_->clock()), fs_manager_->uuid(),
       Bind(&TSTabletManager::ApplyChange, Unretained(this), meta->raft_group_id())));
+  tablet_peer->SetTransactionStatusResolver(status_resolver_.get());
   RETURN_NOT_OK(RegisterTablet(meta->raft_group_id(), tablet_peer, mode));
   return tablet_peer;
 }
@@ -1139,6 +1144,10 @@ void TSTabletManager::CompleteShutdown() {
     peer->CompleteShutdown();
   }
 
+  if (status_resolver_) {
+    status_resolver_->Shutdown();
+  }
+
   // Shut down the apply pool.
   apply_pool_->Shutdown();
 
@@ -1417,6 +1426,19 @@ void TSTabletManager::CreateReportedTabletPB(const TabletPeerPtr& tablet_peer,
   }
 }
 
+namespace {
+
+// Returns serialized committed consensus state of a running tablet, or empty string otherwise.
+std::string SerializedConsensusState(const ReportedTabletPB& reported_tablet) {
+  if (reported_tablet.state() != tablet::RUNNING ||
+      !reported_tablet.has_committed_consensus_state()) {
+    return std::string();
+  }
+  return reported_tablet.committed_consensus_state().SerializeAsString();
+}
+
+} // namespace
+
 void TSTabletManager::GenerateIncrementalTabletReport(TabletReportPB* report) {
   report->Clear();
   report->set_is_incremental(true);
@@ -1454,6 +1476,27 @@ void TSTabletManager::GenerateIncrementalTabletReport(TabletReportPB* report) {
   for (const auto& replica : to_report) {
     CreateReportedTabletPB(replica, report->add_updated_tablets());
   }
+
+  // Consensus state is the bulk of the report, so omit it when master already has the same one.
+  // Serialize outside of the lock, since it could be slow for large configs.
+  std::vector<std::string> consensus_states;
+  consensus_states.reserve(report->updated_tablets_size());
+  for (const auto& reported_tablet : report->updated_tablets()) {
+    consensus_states.push_back(SerializedConsensusState(reported_tablet));
+  }
+
+  std::lock_guard<std::mutex> l(acked_consensus_states_mutex_);
+  for (int i = 0; i != report->updated_tablets_size(); ++i) {
+    auto& reported_tablet = *report->mutable_updated_tablets(i);
+    if (consensus_states[i].empty()) {
+      acked_consensus_states_.erase(reported_tablet.tablet_id());
+      continue;
+    }
+    auto it = acked_consensus_states_.find(reported_tablet.tablet_id());
+    if (it != acked_consensus_states_.end() && it->second == consensus_states[i]) {
+      reported_tablet.clear_committed_consensus_state();
+    }
+  }
 }
 
 void TSTabletManager::GenerateFullTabletReport(TabletReportPB* report) {
@@ -1478,7 +1521,39 @@ void TSTabletManager::GenerateFullTabletReport(TabletReportPB* report) {
   dirty_tablets_.clear();
 }
 
-void TSTabletManager::MarkTabletReportAcknowledged(const TabletReportPB& report) {
+void TSTabletManager::MarkTabletReportAcknowledged(const TabletReportPB& report,
+                                                   const TabletReportUpdatesPB* updates) {
+  std::vector<std::string> consensus_states;
+  consensus_states.reserve(report.updated_tablets_size());
+  for (const auto& reported_tablet : report.updated_tablets()) {
+    consensus_states.push_back(SerializedConsensusState(reported_tablet));
+  }
+
+  {
+    std::lock_guard<std::mutex> l(acked_consensus_states_mutex_);
+    if (!report.is_incremental()) {
+      acked_consensus_states_.clear();
+    }
+    for (const auto& tablet_id : report.removed_tablet_ids()) {
+      acked_consensus_states_.erase(tablet_id);
+    }
+    for (int i = 0; i != report.updated_tablets_size(); ++i) {
+      const auto& reported_tablet = report.updated_tablets(i);
+      if (reported_tablet.state() != tablet::RUNNING) {
+        acked_consensus_states_.erase(reported_tablet.tablet_id());
+      } else if (!consensus_states[i].empty()) {
+        acked_consensus_states_[reported_tablet.tablet_id()] = std::move(consensus_states[i]);
+      }
+    }
+    if (updates) {
+      for (const auto& tablet_update : updates->tablets()) {
+        if (tablet_update.needs_consensus_state()) {
+          acked_consensus_states_.erase(tablet_update.tablet_id());
+        }
+      }
+    }
+  }
+
   std::lock_guard<RWMutex> l(lock_);
 
   int32_t acked_seq = report.sequence_number();
@@ -1498,6 +1573,17 @@ void TSTabletManager::MarkTabletReportAcknowledged(const TabletReportPB& report)
       ++it;
     }
   }
+
+  if (updates) {
+    for (const auto& tablet_update : updates->tablets()) {
+      if (!tablet_update.needs_consensus_state()) {
+        continue;
+      }
+      VLOG(1) << tserver::LogPrefix(tablet_update.tablet_id(), fs_manager_->uuid())
+              << "Master requested consensus state, will report it in the next heartbeat";
+      dirty_tablets_[tablet_update.tablet_id()].change_seq = next_report_seq_;
+    }
+  }
 }
 
 Status TSTabletManager::HandleNonReadyTabletOnStartup(
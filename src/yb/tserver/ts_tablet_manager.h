@@ -33,6 +33,7 @@
 #define YB_TSERVER_TS_TABLET_MANAGER_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -79,6 +80,7 @@ class RaftConfigPB;
 namespace master {
 class ReportedTabletPB;
 class TabletReportPB;
+class TabletReportUpdatesPB;
 } // namespace master
 
 namespace tserver {
@@ -233,7 +235,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Mark that the master successfully received and processed the given
   // tablet report. This uses the report sequence number to "un-dirty" any
   // tablets which have not changed since the acknowledged report.
-  void MarkTabletReportAcknowledged(const master::TabletReportPB& report);
+  // Tablets for which master requested the consensus state in 'updates' are reported again.
+  void MarkTabletReportAcknowledged(const master::TabletReportPB& report,
+                                    const master::TabletReportUpdatesPB* updates = nullptr);
 
   // Get all of the tablets currently hosted on this server.
   void GetTabletPeers(TabletPeers* tablet_peers) const;
@@ -455,6 +459,12 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   std::set<std::string> tablets_being_remote_bootstrapped_;
 
+  // Serialized committed consensus state of RUNNING tablets, as of the last tablet report
+  // acknowledged by master. Incremental reports omit consensus states that match this map.
+  // Guarded by its own mutex, so comparing large states does not block lock_ writers.
+  std::mutex acked_consensus_states_mutex_;
+  std::unordered_map<TabletId, std::string> acked_consensus_states_;
+
   // Next tablet report seqno.
   int32_t next_report_seq_;
 
@@ -488,6 +498,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   boost::optional<yb::client::AsyncClientInitialiser> async_client_init_;
 
+  // Resolves statuses of transactions for all tablets of this server.
+  std::unique_ptr<tablet::TransactionStatusResolver> status_resolver_;
+
   TabletPeers shutting_down_peers_;
 
   std::shared_ptr<MemTracker> block_based_table_mem_tracker_;
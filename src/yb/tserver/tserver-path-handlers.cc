@@ -42,12 +42,15 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/quorum_util.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/numbers.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/walltime.h"
 #include "yb/server/webui_util.h"
+#include "yb/tablet/conflict_history.h"
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet.pb.h"
@@ -158,6 +161,10 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
       "/transactions", "",
       std::bind(&TabletServerPathHandlers::HandleTransactionsPage, this, _1, _2), true /* styled */,
       false /* is_on_nav_bar */);
+  server->RegisterPathHandler(
+      "/transaction-conflicts", "",
+      std::bind(&TabletServerPathHandlers::HandleTransactionConflictsPage, this, _1, _2),
+      true /* styled */, false /* is_on_nav_bar */);
   server->RegisterPathHandler(
       "/tablet-rowsetlayout-svg", "",
       std::bind(&TabletServerPathHandlers::HandleTabletSVGPage, this, _1, _2), true /* styled */,
@@ -285,8 +292,113 @@ std::map<TableIdentifier, TableInfo> GetTablesInfo(
   return table_map;
 }
 
+const size_t kMaxHotConflictKeys = 20;
+const size_t kMaxRecentConflicts = 100;
+
+struct TabletConflict {
+  std::string table_name;
+  TabletId tablet_id;
+  tablet::ConflictHistoryEntry entry;
+};
+
+struct HotConflictKey {
+  std::string table_name;
+  std::string key_prefix;
+  size_t count = 0;
+  std::map<docdb::ConflictOutcome, size_t> outcomes;
+};
+
 }  // anonymous namespace
 
+void TabletServerPathHandlers::HandleTransactionConflictsPage(const Webserver::WebRequest& req,
+                                                              std::stringstream* output) {
+  vector<std::shared_ptr<TabletPeer>> peers;
+  tserver_->tablet_manager()->GetTabletPeers(&peers);
+
+  std::vector<TabletConflict> conflicts;
+  for (const auto& peer : peers) {
+    auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    for (auto& entry : tablet->conflict_history().Entries()) {
+      conflicts.push_back(TabletConflict{
+          peer->tablet_metadata()->table_name(), peer->tablet_id(), std::move(entry)});
+    }
+  }
+
+  // Group conflicts by table and row.
+  std::map<std::pair<std::string, std::string>, HotConflictKey> hot_keys_map;
+  for (const auto& conflict : conflicts) {
+    auto prefix = tablet::ConflictKeyPrefix(conflict.entry.info.key).ToBuffer();
+    auto& hot_key = hot_keys_map[std::make_pair(conflict.table_name, prefix)];
+    if (hot_key.count == 0) {
+      hot_key.table_name = conflict.table_name;
+      hot_key.key_prefix = prefix;
+    }
+    ++hot_key.count;
+    ++hot_key.outcomes[conflict.entry.info.outcome];
+  }
+  std::vector<HotConflictKey> hot_keys;
+  hot_keys.reserve(hot_keys_map.size());
+  for (auto& key_and_hot_key : hot_keys_map) {
+    hot_keys.push_back(std::move(key_and_hot_key.second));
+  }
+  std::sort(hot_keys.begin(), hot_keys.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.count > rhs.count;
+  });
+  if (hot_keys.size() > kMaxHotConflictKeys) {
+    hot_keys.resize(kMaxHotConflictKeys);
+  }
+
+  *output << "<h1>Transaction Conflicts</h1>\n";
+  *output << "<p>Based on " << conflicts.size() << " sampled conflicts.</p>\n";
+  *output << "<h2>Hottest Conflicting Keys</h2>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Table name</th><th>Key</th><th>Conflicts</th><th>Outcomes</th></tr>\n";
+  for (const auto& hot_key : hot_keys) {
+    std::string outcomes;
+    for (const auto& outcome_and_count : hot_key.outcomes) {
+      outcomes += Substitute("$0: $1<br>", ToString(outcome_and_count.first),
+                             outcome_and_count.second);
+    }
+    *output << Substitute(
+        "<tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td></tr>\n",
+        EscapeForHtmlToString(hot_key.table_name),
+        EscapeForHtmlToString(docdb::SubDocKey::DebugSliceToString(hot_key.key_prefix)),
+        hot_key.count,
+        outcomes);
+  }
+  *output << "</table>\n";
+
+  std::sort(conflicts.begin(), conflicts.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.entry.time_us > rhs.entry.time_us;
+  });
+  if (conflicts.size() > kMaxRecentConflicts) {
+    conflicts.resize(kMaxRecentConflicts);
+  }
+
+  const auto now_us = GetCurrentTimeMicros();
+  *output << "<h2>Recent Conflicts</h2>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Time ago</th><th>Table name</th><th>Tablet ID</th><th>Transaction</th>"
+             "<th>Conflicting transaction</th><th>Outcome</th><th>Key</th></tr>\n";
+  for (const auto& conflict : conflicts) {
+    const auto& info = conflict.entry.info;
+    *output << Substitute(
+        "<tr><td>$0 ms</td><td>$1</td><td>$2</td><td>$3</td><td>$4</td><td>$5</td><td>$6</td>"
+        "</tr>\n",
+        (now_us - conflict.entry.time_us) / 1000,
+        EscapeForHtmlToString(conflict.table_name),
+        TabletLink(conflict.tablet_id),
+        yb::ToString(info.transaction_id),
+        info.conflicting_id.is_nil() ? "" : yb::ToString(info.conflicting_id),
+        ToString(info.outcome),
+        EscapeForHtmlToString(docdb::SubDocKey::DebugSliceToString(info.key)));
+  }
+  *output << "</table>\n";
+}
+
 void TabletServerPathHandlers::HandleTablesPage(const Webserver::WebRequest& req,
                                                 std::stringstream *output) {
   vector<std::shared_ptr<TabletPeer>> peers;
@@ -550,6 +662,8 @@ void TabletServerPathHandlers::HandleDashboardsPage(const Webserver::WebRequest&
   *output << "  <tr><th>Dashboard</th><th>Description</th></tr>\n";
   *output << GetDashboardLine("transactions", "Transactions", "List of transactions that are "
                                                               "currently running.");
+  *output << GetDashboardLine("transaction-conflicts", "Transaction Conflicts",
+                              "Recent transaction conflicts and the hottest conflicting keys.");
   *output << GetDashboardLine("maintenance-manager", "Maintenance Manager",
                               "List of operations that are currently running and those "
                               "that are registered.");
@@ -70,6 +70,8 @@ class TabletServerPathHandlers {
                         std::stringstream* output);
   void HandleTransactionsPage(const Webserver::WebRequest& req,
                               std::stringstream* output);
+  void HandleTransactionConflictsPage(const Webserver::WebRequest& req,
+                                      std::stringstream* output);
   void HandleTabletSVGPage(const Webserver::WebRequest& req,
                            std::stringstream* output);
   void HandleLogAnchorsPage(const Webserver::WebRequest& req,
@@ -38,6 +38,7 @@
 #include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <unistd.h>
 
 #include <limits>
@@ -47,6 +48,7 @@
 #include <glog/logging.h>
 
 #include "yb/gutil/basictypes.h"
+#include "yb/gutil/casts.h"
 #include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/debug/trace_event.h"
@@ -188,7 +190,7 @@ bool Socket::IsTemporarySocketError(const Status& status) {
 #if defined(__linux__)
 
 Status Socket::Init(int flags) {
-  auto family = flags & FLAG_IPV6 ? AF_INET6 : AF_INET;
+  auto family = flags & FLAG_UNIX_DOMAIN ? AF_UNIX : flags & FLAG_IPV6 ? AF_INET6 : AF_INET;
   int nonblocking_flag = (flags & FLAG_NONBLOCKING) ? SOCK_NONBLOCK : 0;
   Reset(::socket(family, SOCK_STREAM | SOCK_CLOEXEC | nonblocking_flag, 0));
   if (fd_ < 0) {
@@ -203,7 +205,8 @@ Status Socket::Init(int flags) {
 #else
 
 Status Socket::Init(int flags) {
-  Reset(::socket(flags & FLAG_IPV6 ? AF_INET6 : AF_INET, SOCK_STREAM, 0));
+  auto family = flags & FLAG_UNIX_DOMAIN ? AF_UNIX : flags & FLAG_IPV6 ? AF_INET6 : AF_INET;
+  Reset(::socket(family, SOCK_STREAM, 0));
   if (fd_ < 0) {
     int err = errno;
     return STATUS(NetworkError, std::string("error opening socket: ") +
@@ -439,6 +442,56 @@ Status Socket::Connect(const Endpoint& remote) {
   return Status::OK();
 }
 
+namespace {
+
+Result<sockaddr_un> UnixDomainAddress(const std::string& path) {
+  sockaddr_un result;
+  memset(&result, 0, sizeof(result));
+  if (path.size() >= sizeof(result.sun_path)) {
+    return STATUS_FORMAT(InvalidArgument, "Unix domain socket path too long: $0", path);
+  }
+  result.sun_family = AF_UNIX;
+  memcpy(result.sun_path, path.c_str(), path.size());
+  return result;
+}
+
+} // namespace
+
+Status Socket::BindUnixDomain(const std::string& path) {
+  DCHECK_GE(fd_, 0);
+  auto address = VERIFY_RESULT(UnixDomainAddress(path));
+  if (::bind(fd_, pointer_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+    int err = errno;
+    return STATUS(NetworkError,
+                  Format("Error binding socket to $0: $1", path, ErrnoToString(err)),
+                  Slice(),
+                  err);
+  }
+  return Status::OK();
+}
+
+Status Socket::ConnectUnixDomain(const std::string& path) {
+  TRACE_EVENT1("net", "Socket::ConnectUnixDomain", "path", path);
+
+  DCHECK_GE(fd_, 0);
+  auto address = VERIFY_RESULT(UnixDomainAddress(path));
+  if (::connect(fd_, pointer_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+    int err = errno;
+    return STATUS(NetworkError, std::string("connect(2) error: ") +
+                                ErrnoToString(err), Slice(), err);
+  }
+  return Status::OK();
+}
+
+bool Socket::IsUnixDomain() const {
+  sockaddr_storage address;
+  socklen_t len = sizeof(address);
+  if (getsockname(fd_, pointer_cast<sockaddr*>(&address), &len) == -1) {
+    return false;
+  }
+  return address.ss_family == AF_UNIX;
+}
+
 Status Socket::GetSockError() const {
   int val = 0, ret;
   socklen_t val_len = sizeof(val);
@@ -680,6 +733,23 @@ Result<int32_t> Socket::GetReceiveBufferSize() {
   return val;
 }
 
+Result<int32_t> Socket::GetIncomingCpu() {
+#if defined(SO_INCOMING_CPU)
+  int32_t val = -1;
+  socklen_t val_len = sizeof(val);
+  DCHECK_GE(fd_, 0);
+  if (getsockopt(fd_, SOL_SOCKET, SO_INCOMING_CPU, &val, &val_len)) {
+    int err = errno;
+    return STATUS(
+        NetworkError, Format("Failed to get socket incoming cpu: $0", ErrnoToString(err)),
+        Slice(), err);
+  }
+  return val;
+#else
+  return STATUS(NotSupported, "SO_INCOMING_CPU is not supported on this platform");
+#endif
+}
+
 Status Socket::SetReceiveBufferSize(int32_t size) {
   int32_t val = size / 2; // Kernel will double this value
   DCHECK_GE(fd_, 0);
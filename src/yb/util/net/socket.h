@@ -60,6 +60,7 @@ class Socket {
  public:
   static const int FLAG_NONBLOCKING = 0x1;
   static const int FLAG_IPV6 = 0x02;
+  static const int FLAG_UNIX_DOMAIN = 0x04;
 
   // Create a new invalid Socket object.
   Socket();
@@ -138,6 +139,16 @@ class Socket {
   // start connecting this socket to a remote address.
   CHECKED_STATUS Connect(const Endpoint& remote);
 
+  // Bind Unix domain socket to the specified path. Socket should be initialized with
+  // FLAG_UNIX_DOMAIN.
+  CHECKED_STATUS BindUnixDomain(const std::string& path);
+
+  // Start connecting Unix domain socket to the specified path.
+  CHECKED_STATUS ConnectUnixDomain(const std::string& path);
+
+  // Returns true if this socket is a Unix domain socket.
+  bool IsUnixDomain() const;
+
   // get the error status using getsockopt(2)
   CHECKED_STATUS GetSockError() const;
 
@@ -169,6 +180,10 @@ class Socket {
   Result<int32_t> GetReceiveBufferSize();
   CHECKED_STATUS SetReceiveBufferSize(int32_t size);
 
+  // Implements the SOL_SOCKET/SO_INCOMING_CPU socket option, i.e. returns the CPU that processed
+  // the last packet received on this socket. Not supported on all platforms.
+  Result<int32_t> GetIncomingCpu();
+
  private:
   // Called internally from SetSend/RecvTimeout().
   CHECKED_STATUS SetTimeout(int opt, std::string optname, const MonoDelta& timeout);
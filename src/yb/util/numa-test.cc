@@ -0,0 +1,56 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/util/numa.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+
+class NumaTest : public YBTest {
+};
+
+TEST_F(NumaTest, ParseCpuList) {
+  ASSERT_EQ(std::vector<int>(), ASSERT_RESULT(ParseCpuList("\n")));
+  ASSERT_EQ(std::vector<int>({0}), ASSERT_RESULT(ParseCpuList("0\n")));
+  ASSERT_EQ(std::vector<int>({0, 1, 2, 3, 8, 10, 11}),
+            ASSERT_RESULT(ParseCpuList("0-3,8,10-11\n")));
+  ASSERT_NOK(ParseCpuList("3-1"));
+  ASSERT_NOK(ParseCpuList("1-2-3"));
+  ASSERT_NOK(ParseCpuList("a"));
+  ASSERT_NOK(ParseCpuList("1,,2"));
+}
+
+TEST_F(NumaTest, Topology) {
+  // Node 1 has memory only, so it is not reported and ids of other nodes are preserved.
+  NumaTopology topology({{0, {0, 1, 4, 5}}, {2, {2, 3, 6, 7}}});
+  ASSERT_EQ(2U, topology.num_nodes());
+  ASSERT_EQ(std::vector<int>({0, 2}), topology.nodes());
+  ASSERT_EQ(0, topology.NodeOfCpu(5));
+  ASSERT_EQ(2, topology.NodeOfCpu(2));
+  ASSERT_EQ(-1, topology.NodeOfCpu(8));
+  ASSERT_EQ(-1, topology.NodeOfCpu(-1));
+  ASSERT_EQ(nullptr, topology.cpus(1));
+  ASSERT_EQ(std::vector<int>({2, 3, 6, 7}), *topology.cpus(2));
+
+  const auto& machine = NumaTopology::Instance();
+  ASSERT_GE(machine.num_nodes(), 1U);
+  LOG(INFO) << "NUMA topology: " << machine.ToString();
+  auto current_node = machine.CurrentNode();
+  ASSERT_TRUE(current_node == -1 || machine.cpus(current_node) != nullptr) << current_node;
+  ASSERT_NOK(BindCurrentThreadToNumaNode(machine.nodes().back() + 1));
+}
+
+} // namespace yb
@@ -0,0 +1,171 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/numa.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <glog/logging.h>
+
+#include "yb/gutil/strings/numbers.h"
+#include "yb/gutil/strings/split.h"
+#include "yb/gutil/strings/strip.h"
+#include "yb/gutil/sysinfo.h"
+
+#include "yb/util/env.h"
+#include "yb/util/errno.h"
+#include "yb/util/faststring.h"
+#include "yb/util/format.h"
+#include "yb/util/tostring.h"
+
+namespace yb {
+
+namespace {
+
+const std::string kSysNodeDir = "/sys/devices/system/node";
+
+Result<std::vector<int>> ReadCpuList(const std::string& path) {
+  faststring data;
+  RETURN_NOT_OK(ReadFileToString(Env::Default(), path, &data));
+  return ParseCpuList(data.ToString());
+}
+
+std::map<int, std::vector<int>> LoadNodeCpus() {
+  std::map<int, std::vector<int>> result;
+#if defined(__linux__)
+  auto nodes = ReadCpuList(kSysNodeDir + "/online");
+  if (nodes.ok()) {
+    for (int node : *nodes) {
+      auto cpus = ReadCpuList(Format("$0/node$1/cpulist", kSysNodeDir, node));
+      if (!cpus.ok()) {
+        LOG(WARNING) << "Failed to read cpus of NUMA node " << node << ": " << cpus.status();
+        result.clear();
+        break;
+      }
+      if (!cpus->empty()) {
+        result.emplace(node, std::move(*cpus));
+      }
+    }
+  }
+#endif
+  if (result.empty()) {
+    auto& cpus = result[0];
+    for (int cpu = 0; cpu != base::RawNumCPUs(); ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+Result<std::vector<int>> ParseCpuList(const std::string& input) {
+  std::vector<int> result;
+  std::string trimmed = input;
+  StripWhiteSpace(&trimmed);
+  if (trimmed.empty()) {
+    return result;
+  }
+  std::vector<std::string> ranges = strings::Split(trimmed, ",");
+  for (const auto& range : ranges) {
+    std::vector<std::string> bounds = strings::Split(range, "-");
+    int first = 0, last = 0;
+    if (bounds.size() > 2 || !safe_strto32(bounds[0], &first) ||
+        !safe_strto32(bounds.back(), &last) || first < 0 || last < first) {
+      return STATUS_FORMAT(InvalidArgument, "Bad cpu list: $0", input);
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+const NumaTopology& NumaTopology::Instance() {
+  static NumaTopology instance(LoadNodeCpus());
+  return instance;
+}
+
+NumaTopology::NumaTopology(std::map<int, std::vector<int>> node_cpus)
+    : node_cpus_(std::move(node_cpus)) {
+  for (const auto& node_and_cpus : node_cpus_) {
+    nodes_.push_back(node_and_cpus.first);
+    for (int cpu : node_and_cpus.second) {
+      if (static_cast<size_t>(cpu) >= cpu_to_node_.size()) {
+        cpu_to_node_.resize(cpu + 1, -1);
+      }
+      cpu_to_node_[cpu] = node_and_cpus.first;
+    }
+  }
+}
+
+const std::vector<int>* NumaTopology::cpus(int node) const {
+  auto it = node_cpus_.find(node);
+  return it != node_cpus_.end() ? &it->second : nullptr;
+}
+
+int NumaTopology::NodeOfCpu(int cpu) const {
+  return cpu >= 0 && static_cast<size_t>(cpu) < cpu_to_node_.size() ? cpu_to_node_[cpu] : -1;
+}
+
+int NumaTopology::CurrentNode() const {
+#if defined(__linux__)
+  return NodeOfCpu(sched_getcpu());
+#else
+  return num_nodes() == 1 ? nodes_.front() : -1;
+#endif
+}
+
+int CachedCurrentNumaNode() {
+  // Threads rarely migrate between nodes, so the node is refreshed once per this number of calls.
+  constexpr int kRefreshInterval = 128;
+  static thread_local int node = -1;
+  static thread_local int calls_until_refresh = 0;
+  if (calls_until_refresh == 0) {
+    node = NumaTopology::Instance().CurrentNode();
+    calls_until_refresh = kRefreshInterval;
+  }
+  --calls_until_refresh;
+  return node;
+}
+
+std::string NumaTopology::ToString() const {
+  return yb::ToString(node_cpus_);
+}
+
+Status BindCurrentThreadToNumaNode(int node) {
+  const auto& topology = NumaTopology::Instance();
+  const auto* cpus = topology.cpus(node);
+  if (!cpus) {
+    return STATUS_FORMAT(InvalidArgument, "Unknown NUMA node $0, known nodes: $1",
+                         node, topology.nodes());
+  }
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : *cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (err != 0) {
+    return STATUS_FORMAT(RuntimeError, "Failed to bind thread to NUMA node $0: $1",
+                         node, ErrnoToString(err));
+  }
+#endif
+  return Status::OK();
+}
+
+} // namespace yb
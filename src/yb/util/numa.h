@@ -0,0 +1,73 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_NUMA_H
+#define YB_UTIL_NUMA_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "yb/util/result.h"
+
+namespace yb {
+
+// Parses cpu list in kernel format, i.e. "0-3,8,10-11".
+Result<std::vector<int>> ParseCpuList(const std::string& input);
+
+// NUMA topology of the machine, as reported by /sys/devices/system/node.
+// Nodes are identified by kernel node ids, nodes without CPUs are not reported.
+// When topology could not be determined, a single node 0 containing all CPUs is reported.
+class NumaTopology {
+ public:
+  static const NumaTopology& Instance();
+
+  // node_cpus maps node id to CPUs of this node.
+  explicit NumaTopology(std::map<int, std::vector<int>> node_cpus);
+
+  size_t num_nodes() const {
+    return nodes_.size();
+  }
+
+  // Ids of nodes with CPUs, in ascending order.
+  const std::vector<int>& nodes() const {
+    return nodes_;
+  }
+
+  // Returns CPUs of specified node, or nullptr if there is no such node.
+  const std::vector<int>* cpus(int node) const;
+
+  // Returns node that contains specified cpu, or -1 if cpu is unknown.
+  int NodeOfCpu(int cpu) const;
+
+  // Returns node of the CPU the current thread is running on, or -1 if it is unknown.
+  int CurrentNode() const;
+
+  std::string ToString() const;
+
+ private:
+  std::map<int, std::vector<int>> node_cpus_;
+  std::vector<int> nodes_;
+  std::vector<int> cpu_to_node_;
+};
+
+// Returns NUMA node of the current thread, like NumaTopology::Instance().CurrentNode(), but
+// queries the current CPU only once per several calls from the same thread.
+int CachedCurrentNumaNode();
+
+// Restricts the current thread to the CPUs of the specified NUMA node.
+CHECKED_STATUS BindCurrentThreadToNumaNode(int node);
+
+} // namespace yb
+
+#endif // YB_UTIL_NUMA_H
@@ -36,8 +36,10 @@
 #define YB_UTIL_PROTOBUF_UTIL_H
 
 #include <google/protobuf/message_lite.h>
+#include <google/protobuf/repeated_field.h>
 
 #include "yb/util/enums.h"
+#include "yb/util/faststring.h"
 
 namespace yb {
 
@@ -54,6 +56,16 @@ inline bool AppendPBToString(const google::protobuf::MessageLite &msg, faststrin
   return true;
 }
 
+// Moves heap allocated message to the end of repeated field. Swap with an element of a field that
+// belongs to an arena allocated message would deep copy the message, while a heap message added to
+// such field is just owned by the arena.
+template <class T>
+void MoveToRepeatedField(T* message, google::protobuf::RepeatedPtrField<T>* field) {
+  auto* moved = new T;
+  moved->Swap(message);
+  field->AddAllocated(moved);
+}
+
 } // namespace yb
 
 #define PB_ENUM_FORMATTERS(EnumType) \